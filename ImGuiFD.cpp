@@ -2,17 +2,137 @@
 #include "ImGuiFD_internal.h"
 
 #include <string.h>
+#include <stdio.h> // used for writing the name index file
 
 #include <stdint.h>
-#include <time.h> // used for localtime() and strftime()
+#include <time.h> // used for localtime(), strftime() and mktime()
 
 #ifndef __STDC_FORMAT_MACROS
 #define __STDC_FORMAT_MACROS 1
 #endif
 #include <inttypes.h> // used for u64 in format string
 
+// define IMGUIFD_DISABLE_SIMD to always use the scalar code paths
+#if !defined(IMGUIFD_DISABLE_SIMD)
+	#if defined(__AVX2__)
+		#define IMGUIFD_ENABLE_AVX2
+	#endif
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define IMGUIFD_ENABLE_SSE2
+	#endif
+#endif
+
+#if defined(IMGUIFD_ENABLE_AVX2)
+	#include <immintrin.h>
+#elif defined(IMGUIFD_ENABLE_SSE2)
+	#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && (defined(IMGUIFD_ENABLE_AVX2) || defined(IMGUIFD_ENABLE_SSE2))
+	#include <intrin.h> // _BitScanForward
+#endif
+
 namespace ImGuiFD {
 	namespace utils {
+		inline char toLowerAscii(char c) {
+			return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+		}
+		inline bool isDigitAscii(char c) {
+			return c >= '0' && c <= '9';
+		}
+
+#if defined(IMGUIFD_ENABLE_AVX2) || defined(IMGUIFD_ENABLE_SSE2)
+		inline unsigned countTrailingZeros(uint32_t v) {
+	#ifdef _MSC_VER
+			unsigned long ind;
+			_BitScanForward(&ind, v);
+			return (unsigned)ind;
+	#else
+			return (unsigned)__builtin_ctz(v);
+	#endif
+		}
+#endif
+
+		// finds the first occurrence of needle in hay (like memmem).
+		// Candidates are found by comparing the first and the last byte of needle to 16/32 positions at once,
+		// only those get compared completely. Searching case insensitive is done by lower casing both hay and needle up front,
+		// or, where hay can't be copied (file contents), with IgnoreCase: needle has to be lower case then and
+		// the candidates are found by setting bit 5 (the ASCII case bit) on both sides, which can only give too many of them.
+		template<bool IgnoreCase>
+		const char* findSubstringImpl(const char* hay, size_t hayLen, const char* needle, size_t needleLen) {
+			if (needleLen == 0)
+				return hay;
+			if (needleLen > hayLen)
+				return NULL;
+
+			const size_t numStarts = hayLen - needleLen + 1; // number of positions the needle could start at
+			const char caseBit = IgnoreCase ? 0x20 : 0;
+			size_t i = 0;
+
+			struct Local {
+				// the first and last byte already matched, but with IgnoreCase maybe only up to bit 5
+				static bool matches(const char* str, const char* lowerNeedle, size_t len) {
+					if (!IgnoreCase)
+						return len <= 2 || memcmp(str + 1, lowerNeedle + 1, len - 2) == 0;
+					for (size_t j = 0; j < len; j++) {
+						if (toLowerAscii(str[j]) != lowerNeedle[j])
+							return false;
+					}
+					return true;
+				}
+			};
+
+#if defined(IMGUIFD_ENABLE_AVX2)
+			{
+				const __m256i bit   = _mm256_set1_epi8(caseBit);
+				const __m256i first = _mm256_set1_epi8(needle[0] | caseBit);
+				const __m256i last  = _mm256_set1_epi8(needle[needleLen - 1] | caseBit);
+				for (; i + 32 <= numStarts; i += 32) {
+					const __m256i blockFirst = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(hay + i)), bit);
+					const __m256i blockLast  = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(hay + i + needleLen - 1)), bit);
+					uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast)));
+					while (mask != 0) {
+						const unsigned pos = countTrailingZeros(mask);
+						if (Local::matches(hay + i + pos, needle, needleLen))
+							return hay + i + pos;
+						mask &= mask - 1;
+					}
+				}
+			}
+#endif
+#if defined(IMGUIFD_ENABLE_SSE2)
+			{
+				const __m128i bit   = _mm_set1_epi8(caseBit);
+				const __m128i first = _mm_set1_epi8(needle[0] | caseBit);
+				const __m128i last  = _mm_set1_epi8(needle[needleLen - 1] | caseBit);
+				for (; i + 16 <= numStarts; i += 16) {
+					const __m128i blockFirst = _mm_or_si128(_mm_loadu_si128((const __m128i*)(hay + i)), bit);
+					const __m128i blockLast  = _mm_or_si128(_mm_loadu_si128((const __m128i*)(hay + i + needleLen - 1)), bit);
+					uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+					while (mask != 0) {
+						const unsigned pos = countTrailingZeros(mask);
+						if (Local::matches(hay + i + pos, needle, needleLen))
+							return hay + i + pos;
+						mask &= mask - 1;
+					}
+				}
+			}
+#endif
+
+			// scalar fallback (and the tail of the vectorized loops)
+			for (; i < numStarts; i++) {
+				if ((hay[i] | caseBit) == (needle[0] | caseBit) && (hay[i + needleLen - 1] | caseBit) == (needle[needleLen - 1] | caseBit) && Local::matches(hay + i, needle, needleLen))
+					return hay + i;
+			}
+			return NULL;
+		}
+		const char* findSubstring(const char* hay, size_t hayLen, const char* needle, size_t needleLen) {
+			return findSubstringImpl<false>(hay, hayLen, needle, needleLen);
+		}
+		// lowerNeedle has to be lower case, only ASCII letters are compared case insensitive
+		const char* findSubstringIgnoreCase(const char* hay, size_t hayLen, const char* lowerNeedle, size_t needleLen) {
+			return findSubstringImpl<true>(hay, hayLen, lowerNeedle, needleLen);
+		}
+
 		const char* findCharInStrFromBack(char c, const char* str, const char* strEnd = nullptr) {
 			if (strEnd == nullptr)
 				strEnd = str + strlen(str);
@@ -22,6 +142,11 @@ namespace ImGuiFD {
 			}
 			return nullptr;
 		}
+		// returns the part after the last '.' or NULL if there is no '.'
+		const char* getExtension(const char* name, const char* name_end = 0) {
+			const char* dotPos = findCharInStrFromBack('.', name, name_end);
+			return dotPos ? dotPos + 1 : NULL;
+		}
 		const char* getFileName(const char* path, const char* path_end = 0) {
 			if (path_end == 0)
 				path_end = path + strlen(path);
@@ -173,6 +298,41 @@ namespace ImGuiFD {
 			return out;
 		}
 
+		void formatTime(char* buf, size_t bufSize, time_t unixTime, const char* format) {
+			tm* tm = localtime(&unixTime);
+			if (!tm || strftime(buf, bufSize, format, tm) == 0)
+				buf[0] = 0;
+		}
+		void formatSize(char* buf, size_t bufSize, uint64_t size, bool humanReadable) {
+			static const char* const units[] = { "KiB", "MiB", "GiB", "TiB", "PiB", "EiB" };
+			if (!humanReadable || size < 1024) {
+				snprintf(buf, bufSize, "%" PRIu64 " Bytes", size);
+				return;
+			}
+			double value = (double)size / 1024;
+			size_t unit = 0;
+			while (value >= 1023.5 && unit + 1 < sizeof(units) / sizeof(units[0])) { // 1023.5 would be shown as "1024"
+				value /= 1024;
+				unit++;
+			}
+			snprintf(buf, bufSize, value < 100 ? "%.1f %s" : "%.0f %s", value, units[unit]);
+		}
+		// offset of the local time zone to UTC in minutes, right now
+		int getUtcOffset() {
+			const time_t now = time(NULL);
+			const tm* local = localtime(&now);
+			if (!local)
+				return 0;
+			const tm localTm = *local;
+			const tm* utc = gmtime(&now);
+			if (!utc)
+				return 0;
+			int offset = (localTm.tm_hour - utc->tm_hour) * 60 + localTm.tm_min - utc->tm_min;
+			if (localTm.tm_yday != utc->tm_yday) // a day ahead or behind, also over the turn of a year
+				offset += (localTm.tm_year > utc->tm_year || (localTm.tm_year == utc->tm_year && localTm.tm_yday > utc->tm_yday)) ? 24 * 60 : -24 * 60;
+			return offset;
+		}
+
 		int TextCallBack(ImGuiInputTextCallbackData* data) {
 			ds::string* str = (ds::string*)data->UserData;
 
@@ -190,8 +350,537 @@ namespace ImGuiFD {
 		}
 	}
 
-	ImGuiTableSortSpecs* globalSortSpecs = 0;
-	ds::vector<DirEntry>* globalSortData = 0;
+	// case folding and canonical composition (NFC) of UTF-8 names, so names compare and match the same regardless of their
+	// case and of how accents are encoded: "Straße" and "STRASSE", or 'é' and an 'e' followed by a combining accent (like on macOS).
+	// the tables are generated from Unicode 14.0, Hangul syllables are composed without them
+	namespace unicode {
+		// the code points first, first + stride, ... (count of them) fold to themselves + delta
+		struct FoldRange {
+			uint32_t first;
+			uint16_t count;
+			uint16_t stride;
+			int32_t delta;
+		};
+		// code points folding to multiple ones, e.g. 'ß' to "ss"
+		struct FoldMulti {
+			uint16_t cp;
+			const char* folded; // UTF-8
+		};
+		// pair is the first code point << 16 | the second one
+		struct Composition {
+			uint32_t pair;
+			uint16_t composed;
+		};
+		// canonical combining classes, every code point not in here has class 0
+		struct ClassRange {
+			uint32_t first;
+			uint32_t last;
+			uint8_t combiningClass;
+		};
+
+		static const FoldRange foldRanges[] = {
+			{ 0x00B5, 1, 1, 0x0307 }, { 0x00C0, 23, 1, 0x0020 }, { 0x00D8, 7, 1, 0x0020 }, { 0x0100, 24, 2, 0x0001 }, { 0x0132, 3, 2, 0x0001 },
+			{ 0x0139, 8, 2, 0x0001 }, { 0x014A, 23, 2, 0x0001 }, { 0x0178, 1, 1, -0x0079 }, { 0x0179, 3, 2, 0x0001 }, { 0x017F, 1, 1, -0x010C },
+			{ 0x0181, 1, 1, 0x00D2 }, { 0x0182, 2, 2, 0x0001 }, { 0x0186, 1, 1, 0x00CE }, { 0x0187, 1, 1, 0x0001 }, { 0x0189, 2, 1, 0x00CD },
+			{ 0x018B, 1, 1, 0x0001 }, { 0x018E, 1, 1, 0x004F }, { 0x018F, 1, 1, 0x00CA }, { 0x0190, 1, 1, 0x00CB }, { 0x0191, 1, 1, 0x0001 },
+			{ 0x0193, 1, 1, 0x00CD }, { 0x0194, 1, 1, 0x00CF }, { 0x0196, 1, 1, 0x00D3 }, { 0x0197, 1, 1, 0x00D1 }, { 0x0198, 1, 1, 0x0001 },
+			{ 0x019C, 1, 1, 0x00D3 }, { 0x019D, 1, 1, 0x00D5 }, { 0x019F, 1, 1, 0x00D6 }, { 0x01A0, 3, 2, 0x0001 }, { 0x01A6, 1, 1, 0x00DA },
+			{ 0x01A7, 1, 1, 0x0001 }, { 0x01A9, 1, 1, 0x00DA }, { 0x01AC, 1, 1, 0x0001 }, { 0x01AE, 1, 1, 0x00DA }, { 0x01AF, 1, 1, 0x0001 },
+			{ 0x01B1, 2, 1, 0x00D9 }, { 0x01B3, 2, 2, 0x0001 }, { 0x01B7, 1, 1, 0x00DB }, { 0x01B8, 1, 1, 0x0001 }, { 0x01BC, 1, 1, 0x0001 },
+			{ 0x01C4, 1, 1, 0x0002 }, { 0x01C5, 1, 1, 0x0001 }, { 0x01C7, 1, 1, 0x0002 }, { 0x01C8, 1, 1, 0x0001 }, { 0x01CA, 1, 1, 0x0002 },
+			{ 0x01CB, 9, 2, 0x0001 }, { 0x01DE, 9, 2, 0x0001 }, { 0x01F1, 1, 1, 0x0002 }, { 0x01F2, 2, 2, 0x0001 }, { 0x01F6, 1, 1, -0x0061 },
+			{ 0x01F7, 1, 1, -0x0038 }, { 0x01F8, 20, 2, 0x0001 }, { 0x0220, 1, 1, -0x0082 }, { 0x0222, 9, 2, 0x0001 }, { 0x023A, 1, 1, 0x2A2B },
+			{ 0x023B, 1, 1, 0x0001 }, { 0x023D, 1, 1, -0x00A3 }, { 0x023E, 1, 1, 0x2A28 }, { 0x0241, 1, 1, 0x0001 }, { 0x0243, 1, 1, -0x00C3 },
+			{ 0x0244, 1, 1, 0x0045 }, { 0x0245, 1, 1, 0x0047 }, { 0x0246, 5, 2, 0x0001 }, { 0x0345, 1, 1, 0x0074 }, { 0x0370, 2, 2, 0x0001 },
+			{ 0x0376, 1, 1, 0x0001 }, { 0x037F, 1, 1, 0x0074 }, { 0x0386, 1, 1, 0x0026 }, { 0x0388, 3, 1, 0x0025 }, { 0x038C, 1, 1, 0x0040 },
+			{ 0x038E, 2, 1, 0x003F }, { 0x0391, 17, 1, 0x0020 }, { 0x03A3, 9, 1, 0x0020 }, { 0x03C2, 1, 1, 0x0001 }, { 0x03CF, 1, 1, 0x0008 },
+			{ 0x03D0, 1, 1, -0x001E }, { 0x03D1, 1, 1, -0x0019 }, { 0x03D5, 1, 1, -0x000F }, { 0x03D6, 1, 1, -0x0016 }, { 0x03D8, 12, 2, 0x0001 },
+			{ 0x03F0, 1, 1, -0x0036 }, { 0x03F1, 1, 1, -0x0030 }, { 0x03F4, 1, 1, -0x003C }, { 0x03F5, 1, 1, -0x0040 }, { 0x03F7, 1, 1, 0x0001 },
+			{ 0x03F9, 1, 1, -0x0007 }, { 0x03FA, 1, 1, 0x0001 }, { 0x03FD, 3, 1, -0x0082 }, { 0x0400, 16, 1, 0x0050 }, { 0x0410, 32, 1, 0x0020 },
+			{ 0x0460, 17, 2, 0x0001 }, { 0x048A, 27, 2, 0x0001 }, { 0x04C0, 1, 1, 0x000F }, { 0x04C1, 7, 2, 0x0001 }, { 0x04D0, 48, 2, 0x0001 },
+			{ 0x0531, 38, 1, 0x0030 }, { 0x10A0, 38, 1, 0x1C60 }, { 0x10C7, 1, 1, 0x1C60 }, { 0x10CD, 1, 1, 0x1C60 }, { 0x13F8, 6, 1, -0x0008 },
+			{ 0x1C80, 1, 1, -0x184E }, { 0x1C81, 1, 1, -0x184D }, { 0x1C82, 1, 1, -0x1844 }, { 0x1C83, 2, 1, -0x1842 }, { 0x1C85, 1, 1, -0x1843 },
+			{ 0x1C86, 1, 1, -0x183C }, { 0x1C87, 1, 1, -0x1824 }, { 0x1C88, 1, 1, 0x89C3 }, { 0x1C90, 43, 1, -0x0BC0 }, { 0x1CBD, 3, 1, -0x0BC0 },
+			{ 0x1E00, 75, 2, 0x0001 }, { 0x1E9B, 1, 1, -0x003A }, { 0x1EA0, 48, 2, 0x0001 }, { 0x1F08, 8, 1, -0x0008 }, { 0x1F18, 6, 1, -0x0008 },
+			{ 0x1F28, 8, 1, -0x0008 }, { 0x1F38, 8, 1, -0x0008 }, { 0x1F48, 6, 1, -0x0008 }, { 0x1F59, 4, 2, -0x0008 }, { 0x1F68, 8, 1, -0x0008 },
+			{ 0x1FB8, 2, 1, -0x0008 }, { 0x1FBA, 2, 1, -0x004A }, { 0x1FBE, 1, 1, -0x1C05 }, { 0x1FC8, 4, 1, -0x0056 }, { 0x1FD8, 2, 1, -0x0008 },
+			{ 0x1FDA, 2, 1, -0x0064 }, { 0x1FE8, 2, 1, -0x0008 }, { 0x1FEA, 2, 1, -0x0070 }, { 0x1FEC, 1, 1, -0x0007 }, { 0x1FF8, 2, 1, -0x0080 },
+			{ 0x1FFA, 2, 1, -0x007E }, { 0x2126, 1, 1, -0x1D5D }, { 0x212A, 1, 1, -0x20BF }, { 0x212B, 1, 1, -0x2046 }, { 0x2132, 1, 1, 0x001C },
+			{ 0x2160, 16, 1, 0x0010 }, { 0x2183, 1, 1, 0x0001 }, { 0x24B6, 26, 1, 0x001A }, { 0x2C00, 48, 1, 0x0030 }, { 0x2C60, 1, 1, 0x0001 },
+			{ 0x2C62, 1, 1, -0x29F7 }, { 0x2C63, 1, 1, -0x0EE6 }, { 0x2C64, 1, 1, -0x29E7 }, { 0x2C67, 3, 2, 0x0001 }, { 0x2C6D, 1, 1, -0x2A1C },
+			{ 0x2C6E, 1, 1, -0x29FD }, { 0x2C6F, 1, 1, -0x2A1F }, { 0x2C70, 1, 1, -0x2A1E }, { 0x2C72, 1, 1, 0x0001 }, { 0x2C75, 1, 1, 0x0001 },
+			{ 0x2C7E, 2, 1, -0x2A3F }, { 0x2C80, 50, 2, 0x0001 }, { 0x2CEB, 2, 2, 0x0001 }, { 0x2CF2, 1, 1, 0x0001 }, { 0xA640, 23, 2, 0x0001 },
+			{ 0xA680, 14, 2, 0x0001 }, { 0xA722, 7, 2, 0x0001 }, { 0xA732, 31, 2, 0x0001 }, { 0xA779, 2, 2, 0x0001 }, { 0xA77D, 1, 1, -0x8A04 },
+			{ 0xA77E, 5, 2, 0x0001 }, { 0xA78B, 1, 1, 0x0001 }, { 0xA78D, 1, 1, -0xA528 }, { 0xA790, 2, 2, 0x0001 }, { 0xA796, 10, 2, 0x0001 },
+			{ 0xA7AA, 1, 1, -0xA544 }, { 0xA7AB, 1, 1, -0xA54F }, { 0xA7AC, 1, 1, -0xA54B }, { 0xA7AD, 1, 1, -0xA541 }, { 0xA7AE, 1, 1, -0xA544 },
+			{ 0xA7B0, 1, 1, -0xA512 }, { 0xA7B1, 1, 1, -0xA52A }, { 0xA7B2, 1, 1, -0xA515 }, { 0xA7B3, 1, 1, 0x03A0 }, { 0xA7B4, 8, 2, 0x0001 },
+			{ 0xA7C4, 1, 1, -0x0030 }, { 0xA7C5, 1, 1, -0xA543 }, { 0xA7C6, 1, 1, -0x8A38 }, { 0xA7C7, 2, 2, 0x0001 }, { 0xA7D0, 1, 1, 0x0001 },
+			{ 0xA7D6, 2, 2, 0x0001 }, { 0xA7F5, 1, 1, 0x0001 }, { 0xAB70, 80, 1, -0x97D0 }, { 0xFF21, 26, 1, 0x0020 }, { 0x10400, 40, 1, 0x0028 },
+			{ 0x104B0, 36, 1, 0x0028 }, { 0x10570, 11, 1, 0x0027 }, { 0x1057C, 15, 1, 0x0027 }, { 0x1058C, 7, 1, 0x0027 }, { 0x10594, 2, 1, 0x0027 },
+			{ 0x10C80, 51, 1, 0x0040 }, { 0x118A0, 32, 1, 0x0020 }, { 0x16E40, 32, 1, 0x0020 }, { 0x1E900, 34, 1, 0x0022 },
+		};
+		static const FoldMulti foldMultis[] = {
+			{ 0x00DF, "\x73\x73" }, { 0x0130, "\x69\xcc\x87" }, { 0x0149, "\xca\xbc\x6e" },
+			{ 0x01F0, "\x6a\xcc\x8c" }, { 0x0390, "\xce\xb9\xcc\x88\xcc\x81" }, { 0x03B0, "\xcf\x85\xcc\x88\xcc\x81" },
+			{ 0x0587, "\xd5\xa5\xd6\x82" }, { 0x1E96, "\x68\xcc\xb1" }, { 0x1E97, "\x74\xcc\x88" },
+			{ 0x1E98, "\x77\xcc\x8a" }, { 0x1E99, "\x79\xcc\x8a" }, { 0x1E9A, "\x61\xca\xbe" },
+			{ 0x1E9E, "\x73\x73" }, { 0x1F50, "\xcf\x85\xcc\x93" }, { 0x1F52, "\xcf\x85\xcc\x93\xcc\x80" },
+			{ 0x1F54, "\xcf\x85\xcc\x93\xcc\x81" }, { 0x1F56, "\xcf\x85\xcc\x93\xcd\x82" }, { 0x1F80, "\xe1\xbc\x80\xce\xb9" },
+			{ 0x1F81, "\xe1\xbc\x81\xce\xb9" }, { 0x1F82, "\xe1\xbc\x82\xce\xb9" }, { 0x1F83, "\xe1\xbc\x83\xce\xb9" },
+			{ 0x1F84, "\xe1\xbc\x84\xce\xb9" }, { 0x1F85, "\xe1\xbc\x85\xce\xb9" }, { 0x1F86, "\xe1\xbc\x86\xce\xb9" },
+			{ 0x1F87, "\xe1\xbc\x87\xce\xb9" }, { 0x1F88, "\xe1\xbc\x80\xce\xb9" }, { 0x1F89, "\xe1\xbc\x81\xce\xb9" },
+			{ 0x1F8A, "\xe1\xbc\x82\xce\xb9" }, { 0x1F8B, "\xe1\xbc\x83\xce\xb9" }, { 0x1F8C, "\xe1\xbc\x84\xce\xb9" },
+			{ 0x1F8D, "\xe1\xbc\x85\xce\xb9" }, { 0x1F8E, "\xe1\xbc\x86\xce\xb9" }, { 0x1F8F, "\xe1\xbc\x87\xce\xb9" },
+			{ 0x1F90, "\xe1\xbc\xa0\xce\xb9" }, { 0x1F91, "\xe1\xbc\xa1\xce\xb9" }, { 0x1F92, "\xe1\xbc\xa2\xce\xb9" },
+			{ 0x1F93, "\xe1\xbc\xa3\xce\xb9" }, { 0x1F94, "\xe1\xbc\xa4\xce\xb9" }, { 0x1F95, "\xe1\xbc\xa5\xce\xb9" },
+			{ 0x1F96, "\xe1\xbc\xa6\xce\xb9" }, { 0x1F97, "\xe1\xbc\xa7\xce\xb9" }, { 0x1F98, "\xe1\xbc\xa0\xce\xb9" },
+			{ 0x1F99, "\xe1\xbc\xa1\xce\xb9" }, { 0x1F9A, "\xe1\xbc\xa2\xce\xb9" }, { 0x1F9B, "\xe1\xbc\xa3\xce\xb9" },
+			{ 0x1F9C, "\xe1\xbc\xa4\xce\xb9" }, { 0x1F9D, "\xe1\xbc\xa5\xce\xb9" }, { 0x1F9E, "\xe1\xbc\xa6\xce\xb9" },
+			{ 0x1F9F, "\xe1\xbc\xa7\xce\xb9" }, { 0x1FA0, "\xe1\xbd\xa0\xce\xb9" }, { 0x1FA1, "\xe1\xbd\xa1\xce\xb9" },
+			{ 0x1FA2, "\xe1\xbd\xa2\xce\xb9" }, { 0x1FA3, "\xe1\xbd\xa3\xce\xb9" }, { 0x1FA4, "\xe1\xbd\xa4\xce\xb9" },
+			{ 0x1FA5, "\xe1\xbd\xa5\xce\xb9" }, { 0x1FA6, "\xe1\xbd\xa6\xce\xb9" }, { 0x1FA7, "\xe1\xbd\xa7\xce\xb9" },
+			{ 0x1FA8, "\xe1\xbd\xa0\xce\xb9" }, { 0x1FA9, "\xe1\xbd\xa1\xce\xb9" }, { 0x1FAA, "\xe1\xbd\xa2\xce\xb9" },
+			{ 0x1FAB, "\xe1\xbd\xa3\xce\xb9" }, { 0x1FAC, "\xe1\xbd\xa4\xce\xb9" }, { 0x1FAD, "\xe1\xbd\xa5\xce\xb9" },
+			{ 0x1FAE, "\xe1\xbd\xa6\xce\xb9" }, { 0x1FAF, "\xe1\xbd\xa7\xce\xb9" }, { 0x1FB2, "\xe1\xbd\xb0\xce\xb9" },
+			{ 0x1FB3, "\xce\xb1\xce\xb9" }, { 0x1FB4, "\xce\xac\xce\xb9" }, { 0x1FB6, "\xce\xb1\xcd\x82" },
+			{ 0x1FB7, "\xce\xb1\xcd\x82\xce\xb9" }, { 0x1FBC, "\xce\xb1\xce\xb9" }, { 0x1FC2, "\xe1\xbd\xb4\xce\xb9" },
+			{ 0x1FC3, "\xce\xb7\xce\xb9" }, { 0x1FC4, "\xce\xae\xce\xb9" }, { 0x1FC6, "\xce\xb7\xcd\x82" },
+			{ 0x1FC7, "\xce\xb7\xcd\x82\xce\xb9" }, { 0x1FCC, "\xce\xb7\xce\xb9" }, { 0x1FD2, "\xce\xb9\xcc\x88\xcc\x80" },
+			{ 0x1FD3, "\xce\xb9\xcc\x88\xcc\x81" }, { 0x1FD6, "\xce\xb9\xcd\x82" }, { 0x1FD7, "\xce\xb9\xcc\x88\xcd\x82" },
+			{ 0x1FE2, "\xcf\x85\xcc\x88\xcc\x80" }, { 0x1FE3, "\xcf\x85\xcc\x88\xcc\x81" }, { 0x1FE4, "\xcf\x81\xcc\x93" },
+			{ 0x1FE6, "\xcf\x85\xcd\x82" }, { 0x1FE7, "\xcf\x85\xcc\x88\xcd\x82" }, { 0x1FF2, "\xe1\xbd\xbc\xce\xb9" },
+			{ 0x1FF3, "\xcf\x89\xce\xb9" }, { 0x1FF4, "\xcf\x8e\xce\xb9" }, { 0x1FF6, "\xcf\x89\xcd\x82" },
+			{ 0x1FF7, "\xcf\x89\xcd\x82\xce\xb9" }, { 0x1FFC, "\xcf\x89\xce\xb9" }, { 0xFB00, "\x66\x66" },
+			{ 0xFB01, "\x66\x69" }, { 0xFB02, "\x66\x6c" }, { 0xFB03, "\x66\x66\x69" },
+			{ 0xFB04, "\x66\x66\x6c" }, { 0xFB05, "\x73\x74" }, { 0xFB06, "\x73\x74" },
+			{ 0xFB13, "\xd5\xb4\xd5\xb6" }, { 0xFB14, "\xd5\xb4\xd5\xa5" }, { 0xFB15, "\xd5\xb4\xd5\xab" },
+			{ 0xFB16, "\xd5\xbe\xd5\xb6" }, { 0xFB17, "\xd5\xb4\xd5\xad" },
+		};
+		static const Composition compositions[] = {
+			{ 0x003C0338, 0x226E }, { 0x003D0338, 0x2260 }, { 0x003E0338, 0x226F }, { 0x00410300, 0x00C0 }, { 0x00410301, 0x00C1 }, { 0x00410302, 0x00C2 },
+			{ 0x00410303, 0x00C3 }, { 0x00410304, 0x0100 }, { 0x00410306, 0x0102 }, { 0x00410307, 0x0226 }, { 0x00410308, 0x00C4 }, { 0x00410309, 0x1EA2 },
+			{ 0x0041030A, 0x00C5 }, { 0x0041030C, 0x01CD }, { 0x0041030F, 0x0200 }, { 0x00410311, 0x0202 }, { 0x00410323, 0x1EA0 }, { 0x00410325, 0x1E00 },
+			{ 0x00410328, 0x0104 }, { 0x00420307, 0x1E02 }, { 0x00420323, 0x1E04 }, { 0x00420331, 0x1E06 }, { 0x00430301, 0x0106 }, { 0x00430302, 0x0108 },
+			{ 0x00430307, 0x010A }, { 0x0043030C, 0x010C }, { 0x00430327, 0x00C7 }, { 0x00440307, 0x1E0A }, { 0x0044030C, 0x010E }, { 0x00440323, 0x1E0C },
+			{ 0x00440327, 0x1E10 }, { 0x0044032D, 0x1E12 }, { 0x00440331, 0x1E0E }, { 0x00450300, 0x00C8 }, { 0x00450301, 0x00C9 }, { 0x00450302, 0x00CA },
+			{ 0x00450303, 0x1EBC }, { 0x00450304, 0x0112 }, { 0x00450306, 0x0114 }, { 0x00450307, 0x0116 }, { 0x00450308, 0x00CB }, { 0x00450309, 0x1EBA },
+			{ 0x0045030C, 0x011A }, { 0x0045030F, 0x0204 }, { 0x00450311, 0x0206 }, { 0x00450323, 0x1EB8 }, { 0x00450327, 0x0228 }, { 0x00450328, 0x0118 },
+			{ 0x0045032D, 0x1E18 }, { 0x00450330, 0x1E1A }, { 0x00460307, 0x1E1E }, { 0x00470301, 0x01F4 }, { 0x00470302, 0x011C }, { 0x00470304, 0x1E20 },
+			{ 0x00470306, 0x011E }, { 0x00470307, 0x0120 }, { 0x0047030C, 0x01E6 }, { 0x00470327, 0x0122 }, { 0x00480302, 0x0124 }, { 0x00480307, 0x1E22 },
+			{ 0x00480308, 0x1E26 }, { 0x0048030C, 0x021E }, { 0x00480323, 0x1E24 }, { 0x00480327, 0x1E28 }, { 0x0048032E, 0x1E2A }, { 0x00490300, 0x00CC },
+			{ 0x00490301, 0x00CD }, { 0x00490302, 0x00CE }, { 0x00490303, 0x0128 }, { 0x00490304, 0x012A }, { 0x00490306, 0x012C }, { 0x00490307, 0x0130 },
+			{ 0x00490308, 0x00CF }, { 0x00490309, 0x1EC8 }, { 0x0049030C, 0x01CF }, { 0x0049030F, 0x0208 }, { 0x00490311, 0x020A }, { 0x00490323, 0x1ECA },
+			{ 0x00490328, 0x012E }, { 0x00490330, 0x1E2C }, { 0x004A0302, 0x0134 }, { 0x004B0301, 0x1E30 }, { 0x004B030C, 0x01E8 }, { 0x004B0323, 0x1E32 },
+			{ 0x004B0327, 0x0136 }, { 0x004B0331, 0x1E34 }, { 0x004C0301, 0x0139 }, { 0x004C030C, 0x013D }, { 0x004C0323, 0x1E36 }, { 0x004C0327, 0x013B },
+			{ 0x004C032D, 0x1E3C }, { 0x004C0331, 0x1E3A }, { 0x004D0301, 0x1E3E }, { 0x004D0307, 0x1E40 }, { 0x004D0323, 0x1E42 }, { 0x004E0300, 0x01F8 },
+			{ 0x004E0301, 0x0143 }, { 0x004E0303, 0x00D1 }, { 0x004E0307, 0x1E44 }, { 0x004E030C, 0x0147 }, { 0x004E0323, 0x1E46 }, { 0x004E0327, 0x0145 },
+			{ 0x004E032D, 0x1E4A }, { 0x004E0331, 0x1E48 }, { 0x004F0300, 0x00D2 }, { 0x004F0301, 0x00D3 }, { 0x004F0302, 0x00D4 }, { 0x004F0303, 0x00D5 },
+			{ 0x004F0304, 0x014C }, { 0x004F0306, 0x014E }, { 0x004F0307, 0x022E }, { 0x004F0308, 0x00D6 }, { 0x004F0309, 0x1ECE }, { 0x004F030B, 0x0150 },
+			{ 0x004F030C, 0x01D1 }, { 0x004F030F, 0x020C }, { 0x004F0311, 0x020E }, { 0x004F031B, 0x01A0 }, { 0x004F0323, 0x1ECC }, { 0x004F0328, 0x01EA },
+			{ 0x00500301, 0x1E54 }, { 0x00500307, 0x1E56 }, { 0x00520301, 0x0154 }, { 0x00520307, 0x1E58 }, { 0x0052030C, 0x0158 }, { 0x0052030F, 0x0210 },
+			{ 0x00520311, 0x0212 }, { 0x00520323, 0x1E5A }, { 0x00520327, 0x0156 }, { 0x00520331, 0x1E5E }, { 0x00530301, 0x015A }, { 0x00530302, 0x015C },
+			{ 0x00530307, 0x1E60 }, { 0x0053030C, 0x0160 }, { 0x00530323, 0x1E62 }, { 0x00530326, 0x0218 }, { 0x00530327, 0x015E }, { 0x00540307, 0x1E6A },
+			{ 0x0054030C, 0x0164 }, { 0x00540323, 0x1E6C }, { 0x00540326, 0x021A }, { 0x00540327, 0x0162 }, { 0x0054032D, 0x1E70 }, { 0x00540331, 0x1E6E },
+			{ 0x00550300, 0x00D9 }, { 0x00550301, 0x00DA }, { 0x00550302, 0x00DB }, { 0x00550303, 0x0168 }, { 0x00550304, 0x016A }, { 0x00550306, 0x016C },
+			{ 0x00550308, 0x00DC }, { 0x00550309, 0x1EE6 }, { 0x0055030A, 0x016E }, { 0x0055030B, 0x0170 }, { 0x0055030C, 0x01D3 }, { 0x0055030F, 0x0214 },
+			{ 0x00550311, 0x0216 }, { 0x0055031B, 0x01AF }, { 0x00550323, 0x1EE4 }, { 0x00550324, 0x1E72 }, { 0x00550328, 0x0172 }, { 0x0055032D, 0x1E76 },
+			{ 0x00550330, 0x1E74 }, { 0x00560303, 0x1E7C }, { 0x00560323, 0x1E7E }, { 0x00570300, 0x1E80 }, { 0x00570301, 0x1E82 }, { 0x00570302, 0x0174 },
+			{ 0x00570307, 0x1E86 }, { 0x00570308, 0x1E84 }, { 0x00570323, 0x1E88 }, { 0x00580307, 0x1E8A }, { 0x00580308, 0x1E8C }, { 0x00590300, 0x1EF2 },
+			{ 0x00590301, 0x00DD }, { 0x00590302, 0x0176 }, { 0x00590303, 0x1EF8 }, { 0x00590304, 0x0232 }, { 0x00590307, 0x1E8E }, { 0x00590308, 0x0178 },
+			{ 0x00590309, 0x1EF6 }, { 0x00590323, 0x1EF4 }, { 0x005A0301, 0x0179 }, { 0x005A0302, 0x1E90 }, { 0x005A0307, 0x017B }, { 0x005A030C, 0x017D },
+			{ 0x005A0323, 0x1E92 }, { 0x005A0331, 0x1E94 }, { 0x00610300, 0x00E0 }, { 0x00610301, 0x00E1 }, { 0x00610302, 0x00E2 }, { 0x00610303, 0x00E3 },
+			{ 0x00610304, 0x0101 }, { 0x00610306, 0x0103 }, { 0x00610307, 0x0227 }, { 0x00610308, 0x00E4 }, { 0x00610309, 0x1EA3 }, { 0x0061030A, 0x00E5 },
+			{ 0x0061030C, 0x01CE }, { 0x0061030F, 0x0201 }, { 0x00610311, 0x0203 }, { 0x00610323, 0x1EA1 }, { 0x00610325, 0x1E01 }, { 0x00610328, 0x0105 },
+			{ 0x00620307, 0x1E03 }, { 0x00620323, 0x1E05 }, { 0x00620331, 0x1E07 }, { 0x00630301, 0x0107 }, { 0x00630302, 0x0109 }, { 0x00630307, 0x010B },
+			{ 0x0063030C, 0x010D }, { 0x00630327, 0x00E7 }, { 0x00640307, 0x1E0B }, { 0x0064030C, 0x010F }, { 0x00640323, 0x1E0D }, { 0x00640327, 0x1E11 },
+			{ 0x0064032D, 0x1E13 }, { 0x00640331, 0x1E0F }, { 0x00650300, 0x00E8 }, { 0x00650301, 0x00E9 }, { 0x00650302, 0x00EA }, { 0x00650303, 0x1EBD },
+			{ 0x00650304, 0x0113 }, { 0x00650306, 0x0115 }, { 0x00650307, 0x0117 }, { 0x00650308, 0x00EB }, { 0x00650309, 0x1EBB }, { 0x0065030C, 0x011B },
+			{ 0x0065030F, 0x0205 }, { 0x00650311, 0x0207 }, { 0x00650323, 0x1EB9 }, { 0x00650327, 0x0229 }, { 0x00650328, 0x0119 }, { 0x0065032D, 0x1E19 },
+			{ 0x00650330, 0x1E1B }, { 0x00660307, 0x1E1F }, { 0x00670301, 0x01F5 }, { 0x00670302, 0x011D }, { 0x00670304, 0x1E21 }, { 0x00670306, 0x011F },
+			{ 0x00670307, 0x0121 }, { 0x0067030C, 0x01E7 }, { 0x00670327, 0x0123 }, { 0x00680302, 0x0125 }, { 0x00680307, 0x1E23 }, { 0x00680308, 0x1E27 },
+			{ 0x0068030C, 0x021F }, { 0x00680323, 0x1E25 }, { 0x00680327, 0x1E29 }, { 0x0068032E, 0x1E2B }, { 0x00680331, 0x1E96 }, { 0x00690300, 0x00EC },
+			{ 0x00690301, 0x00ED }, { 0x00690302, 0x00EE }, { 0x00690303, 0x0129 }, { 0x00690304, 0x012B }, { 0x00690306, 0x012D }, { 0x00690308, 0x00EF },
+			{ 0x00690309, 0x1EC9 }, { 0x0069030C, 0x01D0 }, { 0x0069030F, 0x0209 }, { 0x00690311, 0x020B }, { 0x00690323, 0x1ECB }, { 0x00690328, 0x012F },
+			{ 0x00690330, 0x1E2D }, { 0x006A0302, 0x0135 }, { 0x006A030C, 0x01F0 }, { 0x006B0301, 0x1E31 }, { 0x006B030C, 0x01E9 }, { 0x006B0323, 0x1E33 },
+			{ 0x006B0327, 0x0137 }, { 0x006B0331, 0x1E35 }, { 0x006C0301, 0x013A }, { 0x006C030C, 0x013E }, { 0x006C0323, 0x1E37 }, { 0x006C0327, 0x013C },
+			{ 0x006C032D, 0x1E3D }, { 0x006C0331, 0x1E3B }, { 0x006D0301, 0x1E3F }, { 0x006D0307, 0x1E41 }, { 0x006D0323, 0x1E43 }, { 0x006E0300, 0x01F9 },
+			{ 0x006E0301, 0x0144 }, { 0x006E0303, 0x00F1 }, { 0x006E0307, 0x1E45 }, { 0x006E030C, 0x0148 }, { 0x006E0323, 0x1E47 }, { 0x006E0327, 0x0146 },
+			{ 0x006E032D, 0x1E4B }, { 0x006E0331, 0x1E49 }, { 0x006F0300, 0x00F2 }, { 0x006F0301, 0x00F3 }, { 0x006F0302, 0x00F4 }, { 0x006F0303, 0x00F5 },
+			{ 0x006F0304, 0x014D }, { 0x006F0306, 0x014F }, { 0x006F0307, 0x022F }, { 0x006F0308, 0x00F6 }, { 0x006F0309, 0x1ECF }, { 0x006F030B, 0x0151 },
+			{ 0x006F030C, 0x01D2 }, { 0x006F030F, 0x020D }, { 0x006F0311, 0x020F }, { 0x006F031B, 0x01A1 }, { 0x006F0323, 0x1ECD }, { 0x006F0328, 0x01EB },
+			{ 0x00700301, 0x1E55 }, { 0x00700307, 0x1E57 }, { 0x00720301, 0x0155 }, { 0x00720307, 0x1E59 }, { 0x0072030C, 0x0159 }, { 0x0072030F, 0x0211 },
+			{ 0x00720311, 0x0213 }, { 0x00720323, 0x1E5B }, { 0x00720327, 0x0157 }, { 0x00720331, 0x1E5F }, { 0x00730301, 0x015B }, { 0x00730302, 0x015D },
+			{ 0x00730307, 0x1E61 }, { 0x0073030C, 0x0161 }, { 0x00730323, 0x1E63 }, { 0x00730326, 0x0219 }, { 0x00730327, 0x015F }, { 0x00740307, 0x1E6B },
+			{ 0x00740308, 0x1E97 }, { 0x0074030C, 0x0165 }, { 0x00740323, 0x1E6D }, { 0x00740326, 0x021B }, { 0x00740327, 0x0163 }, { 0x0074032D, 0x1E71 },
+			{ 0x00740331, 0x1E6F }, { 0x00750300, 0x00F9 }, { 0x00750301, 0x00FA }, { 0x00750302, 0x00FB }, { 0x00750303, 0x0169 }, { 0x00750304, 0x016B },
+			{ 0x00750306, 0x016D }, { 0x00750308, 0x00FC }, { 0x00750309, 0x1EE7 }, { 0x0075030A, 0x016F }, { 0x0075030B, 0x0171 }, { 0x0075030C, 0x01D4 },
+			{ 0x0075030F, 0x0215 }, { 0x00750311, 0x0217 }, { 0x0075031B, 0x01B0 }, { 0x00750323, 0x1EE5 }, { 0x00750324, 0x1E73 }, { 0x00750328, 0x0173 },
+			{ 0x0075032D, 0x1E77 }, { 0x00750330, 0x1E75 }, { 0x00760303, 0x1E7D }, { 0x00760323, 0x1E7F }, { 0x00770300, 0x1E81 }, { 0x00770301, 0x1E83 },
+			{ 0x00770302, 0x0175 }, { 0x00770307, 0x1E87 }, { 0x00770308, 0x1E85 }, { 0x0077030A, 0x1E98 }, { 0x00770323, 0x1E89 }, { 0x00780307, 0x1E8B },
+			{ 0x00780308, 0x1E8D }, { 0x00790300, 0x1EF3 }, { 0x00790301, 0x00FD }, { 0x00790302, 0x0177 }, { 0x00790303, 0x1EF9 }, { 0x00790304, 0x0233 },
+			{ 0x00790307, 0x1E8F }, { 0x00790308, 0x00FF }, { 0x00790309, 0x1EF7 }, { 0x0079030A, 0x1E99 }, { 0x00790323, 0x1EF5 }, { 0x007A0301, 0x017A },
+			{ 0x007A0302, 0x1E91 }, { 0x007A0307, 0x017C }, { 0x007A030C, 0x017E }, { 0x007A0323, 0x1E93 }, { 0x007A0331, 0x1E95 }, { 0x00A80300, 0x1FED },
+			{ 0x00A80301, 0x0385 }, { 0x00A80342, 0x1FC1 }, { 0x00C20300, 0x1EA6 }, { 0x00C20301, 0x1EA4 }, { 0x00C20303, 0x1EAA }, { 0x00C20309, 0x1EA8 },
+			{ 0x00C40304, 0x01DE }, { 0x00C50301, 0x01FA }, { 0x00C60301, 0x01FC }, { 0x00C60304, 0x01E2 }, { 0x00C70301, 0x1E08 }, { 0x00CA0300, 0x1EC0 },
+			{ 0x00CA0301, 0x1EBE }, { 0x00CA0303, 0x1EC4 }, { 0x00CA0309, 0x1EC2 }, { 0x00CF0301, 0x1E2E }, { 0x00D40300, 0x1ED2 }, { 0x00D40301, 0x1ED0 },
+			{ 0x00D40303, 0x1ED6 }, { 0x00D40309, 0x1ED4 }, { 0x00D50301, 0x1E4C }, { 0x00D50304, 0x022C }, { 0x00D50308, 0x1E4E }, { 0x00D60304, 0x022A },
+			{ 0x00D80301, 0x01FE }, { 0x00DC0300, 0x01DB }, { 0x00DC0301, 0x01D7 }, { 0x00DC0304, 0x01D5 }, { 0x00DC030C, 0x01D9 }, { 0x00E20300, 0x1EA7 },
+			{ 0x00E20301, 0x1EA5 }, { 0x00E20303, 0x1EAB }, { 0x00E20309, 0x1EA9 }, { 0x00E40304, 0x01DF }, { 0x00E50301, 0x01FB }, { 0x00E60301, 0x01FD },
+			{ 0x00E60304, 0x01E3 }, { 0x00E70301, 0x1E09 }, { 0x00EA0300, 0x1EC1 }, { 0x00EA0301, 0x1EBF }, { 0x00EA0303, 0x1EC5 }, { 0x00EA0309, 0x1EC3 },
+			{ 0x00EF0301, 0x1E2F }, { 0x00F40300, 0x1ED3 }, { 0x00F40301, 0x1ED1 }, { 0x00F40303, 0x1ED7 }, { 0x00F40309, 0x1ED5 }, { 0x00F50301, 0x1E4D },
+			{ 0x00F50304, 0x022D }, { 0x00F50308, 0x1E4F }, { 0x00F60304, 0x022B }, { 0x00F80301, 0x01FF }, { 0x00FC0300, 0x01DC }, { 0x00FC0301, 0x01D8 },
+			{ 0x00FC0304, 0x01D6 }, { 0x00FC030C, 0x01DA }, { 0x01020300, 0x1EB0 }, { 0x01020301, 0x1EAE }, { 0x01020303, 0x1EB4 }, { 0x01020309, 0x1EB2 },
+			{ 0x01030300, 0x1EB1 }, { 0x01030301, 0x1EAF }, { 0x01030303, 0x1EB5 }, { 0x01030309, 0x1EB3 }, { 0x01120300, 0x1E14 }, { 0x01120301, 0x1E16 },
+			{ 0x01130300, 0x1E15 }, { 0x01130301, 0x1E17 }, { 0x014C0300, 0x1E50 }, { 0x014C0301, 0x1E52 }, { 0x014D0300, 0x1E51 }, { 0x014D0301, 0x1E53 },
+			{ 0x015A0307, 0x1E64 }, { 0x015B0307, 0x1E65 }, { 0x01600307, 0x1E66 }, { 0x01610307, 0x1E67 }, { 0x01680301, 0x1E78 }, { 0x01690301, 0x1E79 },
+			{ 0x016A0308, 0x1E7A }, { 0x016B0308, 0x1E7B }, { 0x017F0307, 0x1E9B }, { 0x01A00300, 0x1EDC }, { 0x01A00301, 0x1EDA }, { 0x01A00303, 0x1EE0 },
+			{ 0x01A00309, 0x1EDE }, { 0x01A00323, 0x1EE2 }, { 0x01A10300, 0x1EDD }, { 0x01A10301, 0x1EDB }, { 0x01A10303, 0x1EE1 }, { 0x01A10309, 0x1EDF },
+			{ 0x01A10323, 0x1EE3 }, { 0x01AF0300, 0x1EEA }, { 0x01AF0301, 0x1EE8 }, { 0x01AF0303, 0x1EEE }, { 0x01AF0309, 0x1EEC }, { 0x01AF0323, 0x1EF0 },
+			{ 0x01B00300, 0x1EEB }, { 0x01B00301, 0x1EE9 }, { 0x01B00303, 0x1EEF }, { 0x01B00309, 0x1EED }, { 0x01B00323, 0x1EF1 }, { 0x01B7030C, 0x01EE },
+			{ 0x01EA0304, 0x01EC }, { 0x01EB0304, 0x01ED }, { 0x02260304, 0x01E0 }, { 0x02270304, 0x01E1 }, { 0x02280306, 0x1E1C }, { 0x02290306, 0x1E1D },
+			{ 0x022E0304, 0x0230 }, { 0x022F0304, 0x0231 }, { 0x0292030C, 0x01EF }, { 0x03910300, 0x1FBA }, { 0x03910301, 0x0386 }, { 0x03910304, 0x1FB9 },
+			{ 0x03910306, 0x1FB8 }, { 0x03910313, 0x1F08 }, { 0x03910314, 0x1F09 }, { 0x03910345, 0x1FBC }, { 0x03950300, 0x1FC8 }, { 0x03950301, 0x0388 },
+			{ 0x03950313, 0x1F18 }, { 0x03950314, 0x1F19 }, { 0x03970300, 0x1FCA }, { 0x03970301, 0x0389 }, { 0x03970313, 0x1F28 }, { 0x03970314, 0x1F29 },
+			{ 0x03970345, 0x1FCC }, { 0x03990300, 0x1FDA }, { 0x03990301, 0x038A }, { 0x03990304, 0x1FD9 }, { 0x03990306, 0x1FD8 }, { 0x03990308, 0x03AA },
+			{ 0x03990313, 0x1F38 }, { 0x03990314, 0x1F39 }, { 0x039F0300, 0x1FF8 }, { 0x039F0301, 0x038C }, { 0x039F0313, 0x1F48 }, { 0x039F0314, 0x1F49 },
+			{ 0x03A10314, 0x1FEC }, { 0x03A50300, 0x1FEA }, { 0x03A50301, 0x038E }, { 0x03A50304, 0x1FE9 }, { 0x03A50306, 0x1FE8 }, { 0x03A50308, 0x03AB },
+			{ 0x03A50314, 0x1F59 }, { 0x03A90300, 0x1FFA }, { 0x03A90301, 0x038F }, { 0x03A90313, 0x1F68 }, { 0x03A90314, 0x1F69 }, { 0x03A90345, 0x1FFC },
+			{ 0x03AC0345, 0x1FB4 }, { 0x03AE0345, 0x1FC4 }, { 0x03B10300, 0x1F70 }, { 0x03B10301, 0x03AC }, { 0x03B10304, 0x1FB1 }, { 0x03B10306, 0x1FB0 },
+			{ 0x03B10313, 0x1F00 }, { 0x03B10314, 0x1F01 }, { 0x03B10342, 0x1FB6 }, { 0x03B10345, 0x1FB3 }, { 0x03B50300, 0x1F72 }, { 0x03B50301, 0x03AD },
+			{ 0x03B50313, 0x1F10 }, { 0x03B50314, 0x1F11 }, { 0x03B70300, 0x1F74 }, { 0x03B70301, 0x03AE }, { 0x03B70313, 0x1F20 }, { 0x03B70314, 0x1F21 },
+			{ 0x03B70342, 0x1FC6 }, { 0x03B70345, 0x1FC3 }, { 0x03B90300, 0x1F76 }, { 0x03B90301, 0x03AF }, { 0x03B90304, 0x1FD1 }, { 0x03B90306, 0x1FD0 },
+			{ 0x03B90308, 0x03CA }, { 0x03B90313, 0x1F30 }, { 0x03B90314, 0x1F31 }, { 0x03B90342, 0x1FD6 }, { 0x03BF0300, 0x1F78 }, { 0x03BF0301, 0x03CC },
+			{ 0x03BF0313, 0x1F40 }, { 0x03BF0314, 0x1F41 }, { 0x03C10313, 0x1FE4 }, { 0x03C10314, 0x1FE5 }, { 0x03C50300, 0x1F7A }, { 0x03C50301, 0x03CD },
+			{ 0x03C50304, 0x1FE1 }, { 0x03C50306, 0x1FE0 }, { 0x03C50308, 0x03CB }, { 0x03C50313, 0x1F50 }, { 0x03C50314, 0x1F51 }, { 0x03C50342, 0x1FE6 },
+			{ 0x03C90300, 0x1F7C }, { 0x03C90301, 0x03CE }, { 0x03C90313, 0x1F60 }, { 0x03C90314, 0x1F61 }, { 0x03C90342, 0x1FF6 }, { 0x03C90345, 0x1FF3 },
+			{ 0x03CA0300, 0x1FD2 }, { 0x03CA0301, 0x0390 }, { 0x03CA0342, 0x1FD7 }, { 0x03CB0300, 0x1FE2 }, { 0x03CB0301, 0x03B0 }, { 0x03CB0342, 0x1FE7 },
+			{ 0x03CE0345, 0x1FF4 }, { 0x03D20301, 0x03D3 }, { 0x03D20308, 0x03D4 }, { 0x04060308, 0x0407 }, { 0x04100306, 0x04D0 }, { 0x04100308, 0x04D2 },
+			{ 0x04130301, 0x0403 }, { 0x04150300, 0x0400 }, { 0x04150306, 0x04D6 }, { 0x04150308, 0x0401 }, { 0x04160306, 0x04C1 }, { 0x04160308, 0x04DC },
+			{ 0x04170308, 0x04DE }, { 0x04180300, 0x040D }, { 0x04180304, 0x04E2 }, { 0x04180306, 0x0419 }, { 0x04180308, 0x04E4 }, { 0x041A0301, 0x040C },
+			{ 0x041E0308, 0x04E6 }, { 0x04230304, 0x04EE }, { 0x04230306, 0x040E }, { 0x04230308, 0x04F0 }, { 0x0423030B, 0x04F2 }, { 0x04270308, 0x04F4 },
+			{ 0x042B0308, 0x04F8 }, { 0x042D0308, 0x04EC }, { 0x04300306, 0x04D1 }, { 0x04300308, 0x04D3 }, { 0x04330301, 0x0453 }, { 0x04350300, 0x0450 },
+			{ 0x04350306, 0x04D7 }, { 0x04350308, 0x0451 }, { 0x04360306, 0x04C2 }, { 0x04360308, 0x04DD }, { 0x04370308, 0x04DF }, { 0x04380300, 0x045D },
+			{ 0x04380304, 0x04E3 }, { 0x04380306, 0x0439 }, { 0x04380308, 0x04E5 }, { 0x043A0301, 0x045C }, { 0x043E0308, 0x04E7 }, { 0x04430304, 0x04EF },
+			{ 0x04430306, 0x045E }, { 0x04430308, 0x04F1 }, { 0x0443030B, 0x04F3 }, { 0x04470308, 0x04F5 }, { 0x044B0308, 0x04F9 }, { 0x044D0308, 0x04ED },
+			{ 0x04560308, 0x0457 }, { 0x0474030F, 0x0476 }, { 0x0475030F, 0x0477 }, { 0x04D80308, 0x04DA }, { 0x04D90308, 0x04DB }, { 0x04E80308, 0x04EA },
+			{ 0x04E90308, 0x04EB }, { 0x06270653, 0x0622 }, { 0x06270654, 0x0623 }, { 0x06270655, 0x0625 }, { 0x06480654, 0x0624 }, { 0x064A0654, 0x0626 },
+			{ 0x06C10654, 0x06C2 }, { 0x06D20654, 0x06D3 }, { 0x06D50654, 0x06C0 }, { 0x0928093C, 0x0929 }, { 0x0930093C, 0x0931 }, { 0x0933093C, 0x0934 },
+			{ 0x09C709BE, 0x09CB }, { 0x09C709D7, 0x09CC }, { 0x0B470B3E, 0x0B4B }, { 0x0B470B56, 0x0B48 }, { 0x0B470B57, 0x0B4C }, { 0x0B920BD7, 0x0B94 },
+			{ 0x0BC60BBE, 0x0BCA }, { 0x0BC60BD7, 0x0BCC }, { 0x0BC70BBE, 0x0BCB }, { 0x0C460C56, 0x0C48 }, { 0x0CBF0CD5, 0x0CC0 }, { 0x0CC60CC2, 0x0CCA },
+			{ 0x0CC60CD5, 0x0CC7 }, { 0x0CC60CD6, 0x0CC8 }, { 0x0CCA0CD5, 0x0CCB }, { 0x0D460D3E, 0x0D4A }, { 0x0D460D57, 0x0D4C }, { 0x0D470D3E, 0x0D4B },
+			{ 0x0DD90DCA, 0x0DDA }, { 0x0DD90DCF, 0x0DDC }, { 0x0DD90DDF, 0x0DDE }, { 0x0DDC0DCA, 0x0DDD }, { 0x1025102E, 0x1026 }, { 0x1B051B35, 0x1B06 },
+			{ 0x1B071B35, 0x1B08 }, { 0x1B091B35, 0x1B0A }, { 0x1B0B1B35, 0x1B0C }, { 0x1B0D1B35, 0x1B0E }, { 0x1B111B35, 0x1B12 }, { 0x1B3A1B35, 0x1B3B },
+			{ 0x1B3C1B35, 0x1B3D }, { 0x1B3E1B35, 0x1B40 }, { 0x1B3F1B35, 0x1B41 }, { 0x1B421B35, 0x1B43 }, { 0x1E360304, 0x1E38 }, { 0x1E370304, 0x1E39 },
+			{ 0x1E5A0304, 0x1E5C }, { 0x1E5B0304, 0x1E5D }, { 0x1E620307, 0x1E68 }, { 0x1E630307, 0x1E69 }, { 0x1EA00302, 0x1EAC }, { 0x1EA00306, 0x1EB6 },
+			{ 0x1EA10302, 0x1EAD }, { 0x1EA10306, 0x1EB7 }, { 0x1EB80302, 0x1EC6 }, { 0x1EB90302, 0x1EC7 }, { 0x1ECC0302, 0x1ED8 }, { 0x1ECD0302, 0x1ED9 },
+			{ 0x1F000300, 0x1F02 }, { 0x1F000301, 0x1F04 }, { 0x1F000342, 0x1F06 }, { 0x1F000345, 0x1F80 }, { 0x1F010300, 0x1F03 }, { 0x1F010301, 0x1F05 },
+			{ 0x1F010342, 0x1F07 }, { 0x1F010345, 0x1F81 }, { 0x1F020345, 0x1F82 }, { 0x1F030345, 0x1F83 }, { 0x1F040345, 0x1F84 }, { 0x1F050345, 0x1F85 },
+			{ 0x1F060345, 0x1F86 }, { 0x1F070345, 0x1F87 }, { 0x1F080300, 0x1F0A }, { 0x1F080301, 0x1F0C }, { 0x1F080342, 0x1F0E }, { 0x1F080345, 0x1F88 },
+			{ 0x1F090300, 0x1F0B }, { 0x1F090301, 0x1F0D }, { 0x1F090342, 0x1F0F }, { 0x1F090345, 0x1F89 }, { 0x1F0A0345, 0x1F8A }, { 0x1F0B0345, 0x1F8B },
+			{ 0x1F0C0345, 0x1F8C }, { 0x1F0D0345, 0x1F8D }, { 0x1F0E0345, 0x1F8E }, { 0x1F0F0345, 0x1F8F }, { 0x1F100300, 0x1F12 }, { 0x1F100301, 0x1F14 },
+			{ 0x1F110300, 0x1F13 }, { 0x1F110301, 0x1F15 }, { 0x1F180300, 0x1F1A }, { 0x1F180301, 0x1F1C }, { 0x1F190300, 0x1F1B }, { 0x1F190301, 0x1F1D },
+			{ 0x1F200300, 0x1F22 }, { 0x1F200301, 0x1F24 }, { 0x1F200342, 0x1F26 }, { 0x1F200345, 0x1F90 }, { 0x1F210300, 0x1F23 }, { 0x1F210301, 0x1F25 },
+			{ 0x1F210342, 0x1F27 }, { 0x1F210345, 0x1F91 }, { 0x1F220345, 0x1F92 }, { 0x1F230345, 0x1F93 }, { 0x1F240345, 0x1F94 }, { 0x1F250345, 0x1F95 },
+			{ 0x1F260345, 0x1F96 }, { 0x1F270345, 0x1F97 }, { 0x1F280300, 0x1F2A }, { 0x1F280301, 0x1F2C }, { 0x1F280342, 0x1F2E }, { 0x1F280345, 0x1F98 },
+			{ 0x1F290300, 0x1F2B }, { 0x1F290301, 0x1F2D }, { 0x1F290342, 0x1F2F }, { 0x1F290345, 0x1F99 }, { 0x1F2A0345, 0x1F9A }, { 0x1F2B0345, 0x1F9B },
+			{ 0x1F2C0345, 0x1F9C }, { 0x1F2D0345, 0x1F9D }, { 0x1F2E0345, 0x1F9E }, { 0x1F2F0345, 0x1F9F }, { 0x1F300300, 0x1F32 }, { 0x1F300301, 0x1F34 },
+			{ 0x1F300342, 0x1F36 }, { 0x1F310300, 0x1F33 }, { 0x1F310301, 0x1F35 }, { 0x1F310342, 0x1F37 }, { 0x1F380300, 0x1F3A }, { 0x1F380301, 0x1F3C },
+			{ 0x1F380342, 0x1F3E }, { 0x1F390300, 0x1F3B }, { 0x1F390301, 0x1F3D }, { 0x1F390342, 0x1F3F }, { 0x1F400300, 0x1F42 }, { 0x1F400301, 0x1F44 },
+			{ 0x1F410300, 0x1F43 }, { 0x1F410301, 0x1F45 }, { 0x1F480300, 0x1F4A }, { 0x1F480301, 0x1F4C }, { 0x1F490300, 0x1F4B }, { 0x1F490301, 0x1F4D },
+			{ 0x1F500300, 0x1F52 }, { 0x1F500301, 0x1F54 }, { 0x1F500342, 0x1F56 }, { 0x1F510300, 0x1F53 }, { 0x1F510301, 0x1F55 }, { 0x1F510342, 0x1F57 },
+			{ 0x1F590300, 0x1F5B }, { 0x1F590301, 0x1F5D }, { 0x1F590342, 0x1F5F }, { 0x1F600300, 0x1F62 }, { 0x1F600301, 0x1F64 }, { 0x1F600342, 0x1F66 },
+			{ 0x1F600345, 0x1FA0 }, { 0x1F610300, 0x1F63 }, { 0x1F610301, 0x1F65 }, { 0x1F610342, 0x1F67 }, { 0x1F610345, 0x1FA1 }, { 0x1F620345, 0x1FA2 },
+			{ 0x1F630345, 0x1FA3 }, { 0x1F640345, 0x1FA4 }, { 0x1F650345, 0x1FA5 }, { 0x1F660345, 0x1FA6 }, { 0x1F670345, 0x1FA7 }, { 0x1F680300, 0x1F6A },
+			{ 0x1F680301, 0x1F6C }, { 0x1F680342, 0x1F6E }, { 0x1F680345, 0x1FA8 }, { 0x1F690300, 0x1F6B }, { 0x1F690301, 0x1F6D }, { 0x1F690342, 0x1F6F },
+			{ 0x1F690345, 0x1FA9 }, { 0x1F6A0345, 0x1FAA }, { 0x1F6B0345, 0x1FAB }, { 0x1F6C0345, 0x1FAC }, { 0x1F6D0345, 0x1FAD }, { 0x1F6E0345, 0x1FAE },
+			{ 0x1F6F0345, 0x1FAF }, { 0x1F700345, 0x1FB2 }, { 0x1F740345, 0x1FC2 }, { 0x1F7C0345, 0x1FF2 }, { 0x1FB60345, 0x1FB7 }, { 0x1FBF0300, 0x1FCD },
+			{ 0x1FBF0301, 0x1FCE }, { 0x1FBF0342, 0x1FCF }, { 0x1FC60345, 0x1FC7 }, { 0x1FF60345, 0x1FF7 }, { 0x1FFE0300, 0x1FDD }, { 0x1FFE0301, 0x1FDE },
+			{ 0x1FFE0342, 0x1FDF }, { 0x21900338, 0x219A }, { 0x21920338, 0x219B }, { 0x21940338, 0x21AE }, { 0x21D00338, 0x21CD }, { 0x21D20338, 0x21CF },
+			{ 0x21D40338, 0x21CE }, { 0x22030338, 0x2204 }, { 0x22080338, 0x2209 }, { 0x220B0338, 0x220C }, { 0x22230338, 0x2224 }, { 0x22250338, 0x2226 },
+			{ 0x223C0338, 0x2241 }, { 0x22430338, 0x2244 }, { 0x22450338, 0x2247 }, { 0x22480338, 0x2249 }, { 0x224D0338, 0x226D }, { 0x22610338, 0x2262 },
+			{ 0x22640338, 0x2270 }, { 0x22650338, 0x2271 }, { 0x22720338, 0x2274 }, { 0x22730338, 0x2275 }, { 0x22760338, 0x2278 }, { 0x22770338, 0x2279 },
+			{ 0x227A0338, 0x2280 }, { 0x227B0338, 0x2281 }, { 0x227C0338, 0x22E0 }, { 0x227D0338, 0x22E1 }, { 0x22820338, 0x2284 }, { 0x22830338, 0x2285 },
+			{ 0x22860338, 0x2288 }, { 0x22870338, 0x2289 }, { 0x22910338, 0x22E2 }, { 0x22920338, 0x22E3 }, { 0x22A20338, 0x22AC }, { 0x22A80338, 0x22AD },
+			{ 0x22A90338, 0x22AE }, { 0x22AB0338, 0x22AF }, { 0x22B20338, 0x22EA }, { 0x22B30338, 0x22EB }, { 0x22B40338, 0x22EC }, { 0x22B50338, 0x22ED },
+			{ 0x30463099, 0x3094 }, { 0x304B3099, 0x304C }, { 0x304D3099, 0x304E }, { 0x304F3099, 0x3050 }, { 0x30513099, 0x3052 }, { 0x30533099, 0x3054 },
+			{ 0x30553099, 0x3056 }, { 0x30573099, 0x3058 }, { 0x30593099, 0x305A }, { 0x305B3099, 0x305C }, { 0x305D3099, 0x305E }, { 0x305F3099, 0x3060 },
+			{ 0x30613099, 0x3062 }, { 0x30643099, 0x3065 }, { 0x30663099, 0x3067 }, { 0x30683099, 0x3069 }, { 0x306F3099, 0x3070 }, { 0x306F309A, 0x3071 },
+			{ 0x30723099, 0x3073 }, { 0x3072309A, 0x3074 }, { 0x30753099, 0x3076 }, { 0x3075309A, 0x3077 }, { 0x30783099, 0x3079 }, { 0x3078309A, 0x307A },
+			{ 0x307B3099, 0x307C }, { 0x307B309A, 0x307D }, { 0x309D3099, 0x309E }, { 0x30A63099, 0x30F4 }, { 0x30AB3099, 0x30AC }, { 0x30AD3099, 0x30AE },
+			{ 0x30AF3099, 0x30B0 }, { 0x30B13099, 0x30B2 }, { 0x30B33099, 0x30B4 }, { 0x30B53099, 0x30B6 }, { 0x30B73099, 0x30B8 }, { 0x30B93099, 0x30BA },
+			{ 0x30BB3099, 0x30BC }, { 0x30BD3099, 0x30BE }, { 0x30BF3099, 0x30C0 }, { 0x30C13099, 0x30C2 }, { 0x30C43099, 0x30C5 }, { 0x30C63099, 0x30C7 },
+			{ 0x30C83099, 0x30C9 }, { 0x30CF3099, 0x30D0 }, { 0x30CF309A, 0x30D1 }, { 0x30D23099, 0x30D3 }, { 0x30D2309A, 0x30D4 }, { 0x30D53099, 0x30D6 },
+			{ 0x30D5309A, 0x30D7 }, { 0x30D83099, 0x30D9 }, { 0x30D8309A, 0x30DA }, { 0x30DB3099, 0x30DC }, { 0x30DB309A, 0x30DD }, { 0x30EF3099, 0x30F7 },
+			{ 0x30F03099, 0x30F8 }, { 0x30F13099, 0x30F9 }, { 0x30F23099, 0x30FA }, { 0x30FD3099, 0x30FE },
+		};
+		static const ClassRange classRanges[] = {
+			{ 0x0300, 0x0314, 230 }, { 0x0315, 0x0315, 232 }, { 0x0316, 0x0319, 220 }, { 0x031A, 0x031A, 232 }, { 0x031B, 0x031B, 216 }, { 0x031C, 0x0320, 220 },
+			{ 0x0321, 0x0322, 202 }, { 0x0323, 0x0326, 220 }, { 0x0327, 0x0328, 202 }, { 0x0329, 0x0333, 220 }, { 0x0334, 0x0338, 1 }, { 0x0339, 0x033C, 220 },
+			{ 0x033D, 0x0344, 230 }, { 0x0345, 0x0345, 240 }, { 0x0346, 0x0346, 230 }, { 0x0347, 0x0349, 220 }, { 0x034A, 0x034C, 230 }, { 0x034D, 0x034E, 220 },
+			{ 0x0350, 0x0352, 230 }, { 0x0353, 0x0356, 220 }, { 0x0357, 0x0357, 230 }, { 0x0358, 0x0358, 232 }, { 0x0359, 0x035A, 220 }, { 0x035B, 0x035B, 230 },
+			{ 0x035C, 0x035C, 233 }, { 0x035D, 0x035E, 234 }, { 0x035F, 0x035F, 233 }, { 0x0360, 0x0361, 234 }, { 0x0362, 0x0362, 233 }, { 0x0363, 0x036F, 230 },
+			{ 0x0483, 0x0487, 230 }, { 0x0591, 0x0591, 220 }, { 0x0592, 0x0595, 230 }, { 0x0596, 0x0596, 220 }, { 0x0597, 0x0599, 230 }, { 0x059A, 0x059A, 222 },
+			{ 0x059B, 0x059B, 220 }, { 0x059C, 0x05A1, 230 }, { 0x05A2, 0x05A7, 220 }, { 0x05A8, 0x05A9, 230 }, { 0x05AA, 0x05AA, 220 }, { 0x05AB, 0x05AC, 230 },
+			{ 0x05AD, 0x05AD, 222 }, { 0x05AE, 0x05AE, 228 }, { 0x05AF, 0x05AF, 230 }, { 0x05B0, 0x05B0, 10 }, { 0x05B1, 0x05B1, 11 }, { 0x05B2, 0x05B2, 12 },
+			{ 0x05B3, 0x05B3, 13 }, { 0x05B4, 0x05B4, 14 }, { 0x05B5, 0x05B5, 15 }, { 0x05B6, 0x05B6, 16 }, { 0x05B7, 0x05B7, 17 }, { 0x05B8, 0x05B8, 18 },
+			{ 0x05B9, 0x05BA, 19 }, { 0x05BB, 0x05BB, 20 }, { 0x05BC, 0x05BC, 21 }, { 0x05BD, 0x05BD, 22 }, { 0x05BF, 0x05BF, 23 }, { 0x05C1, 0x05C1, 24 },
+			{ 0x05C2, 0x05C2, 25 }, { 0x05C4, 0x05C4, 230 }, { 0x05C5, 0x05C5, 220 }, { 0x05C7, 0x05C7, 18 }, { 0x0610, 0x0617, 230 }, { 0x0618, 0x0618, 30 },
+			{ 0x0619, 0x0619, 31 }, { 0x061A, 0x061A, 32 }, { 0x064B, 0x064B, 27 }, { 0x064C, 0x064C, 28 }, { 0x064D, 0x064D, 29 }, { 0x064E, 0x064E, 30 },
+			{ 0x064F, 0x064F, 31 }, { 0x0650, 0x0650, 32 }, { 0x0651, 0x0651, 33 }, { 0x0652, 0x0652, 34 }, { 0x0653, 0x0654, 230 }, { 0x0655, 0x0656, 220 },
+			{ 0x0657, 0x065B, 230 }, { 0x065C, 0x065C, 220 }, { 0x065D, 0x065E, 230 }, { 0x065F, 0x065F, 220 }, { 0x0670, 0x0670, 35 }, { 0x06D6, 0x06DC, 230 },
+			{ 0x06DF, 0x06E2, 230 }, { 0x06E3, 0x06E3, 220 }, { 0x06E4, 0x06E4, 230 }, { 0x06E7, 0x06E8, 230 }, { 0x06EA, 0x06EA, 220 }, { 0x06EB, 0x06EC, 230 },
+			{ 0x06ED, 0x06ED, 220 }, { 0x0711, 0x0711, 36 }, { 0x0730, 0x0730, 230 }, { 0x0731, 0x0731, 220 }, { 0x0732, 0x0733, 230 }, { 0x0734, 0x0734, 220 },
+			{ 0x0735, 0x0736, 230 }, { 0x0737, 0x0739, 220 }, { 0x073A, 0x073A, 230 }, { 0x073B, 0x073C, 220 }, { 0x073D, 0x073D, 230 }, { 0x073E, 0x073E, 220 },
+			{ 0x073F, 0x0741, 230 }, { 0x0742, 0x0742, 220 }, { 0x0743, 0x0743, 230 }, { 0x0744, 0x0744, 220 }, { 0x0745, 0x0745, 230 }, { 0x0746, 0x0746, 220 },
+			{ 0x0747, 0x0747, 230 }, { 0x0748, 0x0748, 220 }, { 0x0749, 0x074A, 230 }, { 0x07EB, 0x07F1, 230 }, { 0x07F2, 0x07F2, 220 }, { 0x07F3, 0x07F3, 230 },
+			{ 0x07FD, 0x07FD, 220 }, { 0x0816, 0x0819, 230 }, { 0x081B, 0x0823, 230 }, { 0x0825, 0x0827, 230 }, { 0x0829, 0x082D, 230 }, { 0x0859, 0x085B, 220 },
+			{ 0x0898, 0x0898, 230 }, { 0x0899, 0x089B, 220 }, { 0x089C, 0x089F, 230 }, { 0x08CA, 0x08CE, 230 }, { 0x08CF, 0x08D3, 220 }, { 0x08D4, 0x08E1, 230 },
+			{ 0x08E3, 0x08E3, 220 }, { 0x08E4, 0x08E5, 230 }, { 0x08E6, 0x08E6, 220 }, { 0x08E7, 0x08E8, 230 }, { 0x08E9, 0x08E9, 220 }, { 0x08EA, 0x08EC, 230 },
+			{ 0x08ED, 0x08EF, 220 }, { 0x08F0, 0x08F0, 27 }, { 0x08F1, 0x08F1, 28 }, { 0x08F2, 0x08F2, 29 }, { 0x08F3, 0x08F5, 230 }, { 0x08F6, 0x08F6, 220 },
+			{ 0x08F7, 0x08F8, 230 }, { 0x08F9, 0x08FA, 220 }, { 0x08FB, 0x08FF, 230 }, { 0x093C, 0x093C, 7 }, { 0x094D, 0x094D, 9 }, { 0x0951, 0x0951, 230 },
+			{ 0x0952, 0x0952, 220 }, { 0x0953, 0x0954, 230 }, { 0x09BC, 0x09BC, 7 }, { 0x09CD, 0x09CD, 9 }, { 0x09FE, 0x09FE, 230 }, { 0x0A3C, 0x0A3C, 7 },
+			{ 0x0A4D, 0x0A4D, 9 }, { 0x0ABC, 0x0ABC, 7 }, { 0x0ACD, 0x0ACD, 9 }, { 0x0B3C, 0x0B3C, 7 }, { 0x0B4D, 0x0B4D, 9 }, { 0x0BCD, 0x0BCD, 9 },
+			{ 0x0C3C, 0x0C3C, 7 }, { 0x0C4D, 0x0C4D, 9 }, { 0x0C55, 0x0C55, 84 }, { 0x0C56, 0x0C56, 91 }, { 0x0CBC, 0x0CBC, 7 }, { 0x0CCD, 0x0CCD, 9 },
+			{ 0x0D3B, 0x0D3C, 9 }, { 0x0D4D, 0x0D4D, 9 }, { 0x0DCA, 0x0DCA, 9 }, { 0x0E38, 0x0E39, 103 }, { 0x0E3A, 0x0E3A, 9 }, { 0x0E48, 0x0E4B, 107 },
+			{ 0x0EB8, 0x0EB9, 118 }, { 0x0EBA, 0x0EBA, 9 }, { 0x0EC8, 0x0ECB, 122 }, { 0x0F18, 0x0F19, 220 }, { 0x0F35, 0x0F35, 220 }, { 0x0F37, 0x0F37, 220 },
+			{ 0x0F39, 0x0F39, 216 }, { 0x0F71, 0x0F71, 129 }, { 0x0F72, 0x0F72, 130 }, { 0x0F74, 0x0F74, 132 }, { 0x0F7A, 0x0F7D, 130 }, { 0x0F80, 0x0F80, 130 },
+			{ 0x0F82, 0x0F83, 230 }, { 0x0F84, 0x0F84, 9 }, { 0x0F86, 0x0F87, 230 }, { 0x0FC6, 0x0FC6, 220 }, { 0x1037, 0x1037, 7 }, { 0x1039, 0x103A, 9 },
+			{ 0x108D, 0x108D, 220 }, { 0x135D, 0x135F, 230 }, { 0x1714, 0x1715, 9 }, { 0x1734, 0x1734, 9 }, { 0x17D2, 0x17D2, 9 }, { 0x17DD, 0x17DD, 230 },
+			{ 0x18A9, 0x18A9, 228 }, { 0x1939, 0x1939, 222 }, { 0x193A, 0x193A, 230 }, { 0x193B, 0x193B, 220 }, { 0x1A17, 0x1A17, 230 }, { 0x1A18, 0x1A18, 220 },
+			{ 0x1A60, 0x1A60, 9 }, { 0x1A75, 0x1A7C, 230 }, { 0x1A7F, 0x1A7F, 220 }, { 0x1AB0, 0x1AB4, 230 }, { 0x1AB5, 0x1ABA, 220 }, { 0x1ABB, 0x1ABC, 230 },
+			{ 0x1ABD, 0x1ABD, 220 }, { 0x1ABF, 0x1AC0, 220 }, { 0x1AC1, 0x1AC2, 230 }, { 0x1AC3, 0x1AC4, 220 }, { 0x1AC5, 0x1AC9, 230 }, { 0x1ACA, 0x1ACA, 220 },
+			{ 0x1ACB, 0x1ACE, 230 }, { 0x1B34, 0x1B34, 7 }, { 0x1B44, 0x1B44, 9 }, { 0x1B6B, 0x1B6B, 230 }, { 0x1B6C, 0x1B6C, 220 }, { 0x1B6D, 0x1B73, 230 },
+			{ 0x1BAA, 0x1BAB, 9 }, { 0x1BE6, 0x1BE6, 7 }, { 0x1BF2, 0x1BF3, 9 }, { 0x1C37, 0x1C37, 7 }, { 0x1CD0, 0x1CD2, 230 }, { 0x1CD4, 0x1CD4, 1 },
+			{ 0x1CD5, 0x1CD9, 220 }, { 0x1CDA, 0x1CDB, 230 }, { 0x1CDC, 0x1CDF, 220 }, { 0x1CE0, 0x1CE0, 230 }, { 0x1CE2, 0x1CE8, 1 }, { 0x1CED, 0x1CED, 220 },
+			{ 0x1CF4, 0x1CF4, 230 }, { 0x1CF8, 0x1CF9, 230 }, { 0x1DC0, 0x1DC1, 230 }, { 0x1DC2, 0x1DC2, 220 }, { 0x1DC3, 0x1DC9, 230 }, { 0x1DCA, 0x1DCA, 220 },
+			{ 0x1DCB, 0x1DCC, 230 }, { 0x1DCD, 0x1DCD, 234 }, { 0x1DCE, 0x1DCE, 214 }, { 0x1DCF, 0x1DCF, 220 }, { 0x1DD0, 0x1DD0, 202 }, { 0x1DD1, 0x1DF5, 230 },
+			{ 0x1DF6, 0x1DF6, 232 }, { 0x1DF7, 0x1DF8, 228 }, { 0x1DF9, 0x1DF9, 220 }, { 0x1DFA, 0x1DFA, 218 }, { 0x1DFB, 0x1DFB, 230 }, { 0x1DFC, 0x1DFC, 233 },
+			{ 0x1DFD, 0x1DFD, 220 }, { 0x1DFE, 0x1DFE, 230 }, { 0x1DFF, 0x1DFF, 220 }, { 0x20D0, 0x20D1, 230 }, { 0x20D2, 0x20D3, 1 }, { 0x20D4, 0x20D7, 230 },
+			{ 0x20D8, 0x20DA, 1 }, { 0x20DB, 0x20DC, 230 }, { 0x20E1, 0x20E1, 230 }, { 0x20E5, 0x20E6, 1 }, { 0x20E7, 0x20E7, 230 }, { 0x20E8, 0x20E8, 220 },
+			{ 0x20E9, 0x20E9, 230 }, { 0x20EA, 0x20EB, 1 }, { 0x20EC, 0x20EF, 220 }, { 0x20F0, 0x20F0, 230 }, { 0x2CEF, 0x2CF1, 230 }, { 0x2D7F, 0x2D7F, 9 },
+			{ 0x2DE0, 0x2DFF, 230 }, { 0x302A, 0x302A, 218 }, { 0x302B, 0x302B, 228 }, { 0x302C, 0x302C, 232 }, { 0x302D, 0x302D, 222 }, { 0x302E, 0x302F, 224 },
+			{ 0x3099, 0x309A, 8 }, { 0xA66F, 0xA66F, 230 }, { 0xA674, 0xA67D, 230 }, { 0xA69E, 0xA69F, 230 }, { 0xA6F0, 0xA6F1, 230 }, { 0xA806, 0xA806, 9 },
+			{ 0xA82C, 0xA82C, 9 }, { 0xA8C4, 0xA8C4, 9 }, { 0xA8E0, 0xA8F1, 230 }, { 0xA92B, 0xA92D, 220 }, { 0xA953, 0xA953, 9 }, { 0xA9B3, 0xA9B3, 7 },
+			{ 0xA9C0, 0xA9C0, 9 }, { 0xAAB0, 0xAAB0, 230 }, { 0xAAB2, 0xAAB3, 230 }, { 0xAAB4, 0xAAB4, 220 }, { 0xAAB7, 0xAAB8, 230 }, { 0xAABE, 0xAABF, 230 },
+			{ 0xAAC1, 0xAAC1, 230 }, { 0xAAF6, 0xAAF6, 9 }, { 0xABED, 0xABED, 9 }, { 0xFB1E, 0xFB1E, 26 }, { 0xFE20, 0xFE26, 230 }, { 0xFE27, 0xFE2D, 220 },
+			{ 0xFE2E, 0xFE2F, 230 }, { 0x101FD, 0x101FD, 220 }, { 0x102E0, 0x102E0, 220 }, { 0x10376, 0x1037A, 230 }, { 0x10A0D, 0x10A0D, 220 }, { 0x10A0F, 0x10A0F, 230 },
+			{ 0x10A38, 0x10A38, 230 }, { 0x10A39, 0x10A39, 1 }, { 0x10A3A, 0x10A3A, 220 }, { 0x10A3F, 0x10A3F, 9 }, { 0x10AE5, 0x10AE5, 230 }, { 0x10AE6, 0x10AE6, 220 },
+			{ 0x10D24, 0x10D27, 230 }, { 0x10EAB, 0x10EAC, 230 }, { 0x10F46, 0x10F47, 220 }, { 0x10F48, 0x10F4A, 230 }, { 0x10F4B, 0x10F4B, 220 }, { 0x10F4C, 0x10F4C, 230 },
+			{ 0x10F4D, 0x10F50, 220 }, { 0x10F82, 0x10F82, 230 }, { 0x10F83, 0x10F83, 220 }, { 0x10F84, 0x10F84, 230 }, { 0x10F85, 0x10F85, 220 }, { 0x11046, 0x11046, 9 },
+			{ 0x11070, 0x11070, 9 }, { 0x1107F, 0x1107F, 9 }, { 0x110B9, 0x110B9, 9 }, { 0x110BA, 0x110BA, 7 }, { 0x11100, 0x11102, 230 }, { 0x11133, 0x11134, 9 },
+			{ 0x11173, 0x11173, 7 }, { 0x111C0, 0x111C0, 9 }, { 0x111CA, 0x111CA, 7 }, { 0x11235, 0x11235, 9 }, { 0x11236, 0x11236, 7 }, { 0x112E9, 0x112E9, 7 },
+			{ 0x112EA, 0x112EA, 9 }, { 0x1133B, 0x1133C, 7 }, { 0x1134D, 0x1134D, 9 }, { 0x11366, 0x1136C, 230 }, { 0x11370, 0x11374, 230 }, { 0x11442, 0x11442, 9 },
+			{ 0x11446, 0x11446, 7 }, { 0x1145E, 0x1145E, 230 }, { 0x114C2, 0x114C2, 9 }, { 0x114C3, 0x114C3, 7 }, { 0x115BF, 0x115BF, 9 }, { 0x115C0, 0x115C0, 7 },
+			{ 0x1163F, 0x1163F, 9 }, { 0x116B6, 0x116B6, 9 }, { 0x116B7, 0x116B7, 7 }, { 0x1172B, 0x1172B, 9 }, { 0x11839, 0x11839, 9 }, { 0x1183A, 0x1183A, 7 },
+			{ 0x1193D, 0x1193E, 9 }, { 0x11943, 0x11943, 7 }, { 0x119E0, 0x119E0, 9 }, { 0x11A34, 0x11A34, 9 }, { 0x11A47, 0x11A47, 9 }, { 0x11A99, 0x11A99, 9 },
+			{ 0x11C3F, 0x11C3F, 9 }, { 0x11D42, 0x11D42, 7 }, { 0x11D44, 0x11D45, 9 }, { 0x11D97, 0x11D97, 9 }, { 0x16AF0, 0x16AF4, 1 }, { 0x16B30, 0x16B36, 230 },
+			{ 0x16FF0, 0x16FF1, 6 }, { 0x1BC9E, 0x1BC9E, 1 }, { 0x1D165, 0x1D166, 216 }, { 0x1D167, 0x1D169, 1 }, { 0x1D16D, 0x1D16D, 226 }, { 0x1D16E, 0x1D172, 216 },
+			{ 0x1D17B, 0x1D182, 220 }, { 0x1D185, 0x1D189, 230 }, { 0x1D18A, 0x1D18B, 220 }, { 0x1D1AA, 0x1D1AD, 230 }, { 0x1D242, 0x1D244, 230 }, { 0x1E000, 0x1E006, 230 },
+			{ 0x1E008, 0x1E018, 230 }, { 0x1E01B, 0x1E021, 230 }, { 0x1E023, 0x1E024, 230 }, { 0x1E026, 0x1E02A, 230 }, { 0x1E130, 0x1E136, 230 }, { 0x1E2AE, 0x1E2AE, 230 },
+			{ 0x1E2EC, 0x1E2EF, 230 }, { 0x1E8D0, 0x1E8D6, 220 }, { 0x1E944, 0x1E949, 230 }, { 0x1E94A, 0x1E94A, 7 },
+		};
+
+		enum : uint32_t {
+			NoCodePoint = 0xFFFFFFFF,
+			HangulS = 0xAC00, HangulL = 0x1100, HangulV = 0x1161, HangulT = 0x11A7,
+			HangulNumL = 19, HangulNumV = 21, HangulNumT = 28
+		};
+		enum : size_t {
+			NumFoldRanges = sizeof(foldRanges) / sizeof(foldRanges[0]),
+			NumFoldMultis = sizeof(foldMultis) / sizeof(foldMultis[0]),
+			NumCompositions = sizeof(compositions) / sizeof(compositions[0]),
+			NumClassRanges = sizeof(classRanges) / sizeof(classRanges[0]),
+			MaxMarks = 32 // combining marks after a starter that are kept for composing
+		};
+
+		// returns the end of the code point at str, or NULL if str doesn't start with valid UTF-8
+		inline const char* decodeUtf8(const char* str, const char* strEnd, uint32_t* cp) {
+			const uint8_t c = (uint8_t)*str;
+			size_t len;
+			uint32_t v, min;
+			if (c < 0x80)      { *cp = c; return str + 1; }
+			else if (c < 0xC0) { return NULL; }
+			else if (c < 0xE0) { len = 2; v = c & 0x1F; min = 0x80; }
+			else if (c < 0xF0) { len = 3; v = c & 0x0F; min = 0x800; }
+			else if (c < 0xF8) { len = 4; v = c & 0x07; min = 0x10000; }
+			else               { return NULL; }
+
+			if ((size_t)(strEnd - str) < len)
+				return NULL;
+			for (size_t i = 1; i < len; i++) {
+				if (((uint8_t)str[i] & 0xC0) != 0x80)
+					return NULL;
+				v = (v << 6) | ((uint8_t)str[i] & 0x3F);
+			}
+			if (v < min || v > 0x10FFFF || (v >= 0xD800 && v <= 0xDFFF)) // overlong, too big or a surrogate
+				return NULL;
+			*cp = v;
+			return str + len;
+		}
+		inline void appendUtf8(uint32_t cp, ds::vector<char>* out) {
+			if (cp < 0x80) {
+				out->push_back((char)cp);
+			}
+			else if (cp < 0x800) {
+				out->push_back((char)(0xC0 | (cp >> 6)));
+				out->push_back((char)(0x80 | (cp & 0x3F)));
+			}
+			else if (cp < 0x10000) {
+				out->push_back((char)(0xE0 | (cp >> 12)));
+				out->push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+				out->push_back((char)(0x80 | (cp & 0x3F)));
+			}
+			else {
+				out->push_back((char)(0xF0 | (cp >> 18)));
+				out->push_back((char)(0x80 | ((cp >> 12) & 0x3F)));
+				out->push_back((char)(0x80 | ((cp >> 6) & 0x3F)));
+				out->push_back((char)(0x80 | (cp & 0x3F)));
+			}
+		}
+
+		inline int getCombiningClass(uint32_t cp) {
+			if (cp < classRanges[0].first)
+				return 0;
+			size_t from = 0, to = NumClassRanges;
+			while (to - from > 1) { // last range starting at or before cp
+				const size_t mid = from + (to - from) / 2;
+				if (classRanges[mid].first <= cp)
+					from = mid;
+				else
+					to = mid;
+			}
+			return cp <= classRanges[from].last ? classRanges[from].combiningClass : 0;
+		}
+
+		// returns the primary composite of a and b, or NoCodePoint if there is none
+		inline uint32_t compose(uint32_t a, uint32_t b) {
+			if (a >= HangulL && a < HangulL + HangulNumL && b >= HangulV && b < HangulV + HangulNumV)
+				return HangulS + ((a - HangulL) * HangulNumV + (b - HangulV)) * HangulNumT;
+			if (a >= HangulS && a < HangulS + HangulNumL * HangulNumV * HangulNumT && (a - HangulS) % HangulNumT == 0 && b > HangulT && b < HangulT + HangulNumT)
+				return a + (b - HangulT);
+			if (a > 0xFFFF || b > 0xFFFF)
+				return NoCodePoint;
+
+			const uint32_t pair = (a << 16) | b;
+			size_t from = 0, to = NumCompositions;
+			while (from < to) {
+				const size_t mid = from + (to - from) / 2;
+				if (compositions[mid].pair < pair)
+					from = mid + 1;
+				else
+					to = mid;
+			}
+			return from < NumCompositions && compositions[from].pair == pair ? (uint32_t)compositions[from].composed : (uint32_t)NoCodePoint;
+		}
+
+		// appends the case folded cp. with keepAscii ASCII letters keep their case
+		inline void appendFolded(uint32_t cp, ds::vector<char>* out, bool keepAscii) {
+			if (cp < 0x80) {
+				out->push_back(keepAscii ? (char)cp : utils::toLowerAscii((char)cp));
+				return;
+			}
+
+			if (cp >= foldMultis[0].cp && cp <= foldMultis[NumFoldMultis - 1].cp) {
+				size_t from = 0, to = NumFoldMultis;
+				while (from < to) {
+					const size_t mid = from + (to - from) / 2;
+					if (foldMultis[mid].cp < cp)
+						from = mid + 1;
+					else
+						to = mid;
+				}
+				if (from < NumFoldMultis && foldMultis[from].cp == cp) {
+					for (const char* c = foldMultis[from].folded; *c; c++)
+						out->push_back(*c);
+					return;
+				}
+			}
+
+			size_t from = 0, to = NumFoldRanges;
+			while (to - from > 1) { // last range starting at or before cp
+				const size_t mid = from + (to - from) / 2;
+				if (foldRanges[mid].first <= cp)
+					from = mid;
+				else
+					to = mid;
+			}
+			const FoldRange& range = foldRanges[from];
+			if (cp >= range.first && (cp - range.first) % range.stride == 0 && (cp - range.first) / range.stride < range.count)
+				cp = (uint32_t)((int32_t)cp + range.delta);
+			appendUtf8(cp, out);
+		}
+
+		// appends the key a name is sorted and searched by: the name composed like NFC, then case folded (the full folding,
+		// so "ß" becomes "ss"). the key can be longer or shorter than the name, bytes that aren't valid UTF-8 are copied as they are.
+		// unlike NFC nothing gets decomposed or reordered first, which only makes a difference for marks that aren't in canonical
+		// order (NFD names are) and for the few characters NFC replaces (like the CJK compatibility ideographs).
+		// with keepAscii ASCII letters keep their case, for texts that get matched ignoring the ASCII case anyways (see Automaton)
+		void appendKey(const char* str, const char* strEnd, ds::vector<char>* out, bool keepAscii = false) {
+			uint32_t starter = NoCodePoint; // the last starter, which the marks after it may compose with
+			uint32_t marks[MaxMarks];       // the marks after the starter that didn't compose with it
+			size_t numMarks = 0;
+			int lastClass = -1; // combining class of the last mark, -1 right after the starter
+
+			struct Local {
+				static void flush(uint32_t* starter, const uint32_t* marks, size_t* numMarks, ds::vector<char>* out, bool keepAscii) {
+					if (*starter != NoCodePoint)
+						appendFolded(*starter, out, keepAscii);
+					for (size_t i = 0; i < *numMarks; i++)
+						appendFolded(marks[i], out, keepAscii);
+					*starter = NoCodePoint;
+					*numMarks = 0;
+				}
+			};
+
+			const char* c = str;
+			while (c < strEnd) {
+				// runs of ASCII are copied in one go, only their last char could compose with a mark after it
+				const char* runEnd = c;
+				while (runEnd < strEnd && (uint8_t)*runEnd < 0x80)
+					runEnd++;
+				if (runEnd < strEnd && runEnd > c)
+					runEnd--;
+				if (runEnd > c) {
+					Local::flush(&starter, marks, &numMarks, out, keepAscii);
+					const size_t off = out->size();
+					out->resize(off + (runEnd - c));
+					char* dst = &(*out)[off];
+					for (; c < runEnd; c++)
+						*dst++ = keepAscii ? *c : utils::toLowerAscii(*c);
+					continue;
+				}
+
+				uint32_t cp;
+				const char* next = decodeUtf8(c, strEnd, &cp);
+				if (!next) {
+					Local::flush(&starter, marks, &numMarks, out, keepAscii);
+					out->push_back(*c++);
+					continue;
+				}
+				c = next;
+
+				const int combiningClass = getCombiningClass(cp);
+				if (starter != NoCodePoint && (lastClass == -1 || lastClass < combiningClass)) { // not blocked from the starter
+					const uint32_t composed = compose(starter, cp);
+					if (composed != NoCodePoint) {
+						starter = composed;
+						continue;
+					}
+				}
+
+				if (combiningClass == 0 || numMarks == MaxMarks) {
+					Local::flush(&starter, marks, &numMarks, out, keepAscii);
+					starter = cp;
+					lastClass = -1;
+				}
+				else {
+					marks[numMarks++] = cp;
+					lastClass = combiningClass;
+				}
+			}
+			Local::flush(&starter, marks, &numMarks, out, keepAscii);
+		}
+	}
 
 	enum {
 		DEIG_NAME = 0,
@@ -200,79 +889,446 @@ namespace ImGuiFD {
 		DEIG_CREATION_DATE,
 	};
 
-	static int customStrCmp(const char* strA, const char* strB) {
-		while (true) {
-			char a = *strA++;
-			char b = *strB++;
+	// introsort: quicksort with median of three pivots, heapsort once the recursion gets too deep
+	// (so it stays O(n log n) for any input) and one insertion sort pass over the small ranges left at the end.
+	// less is passed as a functor so the comparisons get inlined, unlike with qsort()
+	namespace introSortImpl {
+		enum { SmallSize = 16 }; // ranges up to this size are left for the insertion sort
+
+		template<typename T, typename Less>
+		void insertionSort(T* first, T* last, const Less& less) {
+			for (T* it = first + 1; it < last; it++) {
+				T val = *it;
+				T* pos = it;
+				while (pos > first && less(val, pos[-1])) {
+					*pos = pos[-1];
+					pos--;
+				}
+				*pos = val;
+			}
+		}
 
-			if (a == 0 || b == 0) {
-				if (a == 0 && b == 0)
-					return 0;
-				if (a == 0)
-					return -1;
-				else
-					return 1;
+		template<typename T, typename Less>
+		void siftDown(T* heap, size_t i, size_t n, const Less& less) {
+			T val = heap[i];
+			while (true) {
+				size_t child = 2 * i + 1;
+				if (child >= n)
+					break;
+				if (child + 1 < n && less(heap[child], heap[child + 1]))
+					child++;
+				if (!less(val, heap[child]))
+					break;
+				heap[i] = heap[child];
+				i = child;
 			}
+			heap[i] = val;
+		}
 
-			if (a >= 'A' && a <= 'Z')
-				a += 'a' - 'A';
+		template<typename T, typename Less>
+		void heapSort(T* first, T* last, const Less& less) {
+			const size_t n = (size_t)(last - first);
+			for (size_t i = n / 2; i-- > 0; )
+				siftDown(first, i, n, less);
+			for (size_t end = n; end > 1; ) {
+				end--;
+				ImSwap(first[0], first[end]);
+				siftDown(first, 0, end, less);
+			}
+		}
 
-			if (b >= 'A' && b <= 'Z')
-				b += 'a' - 'A';
+		// moves the median of a, b and c to result
+		template<typename T, typename Less>
+		void moveMedianTo(T* result, T* a, T* b, T* c, const Less& less) {
+			if (less(*a, *b)) {
+				if (less(*b, *c))      ImSwap(*result, *b);
+				else if (less(*a, *c)) ImSwap(*result, *c);
+				else                   ImSwap(*result, *a);
+			}
+			else if (less(*a, *c))     ImSwap(*result, *a);
+			else if (less(*b, *c))     ImSwap(*result, *c);
+			else                       ImSwap(*result, *b);
+		}
 
-			if (a == b)
-				continue;
+		// the median of three guarantees an element on each side that stops the scans, so they don't need bounds checks
+		template<typename T, typename Less>
+		T* partition(T* first, T* last, const T& pivot, const Less& less) {
+			while (true) {
+				while (less(*first, pivot))
+					first++;
+				last--;
+				while (less(pivot, *last))
+					last--;
+				if (!(first < last))
+					return first;
+				ImSwap(*first, *last);
+				first++;
+			}
+		}
 
-			return a - b;
+		template<typename T, typename Less>
+		void sortLoop(T* first, T* last, size_t depthLimit, const Less& less) {
+			while (last - first > SmallSize) {
+				if (depthLimit == 0) {
+					heapSort(first, last, less);
+					return;
+				}
+				depthLimit--;
+				moveMedianTo(first, first + 1, first + (last - first) / 2, last - 1, less);
+				T* cut = partition(first + 1, last, *first, less);
+				sortLoop(cut, last, depthLimit, less); // recurse into one half, loop on the other
+				last = cut;
+			}
 		}
 	}
 
-	static int compareSortSpecs(const void* lhs, const void* rhs){
-		auto& a = (*globalSortData)[*(size_t*)lhs];
-		auto& b = (*globalSortData)[*(size_t*)rhs];
+	template<typename T, typename Less>
+	void introSort(T* first, T* last, const Less& less) {
+		if (last - first < 2)
+			return;
+		size_t depthLimit = 0;
+		for (size_t n = (size_t)(last - first); n > 1; n >>= 1)
+			depthLimit += 2;
+		introSortImpl::sortLoop(first, last, depthLimit, less);
+		introSortImpl::insertionSort(first, last, less); // every element is at most SmallSize away from its place by now
+	}
+
+	// merge sort over indices that can stop after any step and continue later on,
+	// so sorting big directories can be spread over multiple frames.
+	// the work is cut into tasks (one run, or one piece of a merge) that get spread over threads (see Native::parallelFor()).
+	// the input can be split into two segments that get sorted separately, e.g. folders and files
+	class SlicedMergeSort {
+		enum {
+			RunSize = 1024,          // runs of this size get sorted with introSort() first, then they get merged
+			MergeTaskSize = 1 << 13, // elements merged per task
+			TasksPerThread = 2       // tasks per thread between checking the time
+		};
+
+		ds::vector<size_t> bufs[2];
+		size_t segEnds[2] = { 0, 0 };
+		size_t seg = 0;
+		int src = 0;
+		size_t width = 0; // size of the sorted runs in bufs[src], 0 while the runs aren't sorted yet
+		size_t pos = 0;   // where the next task starts, relative to the segment
+
+		ds::vector<size_t> taskStarts; // of the current batch
+		size_t numThreads = 1;
+
+		bool active = false;
+
+		template<typename Less>
+		struct TaskCtx {
+			SlicedMergeSort* sort;
+			const Less* less;
+		};
+
+		size_t segBegin() const {
+			return seg == 0 ? 0 : segEnds[0];
+		}
+		size_t segSize() const {
+			return segEnds[seg] - segBegin();
+		}
 
-		if (settings.showDirFirst) {
-			if (a.isFolder && !b.isFolder) return -1;
-			if (!a.isFolder && b.isFolder) return 1;
+		template<typename Less>
+		static void runTask(void* userData, size_t taskInd, size_t threadInd) {
+			(void)threadInd;
+			const TaskCtx<Less>& ctx = *(const TaskCtx<Less>*)userData;
+			SlicedMergeSort& s = *ctx.sort;
+			size_t* data = &s.bufs[s.src][s.segBegin()];
+			const size_t start = s.taskStarts[taskInd];
+			introSort(data + start, data + ImMin(start + (size_t)RunSize, s.segSize()), *ctx.less);
 		}
 
-		for (int i = 0; i < globalSortSpecs->SpecsCount; i++) {
-			auto& specs = globalSortSpecs->Specs[i];
-			int delta = 0;
-			switch (specs.ColumnUserID) {
-				case DEIG_NAME:
-					delta = customStrCmp(a.name, b.name);
-					break;
-				case DEIG_SIZE: {
-					int64_t diff = ((int64_t)a.size - (int64_t)b.size); // int64 to prevent overflows
-					if (diff < 0) delta = -1;
-					if (diff > 0) delta = 1;
-					break;
+		// merges the part [start, start + MergeTaskSize) of the output of a pair of runs.
+		// where that part starts in both runs is found with a binary search, so every part can be merged on its own
+		template<typename Less>
+		static void mergeTask(void* userData, size_t taskInd, size_t threadInd) {
+			(void)threadInd;
+			const TaskCtx<Less>& ctx = *(const TaskCtx<Less>*)userData;
+			const Less& less = *ctx.less;
+			SlicedMergeSort& s = *ctx.sort;
+			const size_t n = s.segSize();
+			const size_t* in = &s.bufs[s.src][s.segBegin()];
+			size_t* out = &s.bufs[s.src ^ 1][s.segBegin()];
+
+			const size_t start = s.taskStarts[taskInd];
+			const size_t lo = start / (2 * s.width) * (2 * s.width);
+			const size_t mid = ImMin(lo + s.width, n);
+			const size_t hi = ImMin(lo + 2 * s.width, n);
+			const size_t end = ImMin(start + (size_t)MergeTaskSize, hi);
+
+			// smallest i for which the left run's element i doesn't go before the right run's element k-i-1
+			const size_t k = start - lo;
+			const size_t lenA = mid - lo, lenB = hi - mid;
+			size_t first = k > lenB ? k - lenB : 0;
+			size_t last = ImMin(k, lenA);
+			while (first < last) {
+				const size_t a = first + (last - first) / 2;
+				if (!less(in[mid + k - a - 1], in[lo + a]))
+					first = a + 1;
+				else
+					last = a;
+			}
+
+			size_t i = lo + first;
+			size_t j = mid + (k - first);
+			for (size_t o = start; o < end; o++) {
+				if (i < mid && (j >= hi || !less(in[j], in[i]))) // take the left one on ties to keep the sort stable
+					out[o] = in[i++];
+				else
+					out[o] = in[j++];
+			}
+		}
+	public:
+		// copies inds, the ones in firstSegment (if not NULL) before the others. both segments get sorted separately
+		void begin(const ds::vector<size_t>& inds, const ds::bitset* firstSegment = NULL) {
+			// resize instead of assigning, so the buffers of the last sort get reused
+			bufs[0].resize(inds.size());
+			bufs[1].resize(inds.size());
+			size_t numFirst = 0;
+			if (firstSegment) {
+				for (size_t i = 0; i < inds.size(); i++)
+					numFirst += firstSegment->get(inds[i]);
+				size_t a = 0, b = numFirst;
+				for (size_t i = 0; i < inds.size(); i++)
+					bufs[0][firstSegment->get(inds[i]) ? a++ : b++] = inds[i];
+			}
+			else {
+				for (size_t i = 0; i < inds.size(); i++)
+					bufs[0][i] = inds[i];
+			}
+			segEnds[0] = numFirst;
+			segEnds[1] = inds.size();
+			seg = 0;
+			src = 0;
+			width = 0;
+			pos = 0;
+			active = true;
+		}
+		void cancel() {
+			active = false;
+		}
+		bool isActive() const {
+			return active;
+		}
+
+		// works until deadline (see Native::getTime()) on up to maxThreads threads, but does at least one batch of tasks.
+		// returns true once everything is sorted.
+		// less(a, b) returns if index a goes before index b, it has to order the same way in every step
+		template<typename Less>
+		bool step(const Less& less, double deadline, size_t maxThreads = 1) {
+			TaskCtx<Less> ctx = { this, &less };
+			numThreads = ImMax(maxThreads, (size_t)1);
+
+			while (seg < 2) {
+				const size_t n = segSize();
+				if (width == 0) {
+					if (pos >= n) {
+						width = RunSize;
+						pos = 0;
+						continue;
+					}
+					taskStarts.clear();
+					for (; pos < n && taskStarts.size() < numThreads * TasksPerThread; pos += RunSize)
+						taskStarts.push_back(pos);
+					Native::parallelFor(taskStarts.size(), runTask<Less>, &ctx, ImMin(numThreads, taskStarts.size()));
 				}
-				case DEIG_CREATION_DATE: {
-					int64_t diff = ((int64_t)a.creationDate - (int64_t)b.creationDate); // int64 to prevent overflows
-					if (diff < 0) delta = -1;
-					if (diff > 0) delta = 1;
-					break;
+				else if (width < n) {
+					if (pos >= n) {
+						src ^= 1;
+						width *= 2;
+						pos = 0;
+						continue;
+					}
+					taskStarts.clear();
+					while (pos < n && taskStarts.size() < numThreads * TasksPerThread) {
+						taskStarts.push_back(pos);
+						const size_t pairEnd = ImMin((pos / (2 * width) + 1) * (2 * width), n);
+						pos = ImMin(pos + (size_t)MergeTaskSize, pairEnd); // tasks don't cross pairs of runs
+					}
+					Native::parallelFor(taskStarts.size(), mergeTask<Less>, &ctx, ImMin(numThreads, taskStarts.size()));
+				}
+				else {
+					// the result of every segment has to end up in bufs[0]
+					if (src == 1) {
+						for (size_t i = segBegin(); i < segEnds[seg]; i++)
+							bufs[0][i] = bufs[1][i];
+						src = 0;
+					}
+					seg++;
+					width = 0;
+					pos = 0;
+					continue;
 				}
-				case DEIG_LASTMOD_DATE: {
-					int64_t diff = ((int64_t)a.lastModified - (int64_t)b.lastModified); // int64 to prevent overflows
-					if (diff < 0) delta = -1;
-					if (diff > 0) delta = 1;
+
+				if (Native::getTime() >= deadline)
+					return false;
+			}
+
+			active = false;
+			return true;
+		}
+
+		ds::vector<size_t>& getResult() {
+			return bufs[0];
+		}
+	};
+
+	// LSD radix sort over indices by 64 bit keys, 8 bits per pass, that can stop after any chunk and continue later on.
+	// it's stable, so sorting by multiple keys is done by sorting by the least significant key first.
+	// passes in which all keys have the same byte get skipped, so small values (like dates) only need a few
+	class SlicedRadixSort {
+		enum {
+			ChunkSize = 1 << 16 // elements between checking the time
+		};
+		enum Phase {
+			Phase_LoadKeys = 0, // also counts the values of every byte of the keys
+			Phase_Scatter
+		};
+
+		struct Item {
+			uint64_t key;
+			size_t ind;
+		};
+
+		ds::vector<Item> bufs[2];
+		int src = 0;
+		size_t numKeys = 0;
+		size_t keyInd = 0; // the key currently sorted by
+		Phase phase = Phase_LoadKeys;
+		unsigned pass = 0; // byte of the key that gets scattered
+		size_t pos = 0;
+		size_t counts[8][256];
+		size_t offsets[256];
+
+		bool active = false;
+
+		// moves on to the next byte of the key that isn't the same for all items
+		void nextPass(unsigned from) {
+			const size_t n = bufs[0].size();
+			for (pass = from; pass < 8; pass++) {
+				if (counts[pass][(bufs[src][0].key >> (pass * 8)) & 0xff] != n)
 					break;
+			}
+			if (pass == 8) { // done with this key
+				keyInd++;
+				phase = Phase_LoadKeys;
+				return;
+			}
+			size_t sum = 0;
+			for (size_t b = 0; b < 256; b++) {
+				offsets[b] = sum;
+				sum += counts[pass][b];
+			}
+		}
+	public:
+		// sorts inds by numKeys keys, the first one being the least significant (see step())
+		void begin(const ds::vector<size_t>& inds, size_t numKeys_) {
+			bufs[0].resize(inds.size());
+			bufs[1].resize(inds.size());
+			for (size_t i = 0; i < inds.size(); i++)
+				bufs[0][i].ind = inds[i];
+			src = 0;
+			numKeys = numKeys_;
+			keyInd = 0;
+			phase = Phase_LoadKeys;
+			pos = 0;
+			active = true;
+		}
+		void cancel() {
+			active = false;
+		}
+		bool isActive() const {
+			return active;
+		}
+
+		// works until deadline (see Native::getTime()) but does at least one chunk, returns true once everything is sorted.
+		// keyOf(k, ind) returns key number k of index ind, smaller keys go first
+		template<typename KeyOf>
+		bool step(const KeyOf& keyOf, double deadline) {
+			const size_t n = bufs[0].size();
+			while (keyInd < numKeys && n > 1) {
+				const size_t end = ImMin(pos + (size_t)ChunkSize, n);
+				Item* items = &bufs[src][0];
+				switch (phase) {
+					case Phase_LoadKeys:
+						if (pos == 0)
+							memset(counts, 0, sizeof(counts));
+						for (size_t i = pos; i < end; i++) {
+							const uint64_t key = keyOf(keyInd, items[i].ind);
+							items[i].key = key;
+							for (unsigned p = 0; p < 8; p++)
+								counts[p][(key >> (p * 8)) & 0xff]++;
+						}
+						break;
+					case Phase_Scatter: {
+						Item* out = &bufs[src ^ 1][0];
+						const unsigned shift = pass * 8;
+						for (size_t i = pos; i < end; i++)
+							out[offsets[(items[i].key >> shift) & 0xff]++] = items[i];
+						break;
+					}
+				}
+
+				pos = end;
+				if (pos == n) {
+					pos = 0;
+					switch (phase) {
+						case Phase_LoadKeys:
+							phase = Phase_Scatter;
+							nextPass(0);
+							break;
+						case Phase_Scatter:
+							src ^= 1;
+							nextPass(pass + 1);
+							break;
+					}
 				}
+				if (keyInd < numKeys && Native::getTime() >= deadline)
+					return false;
 			}
 
-			if (delta > 0)
-				return (specs.SortDirection == ImGuiSortDirection_Ascending) ? +1 : -1;
-			if (delta < 0)
-				return (specs.SortDirection == ImGuiSortDirection_Ascending) ? -1 : +1;
+			active = false;
+			return true;
 		}
 
-		return (int)a.id-(int)b.id;
-	}
+		void getResult(ds::vector<size_t>* out) const {
+			out->resize(bufs[src].size());
+			for (size_t i = 0; i < bufs[src].size(); i++)
+				(*out)[i] = bufs[src][i].ind;
+		}
+	};
 
 	class EditablePath {
+		// widthsFromBack[i] is the width of the buttons of parts[i] to the last part, including their spacing (see DrawDirBar()).
+		// measured again when the path, the font or the style changes
+		ds::vector<float> widthsFromBack;
+		float ellipsisWidth = 0;
+		bool widthsValid = false;
+		const ImFont* widthsFont = NULL;
+		float widthsFontSize = 0;
+		float widthsPadding = 0;
+		float widthsSpacing = 0;
+
+		void updateWidths() {
+			ImGuiContext& g = *GImGui;
+			const ImGuiStyle& style = g.Style;
+			if (widthsValid && widthsFont == g.Font && widthsFontSize == g.FontSize && widthsPadding == style.FramePadding.x && widthsSpacing == style.ItemSpacing.x)
+				return;
+			widthsValid = true;
+			widthsFont = g.Font;
+			widthsFontSize = g.FontSize;
+			widthsPadding = style.FramePadding.x;
+			widthsSpacing = style.ItemSpacing.x;
+
+			widthsFromBack.resize(parts.size());
+			float total = 0;
+			for (size_t i = parts.size(); i-- > 0; ) {
+				total += ImGui::CalcTextSize(parts[i].c_str(), NULL, true).x + style.FramePadding.x * 2.0f + style.ItemSpacing.x;
+				widthsFromBack[i] = total;
+			}
+			ellipsisWidth = ImGui::CalcTextSize("...").x + style.FramePadding.x * 2 + style.ItemSpacing.x;
+		}
 	public:
 		ds::vector<ds::string> parts;
 
@@ -287,11 +1343,13 @@ namespace ImGuiFD {
 					Native::getAbsolutePath(rawPathFix.c_str()).c_str()
 				).c_str()
 			);
+			widthsValid = false;
 		}
 
 		bool setBackToInd(size_t ind) {
 			if (ind + 1 != parts.size()) {
 				parts.resize(ind+1);
+				widthsValid = false;
 				return true;
 			}
 			return false;
@@ -300,6 +1358,7 @@ namespace ImGuiFD {
 		bool goUp() {
 			if (parts.size() > 1) {
 				parts.resize(parts.size() - 1);
+				widthsValid = false;
 				return true;
 			}
 			return false;
@@ -307,6 +1366,33 @@ namespace ImGuiFD {
 
 		void moveDownTo(const char* folder) {
 			parts.push_back(folder);
+			widthsValid = false;
+		}
+
+		// the part the buttons start on when they have to fit into width, it gets covered by the "..." button.
+		// (size_t)-1 if all of them fit. if totalWidth isn't NULL it is set to the width of the buttons from that part on
+		size_t findLastToFit(float width, float* totalWidth = NULL) {
+			updateWidths();
+			// widthsFromBack only gets smaller, look for the last part that is still too wide
+			size_t lo = 0, hi = widthsFromBack.size();
+			while (lo < hi) {
+				const size_t mid = lo + (hi - lo) / 2;
+				if (widthsFromBack[mid] > width)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			if (lo == 0) {
+				if (totalWidth) *totalWidth = widthsFromBack.size() > 0 ? widthsFromBack[0] : 0;
+				return (size_t)-1;
+			}
+			if (totalWidth) *totalWidth = widthsFromBack[lo - 1];
+			return lo - 1;
+		}
+		// width of the "..." button shown in place of the parts that don't fit
+		float getEllipsisWidth() {
+			updateWidths();
+			return ellipsisWidth;
 		}
 
 		ds::string toString() {
@@ -332,266 +1418,4445 @@ namespace ImGuiFD {
 		}
 	};
 
-	class FileNameFilter {
-	private:
-		class Filter {
-			class SubFilter {
-				ds::string name;
-
-				ds::string include;
-				ds::string exclude;
-
-				ds::string fileName;
-				ds::string fileExt;
+	// matches a set of patterns against a string in a single pass:
+	// the patterns get compiled into one NFA, which is turned into a DFA lazily while matching (only the states that are actually reached get built)
+	class Automaton {
+	public:
+		enum { MaxPatterns = 64 }; // accepted patterns are reported as a bitmask
+		enum { MaxDFAStates = 2048 }; // if more states are needed the dfa cache gets flushed
 
-				ds::string exact;
+	private:
+		struct ByteSet {
+			uint32_t bits[8] = {0,0,0,0,0,0,0,0};
 
-			public:
+			bool has(uint8_t c) const {
+				return (bits[c >> 5] & ((uint32_t)1 << (c & 31))) != 0;
+			}
+			void add(uint8_t c) {
+				bits[c >> 5] |= (uint32_t)1 << (c & 31);
+			}
+			void addRange(uint8_t from, uint8_t to) {
+				for (int c = from; c <= to; c++)
+					add((uint8_t)c);
+			}
+			void addCaseInsensitive(uint8_t c) {
+				add(c);
+				if (c >= 'A' && c <= 'Z') add((uint8_t)(c + ('a' - 'A')));
+				if (c >= 'a' && c <= 'z') add((uint8_t)(c - ('a' - 'A')));
+			}
+			void invert() {
+				for (size_t i = 0; i < 8; i++)
+					bits[i] = ~bits[i];
+			}
+			void addAll(const ByteSet& other) {
+				for (size_t i = 0; i < 8; i++)
+					bits[i] |= other.bits[i];
+			}
+		};
 
-				SubFilter(ds::string cmd) {
-					{
-						const char* colPos = strchr(cmd.c_str(), ':');
-						if (colPos != nullptr) {
-							name = cmd.substr(0, colPos - cmd.c_str());
-							cmd = cmd.substr(colPos - cmd.c_str() + 1, cmd.size());
-						}
-					}
+		struct NFAState {
+			enum : uint8_t {
+				Type_Bytes = 0, // consumes one byte contained in byteSets[arg], then goes to out0
+				Type_Split,     // goes to out0 and out1 without consuming anything
+				Type_Accept,    // pattern number arg matched
+				Type_AssertBegin, // goes to out0 only at the start of the string (regex '^')
+				Type_AssertEnd    // goes to out0 only at the end of the string (regex '$')
+			};
+			uint8_t type;
+			uint32_t out0;
+			uint32_t out1;
+			uint32_t arg;
+		};
 
-					cmd = ds::replace(cmd.c_str(), " ", "");
+		// unfinished piece of the nfa; outs are the dangling transitions encoded as (stateInd << 1 | whichOut)
+		struct Frag {
+			uint32_t start;
+			ds::vector<uint32_t> outs;
+		};
 
-					if (cmd[0] == '=') {
-						exact = cmd.substr(1, cmd.size());
-					}
-					else if (cmd[0] == '!') {
-						exclude = cmd.substr(1, cmd.size());
-					}
-					else {
-						const char* dotPos = strrchr(cmd.c_str(), '.');
-						if (dotPos != NULL) {
-							fileName = cmd.substr(0, dotPos - cmd.c_str());
-							fileExt = cmd.substr(dotPos - cmd.c_str() + 1, cmd.size());
-
-							if (fileName == "*")
-								fileName = "";
-							if (fileExt == "*")
-								fileExt = "";
-						}
-						else {
-							include = cmd;
-						}
-					}
-				}
+		ds::vector<NFAState> nfa;
+		ds::vector<ByteSet> byteSets;
+		ds::vector<uint32_t> starts; // start state of every pattern
+
+		uint32_t addState(uint8_t type, uint32_t arg = 0) {
+			NFAState state;
+			state.type = type;
+			state.out0 = state.out1 = 0;
+			state.arg = arg;
+			nfa.push_back(state);
+			return (uint32_t)(nfa.size() - 1);
+		}
+		void patch(const Frag& frag, uint32_t to) {
+			for (size_t i = 0; i < frag.outs.size(); i++) {
+				NFAState& state = nfa[frag.outs[i] >> 1];
+				if (frag.outs[i] & 1)
+					state.out1 = to;
+				else
+					state.out0 = to;
+			}
+		}
 
-				bool passes(const char* str) {
-					if (exact.size() > 0 && exact != str)
-						return false;
+		Frag fragBytes(const ByteSet& set) {
+			byteSets.push_back(set);
+			Frag frag;
+			frag.start = addState(NFAState::Type_Bytes, (uint32_t)(byteSets.size() - 1));
+			frag.outs.push_back(frag.start << 1);
+			return frag;
+		}
+		Frag fragEmpty() {
+			Frag frag;
+			frag.start = addState(NFAState::Type_Split);
+			frag.outs.push_back(frag.start << 1);
+			frag.outs.push_back(frag.start << 1 | 1);
+			return frag;
+		}
+		Frag fragConcat(const Frag& a, const Frag& b) {
+			patch(a, b.start);
+			Frag frag;
+			frag.start = a.start;
+			frag.outs = b.outs;
+			return frag;
+		}
+		Frag fragAlt(const Frag& a, const Frag& b) {
+			Frag frag;
+			frag.start = addState(NFAState::Type_Split);
+			nfa[frag.start].out0 = a.start;
+			nfa[frag.start].out1 = b.start;
+			frag.outs = a.outs;
+			for (size_t i = 0; i < b.outs.size(); i++)
+				frag.outs.push_back(b.outs[i]);
+			return frag;
+		}
+		Frag fragStar(const Frag& a) {
+			Frag frag;
+			frag.start = addState(NFAState::Type_Split);
+			nfa[frag.start].out0 = a.start;
+			patch(a, frag.start);
+			frag.outs.push_back(frag.start << 1 | 1);
+			return frag;
+		}
+		Frag fragPlus(const Frag& a) {
+			const uint32_t loop = addState(NFAState::Type_Split);
+			nfa[loop].out0 = a.start;
+			patch(a, loop);
+			Frag frag;
+			frag.start = a.start;
+			frag.outs.push_back(loop << 1 | 1);
+			return frag;
+		}
+		Frag fragQuest(const Frag& a) {
+			Frag frag;
+			frag.start = addState(NFAState::Type_Split);
+			nfa[frag.start].out0 = a.start;
+			frag.outs = a.outs;
+			frag.outs.push_back(frag.start << 1 | 1);
+			return frag;
+		}
 
-					if (include.size() > 0 && strstr(str, include.c_str()) == NULL)
-						return false;
+		// any single utf8 encoded char: one non continuation byte followed by any continuation bytes
+		Frag fragAnyChar() {
+			ByteSet lead;
+			lead.addRange(0x80, 0xBF);
+			lead.invert();
+			ByteSet cont;
+			cont.addRange(0x80, 0xBF);
+			return fragConcat(fragBytes(lead), fragStar(fragBytes(cont)));
+		}
+		Frag fragAnyString() {
+			ByteSet all;
+			all.invert();
+			return fragStar(fragBytes(all));
+		}
+		// one whole utf8 char (including multi byte ones) that isn't in set
+		Frag fragNotIn(const ByteSet& set) {
+			ByteSet cont;
+			cont.addRange(0x80, 0xBF);
+			ByteSet lead = set;
+			lead.invert();
+			for (size_t i = 0; i < 8; i++)
+				lead.bits[i] &= ~cont.bits[i];
+			return fragConcat(fragBytes(lead), fragStar(fragBytes(cont)));
+		}
+		Frag fragAssert(uint8_t type) {
+			Frag frag;
+			frag.start = addState(type);
+			frag.outs.push_back(frag.start << 1);
+			return frag;
+		}
+		Frag fragLiteral(const char* str, const char* strEnd, bool caseInsensitive) {
+			Frag frag = fragEmpty();
+			for (const char* c = str; c < strEnd; c++) {
+				ByteSet set;
+				if (caseInsensitive)
+					set.addCaseInsensitive((uint8_t)*c);
+				else
+					set.add((uint8_t)*c);
+				frag = fragConcat(frag, fragBytes(set));
+			}
+			return frag;
+		}
 
-					if (exclude.size() > 0 && strstr(str, exclude.c_str()) != NULL)
-						return false;
+		size_t finishPattern(const Frag& frag) {
+			IM_ASSERT(starts.size() < MaxPatterns);
+			const size_t patternInd = starts.size();
+			patch(frag, addState(NFAState::Type_Accept, (uint32_t)patternInd));
+			starts.push_back(frag.start);
+			clearDFA();
+			return patternInd;
+		}
 
-					{
-						const char* dotPos = strrchr(str, '.');
-						if (dotPos == NULL) {
-							if (fileExt.size() > 0)
-								return false;
-							if (fileName.size() > 0 && fileName != str)
-								return false;
-						}
-						else {
-							if (fileExt.size() > 0 && fileExt != (dotPos+1))
-								return false;
+		enum {
+			DFA_Unknown = -1,
+			DFA_Dead = -2 // transition into the dead state, stored separately so the hot loop in match() doesn't have to check for it
+		};
+		struct DFAState {
+			size_t setOff;
+			size_t setLen; // 0 => dead state, nothing can match anymore
+			uint64_t accepts;
+		};
+		ds::vector<DFAState> dfa;
+		ds::vector<uint32_t> dfaSets;  // sorted sets of nfa states, one per dfa state
+		ds::vector<int32_t> dfaTrans;  // 256 transitions per dfa state, DFA_Unknown if not computed yet
+		ds::vector<int32_t> dfaLookup; // open addressing hash table: nfa state set -> dfa state
+		int32_t dfaStart = -1;
+
+		ds::vector<uint32_t> closureMarks;
+		uint32_t closureGen = 0;
+		ds::vector<uint32_t> closureStack;
+		ds::vector<uint32_t> tmpSet;
+		ds::vector<uint32_t> endSet;
+
+		void clearDFA() {
+			dfa.clear();
+			dfaSets.clear();
+			dfaTrans.clear();
+			dfaLookup.clear();
+			dfaStart = -1;
+		}
 
-							if (fileName.size() > 0 && strncmp(fileName.c_str(), str, fileName.size() < (size_t)(dotPos - str) ? fileName.size() : (dotPos - str)) != 0)
-								return false;
-						}
+		// adds every state that can be reached from state without consuming a byte to out.
+		// '^' is only passed at the start of the string, '$' only at the end (otherwise it stays in the set until then)
+		void addClosure(uint32_t state, ds::vector<uint32_t>* out, bool atStart = false, bool atEnd = false) {
+			closureStack.push_back(state);
+			while (closureStack.size() > 0) {
+				const uint32_t s = closureStack.back();
+				closureStack.pop_back();
+				if (closureMarks[s] == closureGen)
+					continue;
+				closureMarks[s] = closureGen;
+
+				switch (nfa[s].type) {
+					case NFAState::Type_Split:
+						closureStack.push_back(nfa[s].out1);
+						closureStack.push_back(nfa[s].out0);
+						break;
+					case NFAState::Type_AssertBegin:
+						if (atStart)
+							closureStack.push_back(nfa[s].out0);
+						break;
+					case NFAState::Type_AssertEnd:
+						if (atEnd)
+							closureStack.push_back(nfa[s].out0);
+						else
+							out->push_back(s);
+						break;
+					default:
+						out->push_back(s);
+						break;
+				}
+			}
+		}
+		void beginClosure() {
+			if (closureMarks.size() != nfa.size())
+				closureMarks = ds::vector<uint32_t>(nfa.size(), 0);
+			if (++closureGen == 0) { // wrapped around
+				for (size_t i = 0; i < closureMarks.size(); i++)
+					closureMarks[i] = 0;
+				closureGen = 1;
+			}
+		}
 
-					}
+		static void sortSet(ds::vector<uint32_t>* set) {
+			for (size_t i = 1; i < set->size(); i++) { // sets are small, insertion sort is fine
+				const uint32_t v = (*set)[i];
+				size_t j = i;
+				for (; j > 0 && (*set)[j-1] > v; j--)
+					(*set)[j] = (*set)[j-1];
+				(*set)[j] = v;
+			}
+		}
 
-					return true;
+		static ImGuiID hashSet(const uint32_t* set, size_t len) {
+			return ImHashData(set, len * sizeof(uint32_t));
+		}
+
+		void rehashDFA(size_t tableSize) {
+			dfaLookup = ds::vector<int32_t>(tableSize, -1);
+			for (size_t i = 0; i < dfa.size(); i++) {
+				size_t slot = hashSet(&dfaSets[0] + dfa[i].setOff, dfa[i].setLen) & (tableSize - 1);
+				while (dfaLookup[slot] != -1)
+					slot = (slot + 1) & (tableSize - 1);
+				dfaLookup[slot] = (int32_t)i;
+			}
+		}
+
+		// returns the dfa state for the (sorted) nfa state set, creates it if it doesn't exist yet
+		int32_t getDFAState(const ds::vector<uint32_t>& set) {
+			const uint32_t* setData = set.size() > 0 ? &set[0] : NULL;
+			const ImGuiID hash = hashSet(setData, set.size());
+
+			if (dfaLookup.size() > 0) {
+				size_t slot = hash & (dfaLookup.size() - 1);
+				while (dfaLookup[slot] != -1) {
+					const DFAState& state = dfa[dfaLookup[slot]];
+					if (state.setLen == set.size() && (set.size() == 0 || memcmp(&dfaSets[state.setOff], setData, set.size() * sizeof(uint32_t)) == 0))
+						return dfaLookup[slot];
+					slot = (slot + 1) & (dfaLookup.size() - 1);
 				}
-			};
+			}
 
-			ds::vector<SubFilter> filters;
-		public:
-			ds::string rawStr;
-			
-			Filter(const ds::string& cmd) : rawStr(cmd) {
-				size_t last = 0;
-				for (size_t i = 0; i < cmd.size(); i++) {
-					if (cmd[i] == ',' && i>last) {
-						filters.push_back(SubFilter(cmd.substr(last, i)));
-						last = i + 1;
-					}
+			if (dfa.size() >= MaxDFAStates)
+				clearDFA();
+
+			DFAState state;
+			state.setOff = dfaSets.size();
+			state.setLen = set.size();
+			state.accepts = 0;
+			bool hasAssertEnd = false;
+			for (size_t i = 0; i < set.size(); i++) {
+				dfaSets.push_back(set[i]);
+				if (nfa[set[i]].type == NFAState::Type_Accept)
+					state.accepts |= (uint64_t)1 << nfa[set[i]].arg;
+				if (nfa[set[i]].type == NFAState::Type_AssertEnd)
+					hasAssertEnd = true;
+			}
+			if (hasAssertEnd) {
+				// accepts is only looked at once the string ended, so everything behind a '$' counts too
+				endSet.clear();
+				beginClosure();
+				for (size_t i = 0; i < set.size(); i++) {
+					if (nfa[set[i]].type == NFAState::Type_AssertEnd)
+						addClosure(set[i], &endSet, false, true);
 				}
-				if (last != cmd.size()) {
-					filters.push_back(SubFilter(cmd.substr(last, cmd.size())));
+				for (size_t i = 0; i < endSet.size(); i++) {
+					if (nfa[endSet[i]].type == NFAState::Type_Accept)
+						state.accepts |= (uint64_t)1 << nfa[endSet[i]].arg;
 				}
 			}
+			dfa.push_back(state);
+			dfaTrans.resize(dfa.size() * 256, DFA_Unknown);
 
-			bool passes(const char* name) {
-				if (filters.size() == 0)
-					return true;
+			if (dfaLookup.size() < dfa.size() * 2)
+				rehashDFA(dfaLookup.size() > 0 ? dfaLookup.size() * 2 : 64);
+			else {
+				size_t slot = hash & (dfaLookup.size() - 1);
+				while (dfaLookup[slot] != -1)
+					slot = (slot + 1) & (dfaLookup.size() - 1);
+				dfaLookup[slot] = (int32_t)(dfa.size() - 1);
+			}
 
-				for (size_t i = 0; i < filters.size(); i++) {
-					if (filters[i].passes(name))
-						return true;
-				}
-				return false;
+			return (int32_t)(dfa.size() - 1);
+		}
+
+		int32_t getStartState() {
+			if (dfaStart == -1) {
+				tmpSet.clear();
+				beginClosure();
+				for (size_t i = 0; i < starts.size(); i++)
+					addClosure(starts[i], &tmpSet, true);
+				sortSet(&tmpSet);
+				dfaStart = getDFAState(tmpSet);
+			}
+			return dfaStart;
+		}
+
+		int32_t computeTransition(int32_t from, uint8_t c) {
+			tmpSet.clear();
+			beginClosure();
+			const DFAState state = dfa[from];
+			for (size_t i = 0; i < state.setLen; i++) {
+				const NFAState& nfaState = nfa[dfaSets[state.setOff + i]];
+				if (nfaState.type == NFAState::Type_Bytes && byteSets[nfaState.arg].has(c))
+					addClosure(nfaState.out0, &tmpSet);
 			}
+			sortSet(&tmpSet);
+
+			const size_t numStatesBefore = dfa.size();
+			const int32_t to = getDFAState(tmpSet);
+			if (dfa.size() >= numStatesBefore) // cache wasn't flushed, so "from" is still valid
+				dfaTrans[(size_t)from * 256 + c] = dfa[to].setLen > 0 ? to : DFA_Dead;
+			return to;
+		}
+
+		enum {
+			MaxRegexStates = 1 << 14, // bigger regexes (e.g. lots of nested repetitions) are treated as invalid
+			MaxRegexDepth = 64,
+			MaxRegexRepeat = 1000
 		};
 
-	public:
-		ds::string searchText;
-		size_t filterSel = 0; // currently selected filter
-		ds::vector<Filter> filters;
+		struct RegexParser {
+			const char* c;
+			const char* end;
+			bool caseInsensitive;
+			bool failed = false;
+			size_t maxNFASize;
 
-		FileNameFilter() {
+			bool topLevelAlt = false; // there is a '|' outside of all groups, so no text is required
+			ds::string run;      // literal chars directly following each other outside of any group
+			ds::string required; // longest run so far, every match has to contain it
+		};
 
+		static void flushRun(RegexParser& p) {
+			if (p.run.size() > p.required.size())
+				p.required = p.run;
+			p.run = ds::string();
 		}
-		FileNameFilter(const char* filter) {
-			size_t len = filter ? strlen(filter) : 0;
 
-			if (len == 0)
-				return;
+		static char unescape(char c) {
+			switch (c) {
+				case 't': return '\t';
+				case 'n': return '\n';
+				case 'r': return '\r';
+				case 'f': return '\f';
+				case 'v': return '\v';
+				default:  return c;
+			}
+		}
 
-			if (filter[0] != '{') {
-				filters.push_back(Filter(filter));
+		// \d \w \s and their negated upper case versions
+		static bool getClassEscape(char c, ByteSet* set, bool* negated) {
+			switch (c) {
+				case 'd': case 'D':
+					set->addRange('0', '9');
+					break;
+				case 'w': case 'W':
+					set->addRange('a', 'z');
+					set->addRange('A', 'Z');
+					set->addRange('0', '9');
+					set->add('_');
+					break;
+				case 's': case 'S':
+					set->add(' ');
+					set->addRange('\t', '\r'); // \t \n \v \f \r
+					break;
+				default:
+					return false;
 			}
-			else {
-				size_t bracketCntr = 0;
+			*negated = c >= 'A' && c <= 'Z';
+			return true;
+		}
 
-				size_t last = 0;
-				for (size_t i = 0; i < len; i++) {
-					if (filter[i] == '{') bracketCntr++;
-					if (filter[i] == '{') bracketCntr--;
-					if (filter[i] == ',' && bracketCntr == 0 && i>last) {
-						filters.push_back(ds::string(filter+last,filter+i));
-						last = i + 1;
+		void addToSet(const RegexParser& p, ByteSet* set, uint8_t from, uint8_t to) {
+			for (int c = from; c <= to; c++) {
+				if (p.caseInsensitive)
+					set->addCaseInsensitive((uint8_t)c);
+				else
+					set->add((uint8_t)c);
+			}
+		}
+
+		Frag regexFail(RegexParser& p) {
+			p.failed = true;
+			return fragEmpty();
+		}
+
+		// "[...]", the '[' was already consumed
+		Frag parseRegexClass(RegexParser& p) {
+			const bool negated = p.c < p.end && *p.c == '^';
+			if (negated)
+				p.c++;
+
+			ByteSet set;
+			bool first = true;
+			while (true) {
+				if (p.c >= p.end)
+					return regexFail(p);
+
+				char c = *p.c++;
+				if (c == ']' && !first)
+					break;
+				first = false;
+
+				if (c == '\\') {
+					if (p.c >= p.end)
+						return regexFail(p);
+					ByteSet escSet;
+					bool escNegated;
+					if (getClassEscape(*p.c, &escSet, &escNegated)) {
+						p.c++;
+						if (escNegated)
+							escSet.invert();
+						set.addAll(escSet);
+						continue;
 					}
+					c = unescape(*p.c++);
 				}
-				if (len-last > 0) {
-					filters.push_back(ds::string(filter+last,filter+len));
+
+				char rangeEnd = c;
+				if (p.c + 1 < p.end && *p.c == '-' && p.c[1] != ']') {
+					p.c++;
+					rangeEnd = *p.c++;
+					if (rangeEnd == '\\') {
+						if (p.c >= p.end)
+							return regexFail(p);
+						rangeEnd = unescape(*p.c++);
+					}
+					if ((uint8_t)rangeEnd < (uint8_t)c)
+						return regexFail(p);
 				}
+				addToSet(p, &set, (uint8_t)c, (uint8_t)rangeEnd);
 			}
+			return negated ? fragNotIn(set) : fragBytes(set);
+		}
 
-			if (filters.size() > 0)
-				filters.push_back(Filter("*.*"));
+		// parses a single char, escape, class or group. literal is set to the char if it's just a plain one
+		Frag parseRegexAtom(RegexParser& p, int depth, int* literal) {
+			*literal = -1;
+			const char c = *p.c++;
+			switch (c) {
+				case '(': {
+					if (depth >= MaxRegexDepth)
+						return regexFail(p);
+					if (p.c + 1 < p.end && p.c[0] == '?' && p.c[1] == ':') // non capturing group, same thing here
+						p.c += 2;
+					Frag frag = parseRegexAlt(p, depth + 1);
+					if (p.failed || p.c >= p.end || *p.c != ')')
+						return regexFail(p);
+					p.c++;
+					return frag;
+				}
+				case '*': case '+': case '?': // nothing to repeat
+					return regexFail(p);
+				case '.':
+					return fragAnyChar();
+				case '^':
+					return fragAssert(NFAState::Type_AssertBegin);
+				case '$':
+					return fragAssert(NFAState::Type_AssertEnd);
+				case '[':
+					return parseRegexClass(p);
+				case '\\': {
+					if (p.c >= p.end)
+						return regexFail(p);
+					const char e = *p.c++;
+					ByteSet set;
+					bool negated;
+					if (getClassEscape(e, &set, &negated))
+						return negated ? fragNotIn(set) : fragBytes(set);
+					if ((e >= 'a' && e <= 'z' && unescape(e) == e) || (e >= 'A' && e <= 'Z') || (e >= '0' && e <= '9'))
+						return regexFail(p); // \b, \1, ... aren't supported, better fail than silently match something else
+					const char lit = unescape(e);
+					*literal = (uint8_t)lit;
+					return fragLiteral(&lit, &lit + 1, p.caseInsensitive);
+				}
+				default:
+					*literal = (uint8_t)c;
+					return fragLiteral(&c, &c + 1, p.caseInsensitive);
+			}
 		}
 
-		bool passes(const char* name, bool isFolder) {
-			if (searchText.size() > 0) {
-				Filter searchFilter(searchText);
-				if (!searchFilter.passes(name))
+		// "*" "+" "?" "{n}" "{n,}" "{n,m}", maxRep is -1 for no limit. returns false if there is none
+		static bool parseRegexQuantifier(RegexParser& p, int* minRep, int* maxRep) {
+			if (p.c >= p.end)
+				return false;
+
+			switch (*p.c) {
+				case '*': *minRep = 0; *maxRep = -1; p.c++; break;
+				case '+': *minRep = 1; *maxRep = -1; p.c++; break;
+				case '?': *minRep = 0; *maxRep =  1; p.c++; break;
+				case '{': {
+					const char* c = p.c + 1;
+					int n = 0, m;
+					if (c >= p.end || *c < '0' || *c > '9')
+						return false; // not a quantifier, '{' is just a literal then
+					while (c < p.end && *c >= '0' && *c <= '9' && n <= MaxRegexRepeat)
+						n = n * 10 + (*c++ - '0');
+					m = n;
+					if (c < p.end && *c == ',') {
+						c++;
+						m = -1;
+						if (c < p.end && *c >= '0' && *c <= '9') {
+							m = 0;
+							while (c < p.end && *c >= '0' && *c <= '9' && m <= MaxRegexRepeat)
+								m = m * 10 + (*c++ - '0');
+						}
+					}
+					if (c >= p.end || *c != '}')
+						return false;
+					if (n > MaxRegexRepeat || m > MaxRegexRepeat || (m != -1 && m < n)) {
+						p.failed = true;
+						return false;
+					}
+					*minRep = n;
+					*maxRep = m;
+					p.c = c + 1;
+					break;
+				}
+				default:
 					return false;
 			}
 
-			if (isFolder)
-				return true;
-			
-			if (filters.size() == 0)
-				return true;
+			if (p.c < p.end && *p.c == '?') // lazy quantifier, doesn't change what matches
+				p.c++;
+			return true;
+		}
 
-			if (!filters[filterSel].passes(name))
-				return false;
+		// every copy of a repeated atom needs its own states, so the atom gets parsed again for each one
+		Frag parseRegexAtomCopy(RegexParser& p, const char* atomStart, int depth) {
+			const char* c = p.c;
+			p.c = atomStart;
+			int literal;
+			Frag frag = parseRegexAtom(p, depth + 1, &literal);
+			p.c = c;
+			return frag;
+		}
 
-			return true;
+		Frag regexRepeat(RegexParser& p, const Frag& atom, const char* atomStart, int depth, int minRep, int maxRep) {
+			if (minRep == 0 && maxRep == -1) return fragStar(atom);
+			if (minRep == 1 && maxRep == -1) return fragPlus(atom);
+			if (minRep == 0 && maxRep == 1)  return fragQuest(atom);
+
+			Frag frag = fragEmpty();
+			bool atomUsed = false;
+			for (int i = 0; i < minRep && !p.failed; i++) {
+				frag = fragConcat(frag, atomUsed ? parseRegexAtomCopy(p, atomStart, depth) : atom);
+				atomUsed = true;
+				if (nfa.size() > p.maxNFASize)
+					return regexFail(p);
+			}
+			if (maxRep == -1) {
+				frag = fragConcat(frag, fragStar(atomUsed ? parseRegexAtomCopy(p, atomStart, depth) : atom));
+			}
+			else {
+				for (int i = minRep; i < maxRep && !p.failed; i++) {
+					frag = fragConcat(frag, fragQuest(atomUsed ? parseRegexAtomCopy(p, atomStart, depth) : atom));
+					atomUsed = true;
+					if (nfa.size() > p.maxNFASize)
+						return regexFail(p);
+				}
+			}
+			return frag;
 		}
 
-		bool draw(float width = -1) {
-			ImGui::PushItemWidth(width);
-			bool ret = utils::InputTextString("##Search", "Search", &searchText);
-			ImGui::PopItemWidth();
-			return ret;
+		Frag parseRegexConcat(RegexParser& p, int depth) {
+			Frag frag = fragEmpty();
+			while (!p.failed && p.c < p.end && *p.c != '|' && *p.c != ')') {
+				const char* atomStart = p.c;
+				int literal;
+				Frag atom = parseRegexAtom(p, depth, &literal);
+				if (p.failed)
+					break;
+
+				int minRep = 1, maxRep = 1;
+				if (parseRegexQuantifier(p, &minRep, &maxRep))
+					atom = regexRepeat(p, atom, atomStart, depth, minRep, maxRep);
+				if (p.failed || nfa.size() > p.maxNFASize)
+					return regexFail(p);
+
+				if (depth == 0) {
+					if (literal != -1 && minRep >= 1)
+						p.run += p.caseInsensitive ? utils::toLowerAscii((char)literal) : (char)literal;
+					if (literal == -1 || minRep != 1 || maxRep != 1) // an optional or repeated literal breaks the run
+						flushRun(p);
+				}
+
+				frag = fragConcat(frag, atom);
+			}
+			if (depth == 0)
+				flushRun(p);
+			return frag;
+		}
+
+		Frag parseRegexAlt(RegexParser& p, int depth) {
+			Frag frag = parseRegexConcat(p, depth);
+			while (!p.failed && p.c < p.end && *p.c == '|') {
+				p.c++;
+				if (depth == 0)
+					p.topLevelAlt = true;
+				frag = fragAlt(frag, parseRegexConcat(p, depth));
+			}
+			return frag;
 		}
-	};
 
-	class FileDataCache {
-	private:
-		ds::set<ImGuiID> loaded;
 	public:
-		static RequestFileDataCallback requestFileDataCallB;
-		static FreeFileDataCallback freeFileDataCallB;
+		enum : size_t { InvalidPattern = (size_t)-1 };
 
-		~FileDataCache() {
-			clear();
+		size_t numPatterns() const {
+			return starts.size();
+		}
+		bool isFull() const {
+			return starts.size() >= MaxPatterns;
+		}
+		uint64_t allPatternsMask() const {
+			return starts.size() >= 64 ? ~(uint64_t)0 : (((uint64_t)1 << starts.size()) - 1);
 		}
 
-		FileData* get(const DirEntry& entry) {
-			if(!requestFileDataCallB)
-				return 0;
+		// '*' matches any chars, '?' exactly one char, "[...]" one of the chars inside ("a-z" ranges, '!' or '^' at the start to invert), '\' escapes
+		size_t addGlob(const char* glob, const char* globEnd, bool caseInsensitive = false) {
+			Frag frag = fragEmpty();
+			const char* c = glob;
+			while (c < globEnd) {
+				switch (*c) {
+					case '*':
+						while (c < globEnd && *c == '*')
+							c++;
+						frag = fragConcat(frag, fragAnyString());
+						continue;
+					case '?':
+						frag = fragConcat(frag, fragAnyChar());
+						break;
+					case '[': {
+						const char* classEnd = c + 1;
+						if (classEnd < globEnd && (*classEnd == '!' || *classEnd == '^'))
+							classEnd++;
+						if (classEnd < globEnd && *classEnd == ']') // ']' right at the start is a literal
+							classEnd++;
+						while (classEnd < globEnd && *classEnd != ']')
+							classEnd++;
+						if (classEnd >= globEnd) { // no closing bracket => literal '['
+							frag = fragConcat(frag, fragLiteral(c, c + 1, caseInsensitive));
+							break;
+						}
 
-			if(!loaded.contains(entry.id))
-				loaded.add(entry.id);
+						const char* s = c + 1;
+						const bool inverted = *s == '!' || *s == '^';
+						if (inverted)
+							s++;
 
-			return requestFileDataCallB(entry, 300);
+						ByteSet set;
+						for (; s < classEnd; s++) {
+							if (s + 2 < classEnd && s[1] == '-') {
+								for (int ch = (uint8_t)s[0]; ch <= (uint8_t)s[2]; ch++) {
+									if (caseInsensitive) set.addCaseInsensitive((uint8_t)ch); else set.add((uint8_t)ch);
+								}
+								s += 2;
+							}
+							else {
+								if (caseInsensitive) set.addCaseInsensitive((uint8_t)*s); else set.add((uint8_t)*s);
+							}
+						}
+						frag = fragConcat(frag, inverted ? fragNotIn(set) : fragBytes(set));
+						c = classEnd;
+						break;
+					}
+					case '\\':
+						if (c + 1 < globEnd)
+							c++;
+						// fall through
+					default:
+						frag = fragConcat(frag, fragLiteral(c, c + 1, caseInsensitive));
+						break;
+				}
+				c++;
+			}
+			return finishPattern(frag);
 		}
 
-		void clear() {
-			if(!freeFileDataCallB)
-				return;
+		// matches if str contains literal
+		size_t addSubstring(const char* literal, const char* literalEnd, bool caseInsensitive = false) {
+			Frag frag = fragConcat(fragAnyString(), fragLiteral(literal, literalEnd, caseInsensitive));
+			return finishPattern(fragConcat(frag, fragAnyString()));
+		}
 
-			for (auto& l : loaded) {
-				freeFileDataCallB(l);
+		// matches if str is exactly literal
+		size_t addExact(const char* literal, const char* literalEnd, bool caseInsensitive = false) {
+			return finishPattern(fragLiteral(literal, literalEnd, caseInsensitive));
+		}
+
+		// regular expression, matching anywhere in str unless anchored with '^' or '$'. supports
+		// . [...] [^...] \d \w \s \D \W \S ( ) (?: ) | * + ? {n} {n,} {n,m} and '\' escapes, classes are byte based like in globs.
+		// returns InvalidPattern if re can't be parsed. requiredText (optional) is set to a text every match contains (empty if there is none)
+		size_t addRegex(const char* re, const char* reEnd, bool caseInsensitive = false, ds::string* requiredText = NULL) {
+			const size_t nfaSizeBefore = nfa.size();
+			const size_t byteSetsSizeBefore = byteSets.size();
+
+			RegexParser p;
+			p.c = re;
+			p.end = reEnd;
+			p.caseInsensitive = caseInsensitive;
+			p.maxNFASize = nfaSizeBefore + MaxRegexStates;
+
+			Frag frag = parseRegexAlt(p, 0);
+			if (p.failed || p.c != p.end) { // p.c != p.end => unmatched ')'
+				nfa.resize(nfaSizeBefore);
+				byteSets.resize(byteSetsSizeBefore);
+				return InvalidPattern;
 			}
-			loaded.clear();
+
+			// with a '^' at the start (or '$' at the end) there is no need to try every other position
+			const bool anchoredStart = !p.topLevelAlt && re < reEnd && *re == '^';
+			size_t numBackslashes = 0;
+			for (const char* c = reEnd - 1; c > re && *(c - 1) == '\\'; c--)
+				numBackslashes++;
+			const bool anchoredEnd = !p.topLevelAlt && reEnd > re && *(reEnd - 1) == '$' && numBackslashes % 2 == 0;
+
+			if (!anchoredStart)
+				frag = fragConcat(fragAnyString(), frag);
+			if (!anchoredEnd)
+				frag = fragConcat(frag, fragAnyString());
+
+			if (requiredText)
+				*requiredText = p.topLevelAlt ? ds::string() : p.required;
+
+			return finishPattern(frag);
 		}
 
-		uint64_t maxSize() const {
-			return 0;
+		// returns a bitmask of all patterns that match str
+		uint64_t match(const char* str, const char* strEnd = NULL) {
+			if (starts.size() == 0)
+				return 0;
+			if (strEnd == NULL)
+				strEnd = str + strlen(str);
+
+			int32_t state = getStartState();
+			const uint8_t* c = (const uint8_t*)str;
+			const uint8_t* end = (const uint8_t*)strEnd;
+			while (c < end) {
+				const int32_t* trans = &dfaTrans[0] + (size_t)state * 256;
+				// hot loop: follow already computed transitions
+				while (c < end && trans[*c] >= 0) {
+					state = trans[*c++];
+					trans = &dfaTrans[0] + (size_t)state * 256;
+				}
+				if (c == end)
+					break;
+				if (trans[*c] == DFA_Dead)
+					return 0;
+
+				state = computeTransition(state, *c++);
+				if (dfa[state].setLen == 0)
+					return 0;
+			}
+			return dfa[state].accepts;
 		}
-		uint64_t size() const {
-			return 0;
+
+		size_t numDFAStates() const {
+			return dfa.size();
 		}
 	};
-	
-	class FileDialog {
+
+	// a condition on the size, dates or type of an entry, written as "field:value" into the search bar:
+	//   size:>1G  size:<=10k  size:1M..5M           sizes in bytes, with an optional K, M, G or T (1024 based)
+	//   modified:<7d  created:>1y  modified:1d..2w  ages in h, d, w, m(onths) or y. "<7d" means less than 7 days ago, so does "7d"
+	//   modified:2026-10  created:>=2026-01-15      local dates as YYYY, YYYY-MM or YYYY-MM-DD
+	//   type:dir  type:file
+	class MetaPredicate {
 	public:
-		ds::string str_id;
-		ImGuiID id;
-		
-		ds::string path;
-		EditablePath currentPath;
-		ds::string oldPath;
-		ds::string couldntLoadPath;
+		enum Field {
+			Field_Size = 0,
+			Field_Modified,
+			Field_Created,
+			Field_Type
+		};
+		Field field = Field_Size;
+		// passes if lo <= value <= hi. values are sizes or unix times, for Field_Type 1 for folders and 0 for files.
+		// lo is never negative, so unknown values (-1) never pass
+		int64_t lo = 0;
+		int64_t hi = 0;
+
+		bool passes(int64_t value) const {
+			return value >= lo && value <= hi;
+		}
+		static int64_t getValue(const DirEntry& entry, Field field) {
+			switch (field) {
+			case Field_Size:     return entry.size == (uint64_t)-1 ? -1 : (int64_t)entry.size;
+			case Field_Modified: return (int64_t)entry.lastModified;
+			case Field_Created:  return (int64_t)entry.creationDate;
+			case Field_Type:     return entry.isFolder ? 1 : 0;
+			}
+			return -1;
+		}
 
-		bool forceDisplayAllDirs = false;
+		// returns false if str doesn't start with a known "field:", otherwise *valid is set to whether the value could be parsed
+		static bool parse(const char* str, const char* strEnd, time_t now, MetaPredicate* out, bool* valid) {
+			static const struct { const char* name; Field field; } fieldNames[] = {
+				{ "size:", Field_Size }, { "modified:", Field_Modified }, { "created:", Field_Created }, { "type:", Field_Type }
+			};
 
-		bool isEditingPath = false;
-		ds::string editOnPathStr;
-		ds::OverrideStack<ds::string> undoStack;
-		ds::OverrideStack<ds::string> redoStack;
-		
-		class EntryManager {
-			ds::vector<DirEntry> data;
-			ds::vector<size_t> dataModed;
+			const char* value = NULL;
+			for (size_t i = 0; i < sizeof(fieldNames) / sizeof(fieldNames[0]); i++) {
+				const size_t len = strlen(fieldNames[i].name);
+				if ((size_t)(strEnd - str) >= len && memcmp(str, fieldNames[i].name, len) == 0) {
+					out->field = fieldNames[i].field;
+					value = str + len;
+					break;
+				}
+			}
+			if (!value)
+				return false;
+
+			*valid = out->parseValue(value, strEnd, now);
+			return true;
+		}
+	private:
+		// the values one operand stands for, e.g. all times of a day for "2026-10-19"
+		struct Interval {
+			int64_t lo;
+			int64_t hi;
+			bool isAge; // "<" means bigger times for ages
+		};
+
+		static bool parseNumber(const char** c, const char* end, double* out) {
+			const char* start = *c;
+			size_t numDigits = 0;
+			double num = 0;
+			while (*c < end && **c >= '0' && **c <= '9') {
+				num = num * 10 + (*(*c)++ - '0');
+				numDigits++;
+			}
+			if (*c < end && **c == '.') {
+				(*c)++;
+				double scale = 0.1;
+				while (*c < end && **c >= '0' && **c <= '9') {
+					num += (*(*c)++ - '0') * scale;
+					scale *= 0.1;
+					numDigits++;
+				}
+			}
+			*out = num;
+			return numDigits > 0 && *c > start;
+		}
+		static bool parseDigits(const char** c, const char* end, size_t minLen, size_t maxLen, int* out) {
+			const char* start = *c;
+			int num = 0;
+			while (*c < end && (size_t)(*c - start) < maxLen && **c >= '0' && **c <= '9')
+				num = num * 10 + (*(*c)++ - '0');
+			*out = num;
+			return (size_t)(*c - start) >= minLen;
+		}
+
+		static bool parseSize(const char* c, const char* end, Interval* out) {
+			double num;
+			if (!parseNumber(&c, end, &num))
+				return false;
+
+			double unit = 1;
+			if (c < end) {
+				switch (utils::toLowerAscii(*c)) {
+					case 'k': unit = 1024.0; break;
+					case 'm': unit = 1024.0 * 1024; break;
+					case 'g': unit = 1024.0 * 1024 * 1024; break;
+					case 't': unit = 1024.0 * 1024 * 1024 * 1024; break;
+				}
+				if (unit != 1) {
+					c++;
+					if (c < end && utils::toLowerAscii(*c) == 'i') // KiB
+						c++;
+				}
+				if (c < end && utils::toLowerAscii(*c) == 'b')
+					c++;
+			}
+			if (c != end || num * unit > 9e18)
+				return false;
+
+			out->lo = out->hi = (int64_t)(num * unit + 0.5);
+			out->isAge = false;
+			return true;
+		}
+
+		// YYYY, YYYY-MM or YYYY-MM-DD => the whole year, month or day in local time
+		static bool parseDate(const char* c, const char* end, Interval* out) {
+			int year, month = 1, day = 1;
+			if (!parseDigits(&c, end, 4, 4, &year))
+				return false;
+
+			int numParts = 1;
+			if (c < end) {
+				if (*c++ != '-' || !parseDigits(&c, end, 1, 2, &month) || month < 1 || month > 12)
+					return false;
+				numParts++;
+			}
+			if (c < end) {
+				if (*c++ != '-' || !parseDigits(&c, end, 1, 2, &day) || day < 1 || day > 31)
+					return false;
+				numParts++;
+			}
+			if (c != end)
+				return false;
+
+			tm start;
+			memset(&start, 0, sizeof(start));
+			start.tm_year = year - 1900;
+			start.tm_mon = month - 1;
+			start.tm_mday = day;
+			start.tm_isdst = -1;
+
+			tm next = start; // mktime() takes care of overflowing months and days
+			if (numParts == 1)
+				next.tm_year++;
+			else if (numParts == 2)
+				next.tm_mon++;
+			else
+				next.tm_mday++;
+
+			const time_t startTime = mktime(&start);
+			const time_t nextTime = mktime(&next);
+			if (startTime == (time_t)-1 || nextTime == (time_t)-1 || start.tm_mday != day) // e.g. 2026-02-30
+				return false;
+
+			out->lo = (int64_t)startTime;
+			out->hi = (int64_t)nextTime - 1;
+			out->isAge = false;
+			return true;
+		}
+
+		// number followed by h, d, w, m or y => the time that long ago
+		static bool parseAge(const char* c, const char* end, time_t now, Interval* out) {
+			double num;
+			if (!parseNumber(&c, end, &num) || end - c != 1)
+				return false;
+
+			double unit;
+			switch (utils::toLowerAscii(*c)) {
+				case 'h': unit = 60.0 * 60; break;
+				case 'd': unit = 60.0 * 60 * 24; break;
+				case 'w': unit = 60.0 * 60 * 24 * 7; break;
+				case 'm': unit = 60.0 * 60 * 24 * 30; break;
+				case 'y': unit = 60.0 * 60 * 24 * 365; break;
+				default: return false;
+			}
+			if (num * unit > 1e15)
+				return false;
+
+			out->lo = out->hi = (int64_t)now - (int64_t)(num * unit + 0.5);
+			out->isAge = true;
+			return true;
+		}
+
+		bool parseOperand(const char* c, const char* end, time_t now, Interval* out) const {
+			if (field == Field_Size)
+				return parseSize(c, end, out);
+			return parseDate(c, end, out) || parseAge(c, end, now, out);
+		}
+
+		bool parseValue(const char* c, const char* end, time_t now) {
+			if (field == Field_Type) {
+				const ds::string value(c, end);
+				if (value == "dir" || value == "folder") {
+					lo = hi = 1;
+					return true;
+				}
+				if (value == "file") {
+					lo = hi = 0;
+					return true;
+				}
+				return false;
+			}
+
+			enum { Op_None, Op_Less, Op_LessEq, Op_Greater, Op_GreaterEq } op = Op_None;
+			if (end - c >= 2 && c[1] == '=' && (c[0] == '<' || c[0] == '>')) {
+				op = c[0] == '<' ? Op_LessEq : Op_GreaterEq;
+				c += 2;
+			}
+			else if (c < end && (*c == '<' || *c == '>' || *c == '=')) {
+				op = *c == '<' ? Op_Less : *c == '>' ? Op_Greater : Op_None;
+				c++;
+			}
+
+			Interval val;
+			const char* rangeSep = NULL;
+			for (const char* s = c; s + 1 < end; s++) {
+				if (s[0] == '.' && s[1] == '.') {
+					rangeSep = s;
+					break;
+				}
+			}
+			if (rangeSep) { // "a..b", everything between and including both
+				Interval b;
+				if (op != Op_None || !parseOperand(c, rangeSep, now, &val) || !parseOperand(rangeSep + 2, end, now, &b))
+					return false;
+				val.lo = ImMin(val.lo, b.lo);
+				val.hi = ImMax(val.hi, b.hi);
+			}
+			else {
+				if (!parseOperand(c, end, now, &val))
+					return false;
+
+				if (val.isAge) { // older means smaller times
+					switch (op) {
+						case Op_None:      op = Op_GreaterEq; break; // "7d" is "<=7d"
+						case Op_Less:      op = Op_Greater;   break;
+						case Op_LessEq:    op = Op_GreaterEq; break;
+						case Op_Greater:   op = Op_Less;      break;
+						case Op_GreaterEq: op = Op_LessEq;    break;
+					}
+				}
+			}
+
+			switch (op) {
+				case Op_None:      lo = val.lo;     hi = val.hi;     break;
+				case Op_Less:      lo = 0;          hi = val.lo - 1; break;
+				case Op_LessEq:    lo = 0;          hi = val.hi;     break;
+				case Op_Greater:   lo = val.hi + 1; hi = INT64_MAX;  break;
+				case Op_GreaterEq: lo = val.lo;     hi = INT64_MAX;  break;
+			}
+			lo = ImMax(lo, (int64_t)0);
+			return true;
+		}
+	};
+
+	class FileNameFilter {
+	private:
+		class Filter {
+			// all patterns of this filter, every Automaton holds up to Automaton::MaxPatterns of them
+			ds::vector<Automaton> automata;
+			ds::vector<uint64_t> negated; // per automaton: patterns that must *not* match for the filter to pass
+			size_t numPatterns = 0;
+			bool matchesAll = false;
+			bool caseInsensitive = false; // if set, names are expected to be lower case already
+			bool isSearch = false; // the search bar, not a filter group
+
+			ds::string substring; // set if the filter is only a single plain text (lower case if caseInsensitive)
+			ds::string required;  // every name that passes contains this text (lower case if caseInsensitive), only set for regexes
+			ds::stringset extensions; // "*.ext" patterns are just looked up in here instead of going through the automaton
+			bool regex = false;
+			bool invalid = false; // the regex couldn't be parsed, nothing passes
+
+			Automaton& getAutomaton() {
+				if (automata.size() == 0 || automata.back().isFull()) {
+					automata.push_back(Automaton());
+					negated.push_back(0);
+				}
+				return automata.back();
+			}
+
+			static bool isGlob(const char* str, const char* strEnd) {
+				for (const char* c = str; c < strEnd; c++) {
+					if (*c == '*' || *c == '?' || *c == '[')
+						return true;
+				}
+				return false;
+			}
+			// returns the extension if str is "*.ext" (and ext has no further dots or wildcards), otherwise NULL
+			static const char* getOnlyExtension(const char* str, const char* strEnd) {
+				if (strEnd - str < 3 || str[0] != '*' || str[1] != '.')
+					return NULL;
+				for (const char* c = str + 2; c < strEnd; c++) {
+					if (*c == '.' || *c == '*' || *c == '?' || *c == '[' || *c == '\\')
+						return NULL;
+				}
+				return str + 2;
+			}
+			// e.g. "*", "*.*" or "."
+			static bool isCatchAll(const char* str, const char* strEnd) {
+				for (const char* c = str; c < strEnd; c++) {
+					if (*c != '*' && *c != '.')
+						return false;
+				}
+				return true;
+			}
+
+			/*
+				"=name"   name has to match exactly
+				"!pat"    pat must not match (the patterns are or'ed, so other patterns can still let the name pass)
+				"*.txt"   glob (see Automaton::addGlob()), has to match the whole name
+				"name"    has to match the whole name as well, in the search bar name has to contain text
+				"Label:pat" the label is ignored
+			*/
+			void addPattern(const char* str, const char* strEnd) {
+				{
+					const char* colPos = (const char*)memchr(str, ':', strEnd - str);
+					if (colPos != nullptr)
+						str = colPos + 1;
+				}
+
+				while (str < strEnd && *str == ' ')
+					str++;
+				while (strEnd > str && *(strEnd-1) == ' ')
+					strEnd--;
+
+				if (str == strEnd)
+					return;
+
+				numPatterns++;
+
+				if (*str == '=') {
+					getAutomaton().addExact(str + 1, strEnd);
+					return;
+				}
+
+				const bool isNegated = *str == '!';
+				if (isNegated)
+					str++;
+
+				if (isCatchAll(str, strEnd)) {
+					if (!isNegated)
+						matchesAll = true;
+					return;
+				}
+
+				if (!isNegated && !caseInsensitive) {
+					const char* ext = getOnlyExtension(str, strEnd);
+					if (ext) {
+						extensions.add(ext, strEnd - ext);
+						return;
+					}
+				}
+
+				Automaton& automaton = getAutomaton();
+				size_t patternInd;
+				if (isGlob(str, strEnd)) {
+					patternInd = automaton.addGlob(str, strEnd, caseInsensitive);
+				}
+				else if (!isSearch) {
+					patternInd = automaton.addExact(str, strEnd);
+				}
+				else {
+					patternInd = automaton.addSubstring(str, strEnd, caseInsensitive);
+					if (numPatterns == 1 && !isNegated) {
+						substring = ds::string(str, strEnd);
+						if (caseInsensitive) {
+							for (size_t i = 0; i < substring.size(); i++)
+								substring[i] = utils::toLowerAscii(substring[i]);
+						}
+					}
+				}
+
+				if (isNegated)
+					negated.back() |= (uint64_t)1 << patternInd;
+			}
+		public:
+			ds::string rawStr;
+			
+			// if isSearch is set, "re:" followed by a regex (see Automaton::addRegex()) can be used instead of the comma separated patterns
+			Filter(const ds::string& cmd, bool caseInsensitive = false, bool isSearch = false) : caseInsensitive(caseInsensitive), isSearch(isSearch), rawStr(cmd) {
+				if (isSearch && cmd.size() >= 3 && memcmp(cmd.c_str(), "re:", 3) == 0) {
+					regex = true;
+					if (cmd.size() == 3)
+						return;
+
+					numPatterns = 1;
+					if (getAutomaton().addRegex(cmd.c_str() + 3, cmd.c_str() + cmd.size(), caseInsensitive, &required) == Automaton::InvalidPattern)
+						invalid = true;
+					return;
+				}
+
+				size_t last = 0;
+				for (size_t i = 0; i < cmd.size(); i++) {
+					if (cmd[i] == ',') {
+						addPattern(cmd.c_str() + last, cmd.c_str() + i);
+						last = i + 1;
+					}
+				}
+				addPattern(cmd.c_str() + last, cmd.c_str() + cmd.size());
+
+				if (numPatterns != 1 || matchesAll)
+					substring = ds::string();
+			}
+
+			bool isEmpty() const {
+				return numPatterns == 0 || matchesAll;
+			}
+
+			// returns the text if the filter just checks if names contain a plain text, otherwise NULL
+			const ds::string* getSubstring() const {
+				return substring.size() > 0 ? &substring : NULL;
+			}
+			// returns a text that every name passing contains (but not every name containing it passes), or NULL
+			const ds::string* getRequired() const {
+				return required.size() > 0 ? &required : NULL;
+			}
+
+			bool isRegex() const {
+				return regex;
+			}
+			bool isInvalid() const {
+				return invalid;
+			}
+
+			// passes if any of the patterns match. ext is the part after the last '.' of name (NULL if there is none)
+			bool passes(const char* name, const char* nameEnd, const char* ext) {
+				if (numPatterns == 0 || matchesAll)
+					return true;
+
+				if (ext && extensions.size() > 0) {
+					if (!nameEnd)
+						nameEnd = ext + strlen(ext);
+					if (extensions.contains(ext, nameEnd - ext))
+						return true;
+				}
+
+				for (size_t i = 0; i < automata.size(); i++) {
+					const uint64_t matched = automata[i].match(name, nameEnd);
+					const uint64_t positive = automata[i].allPatternsMask() & ~negated[i];
+					if ((matched & positive) != 0 || (~matched & negated[i]) != 0)
+						return true;
+				}
+				return false;
+			}
+
+		};
+
+		Filter search = Filter("");
+		ds::string searchSrc; // searchText that search was built from
+		ds::string searchName; // searchText without the predicates, what search was built from
+		ds::vector<MetaPredicate> predicates;
+		bool predicatesInvalid = false; // one of the "field:value" words couldn't be parsed
+		ds::string contentText; // lower case text of a "contains:text" word, files have to contain it (see ContentSearch)
+	public:
+		ds::string searchText;
+		size_t filterSel = 0; // currently selected filter
+		ds::vector<Filter> filters;
+		const FilterDesc* desc = NULL; // used instead of filters if set
+
+		FileNameFilter() {
+
+		}
+		FileNameFilter(const FilterDesc* desc) : desc(desc) {
+
+		}
+		FileNameFilter(const char* filter) {
+			size_t len = filter ? strlen(filter) : 0;
+
+			if (len == 0)
+				return;
+
+			if (filter[0] != '{') {
+				filters.push_back(Filter(filter));
+			}
+			else {
+				size_t bracketCntr = 0;
+
+				size_t last = 0;
+				for (size_t i = 0; i < len; i++) {
+					if (filter[i] == '{') {
+						if (bracketCntr == 0)
+							last = i + 1;
+						bracketCntr++;
+					}
+					if (filter[i] == '}' && bracketCntr > 0) {
+						bracketCntr--;
+						if (bracketCntr == 0)
+							filters.push_back(ds::string(filter + last, filter + i));
+					}
+				}
+			}
+
+			if (filters.size() > 0)
+				filters.push_back(Filter("*.*"));
+		}
+
+		// needs to be called after searchText was changed, returns true if the search changed
+		bool updateSearch() {
+			if (searchSrc == searchText)
+				return false;
+			searchSrc = searchText;
+
+			// words like "size:>1G" are predicates (see MetaPredicate), everything else is matched against the names
+			predicates.clear();
+			predicatesInvalid = false;
+			contentText = "";
+			bool hasContentWord = false;
+			ds::string rest;
+			const time_t now = time(NULL);
+			size_t wordStart = 0;
+			bool insideQuote = false; // spaces between quotes don't split words, for contains:"two words"
+			for (size_t i = 0; i <= searchText.size(); i++) {
+				if (i < searchText.size() && searchText[i] == '"')
+					insideQuote = !insideQuote;
+				if (i < searchText.size() && (searchText[i] != ' ' || insideQuote))
+					continue;
+
+				if (i > wordStart) {
+					const char* word = searchText.c_str() + wordStart;
+					const char* wordEnd = searchText.c_str() + i;
+					MetaPredicate pred;
+					bool valid;
+					static const char contentPrefix[] = "contains:";
+					const size_t contentPrefixLen = sizeof(contentPrefix) - 1;
+					if ((size_t)(wordEnd - word) >= contentPrefixLen && memcmp(word, contentPrefix, contentPrefixLen) == 0) {
+						const char* text = word + contentPrefixLen;
+						const char* textEnd = wordEnd;
+						if (textEnd - text >= 2 && *text == '"' && textEnd[-1] == '"') {
+							text++;
+							textEnd--;
+						}
+						contentText = ds::string(text, textEnd);
+						for (size_t c = 0; c < contentText.size(); c++)
+							contentText[c] = utils::toLowerAscii(contentText[c]);
+						hasContentWord = true;
+					}
+					else if (MetaPredicate::parse(word, wordEnd, now, &pred, &valid)) {
+						if (valid)
+							predicates.push_back(pred);
+						else
+							predicatesInvalid = true;
+					}
+					else {
+						if (rest.size() > 0)
+							rest += ' ';
+						rest += ds::string(word, searchText.c_str() + i);
+					}
+				}
+				wordStart = i + 1;
+			}
+			// without any predicates the text is kept as is, including all of its spaces
+			searchName = predicates.size() > 0 || predicatesInvalid || hasContentWord ? rest : searchText;
+
+			// the automaton ignores the ASCII case itself, folding the rest makes the search match the folded names
+			ds::vector<char> folded;
+			unicode::appendKey(searchName.c_str(), searchName.c_str() + searchName.size(), &folded, true);
+			search = Filter(folded.size() > 0 ? ds::string(folded.begin(), folded.end()) : ds::string(), true, true);
+			return true;
+		}
+
+		bool hasSearch() const {
+			return !search.isEmpty();
+		}
+		// the search text without the predicates
+		const ds::string& getSearchName() const {
+			return searchName;
+		}
+		const ds::vector<MetaPredicate>& getPredicates() const {
+			return predicates;
+		}
+		// lower case text of the "contains:" word, empty if there is none
+		const ds::string& getContentText() const {
+			return contentText;
+		}
+		// the search is case insensitive, so this is matched against the folded name (see unicode::appendKey())
+		bool passesSearch(const char* foldedName, const char* foldedNameEnd) {
+			return search.passes(foldedName, foldedNameEnd, NULL);
+		}
+		// lower case text if the search is just a plain text, otherwise NULL
+		const ds::string* getSearchSubstring() const {
+			return search.getSubstring();
+		}
+		// lower case text every name matching the search contains, otherwise NULL. names containing it still have to be checked with passesSearch()
+		const ds::string* getSearchRequired() const {
+			return search.getRequired();
+		}
+		// the search text starts with "re:"
+		bool isRegexSearch() const {
+			return search.isRegex();
+		}
+
+		// only checks the currently selected filter, ignoring the search text
+		// ext is the part of name after the last '.' (NULL if there is none), see utils::getExtension()
+		bool passesFilter(const char* name, bool isFolder, const char* ext) {
+			return passesGroup(name, isFolder, ext, filterSel);
+		}
+		// nameEnd is optional
+		bool passesGroup(const char* name, bool isFolder, const char* ext, size_t group, const char* nameEnd = NULL) {
+			if (isFolder)
+				return true;
+
+			if (desc)
+				return desc->passes(name, nameEnd ? nameEnd : name + strlen(name), group);
+			
+			if (filters.size() == 0)
+				return true;
+
+			if (!filters[group].passes(name, nameEnd, ext))
+				return false;
+
+			return true;
+		}
+
+		// checks the selected filter, the search text and the predicates. foldedName is just space to fold the name in
+		bool passesEntry(const DirEntry& entry, ds::vector<char>* foldedName) {
+			if (!passesFilter(entry.name, entry.isFolder, utils::getExtension(entry.name)))
+				return false;
+
+			foldedName->clear();
+			unicode::appendKey(entry.name, entry.name + strlen(entry.name), foldedName);
+			if (!passesSearch(foldedName->data(), foldedName->data() + foldedName->size()))
+				return false;
+
+			for (size_t p = 0; p < predicates.size(); p++) {
+				if (!predicates[p].passes(MetaPredicate::getValue(entry, predicates[p].field)))
+					return false;
+			}
+			return true;
+		}
+
+		size_t getNumGroups() const {
+			return desc ? desc->numGroups : filters.size();
+		}
+		const char* getGroupLabel(size_t group) const {
+			return desc ? desc->groupLabels[group] : filters[group].rawStr.c_str();
+		}
+
+		bool draw(float width = -1) {
+			const bool invalid = search.isInvalid() || predicatesInvalid;
+			if (invalid)
+				ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1, .35f, .35f, 1));
+
+			ImGui::PushItemWidth(width);
+			bool ret = utils::InputTextString("##Search", "Search (re: regex, size:>1M, modified:<7d, type:dir, contains:text)", &searchText);
+			ImGui::PopItemWidth();
+
+			if (invalid) {
+				ImGui::PopStyleColor();
+				if (ImGui::IsItemHovered())
+					ImGui::SetTooltip(predicatesInvalid ? "Invalid size:, modified:, created: or type: value" : "Invalid regex");
+			}
+			return ret;
+		}
+	};
+
+	// matches the pattern as a subsequence of a name (e.g. "fdint" matches "ImGuiFD_internal.h")
+	// and scores how good that match is, so results can be ranked
+	class FuzzyMatcher {
+	private:
+		ds::string pattern;      // lower case if not caseSensitive
+		ds::string patternRaw;
+		uint64_t patternMask = 0;
+		bool caseSensitive = false; // smart case: only match case sensitive if the pattern contains upper case chars
+
+		enum {
+			Score_Match = 16,
+			Score_GapStart = -3,
+			Score_GapExtension = -1,
+
+			Bonus_Boundary = 8,
+			Bonus_CamelCase = 7,
+			Bonus_Consecutive = 4,
+			Bonus_FirstCharMultiplier = 2,
+			Bonus_CaseMatch = 1
+		};
+
+		static bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+		static bool isLower(char c) { return c >= 'a' && c <= 'z'; }
+		static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+		static char toLower(char c) { return isUpper(c) ? c + ('a' - 'A') : c; }
+		static bool isSeparator(char c) {
+			return c == '_' || c == '-' || c == '.' || c == ' ' || c == '/' || c == '\\';
+		}
+
+		static uint64_t charBit(char c) {
+			const unsigned char u = (unsigned char)toLower(c);
+			if (u >= 'a' && u <= 'z')
+				return (uint64_t)1 << (u - 'a');
+			if (u >= '0' && u <= '9')
+				return (uint64_t)1 << (26 + u - '0');
+			return (uint64_t)1 << (36 + u % 28); // everything else shares the remaining 28 bits
+		}
+
+		// bonus for matching the char at str[i], depending on where it is inside the name
+		static int charBonus(const char* str, size_t i) {
+			if (i == 0)
+				return Bonus_Boundary;
+
+			const char prev = str[i-1];
+			const char c = str[i];
+			if (isSeparator(prev))
+				return Bonus_Boundary;
+			if (isLower(prev) && isUpper(c))
+				return Bonus_CamelCase;
+			if (!isDigit(prev) && isDigit(c))
+				return Bonus_CamelCase;
+			return 0;
+		}
+
+		bool charEq(size_t patternInd, char c) const {
+			return pattern[patternInd] == (caseSensitive ? c : toLower(c));
+		}
+	public:
+		static constexpr int NoMatch = -1;
+
+		// bitmask of all chars in str (case folded); if a name doesn't have all the bits of the pattern it can't match
+		static uint64_t charMask(const char* str) {
+			uint64_t mask = 0;
+			for (; *str; str++)
+				mask |= charBit(*str);
+			return mask;
+		}
+
+		void setPattern(const char* str) {
+			patternRaw = str;
+			pattern = str;
+			patternMask = charMask(str);
+
+			caseSensitive = false;
+			for (size_t i = 0; i < pattern.size(); i++) {
+				if (isUpper(pattern[i]))
+					caseSensitive = true;
+			}
+			if (!caseSensitive) {
+				for (size_t i = 0; i < pattern.size(); i++)
+					pattern[i] = toLower(pattern[i]);
+			}
+		}
+
+		bool empty() const {
+			return pattern.size() == 0;
+		}
+
+		bool mayMatch(uint64_t nameMask) const {
+			return (nameMask & patternMask) == patternMask;
+		}
+
+		// returns NoMatch if str doesn't contain the pattern as a subsequence, otherwise a score >= 0 (higher is better)
+		int score(const char* str) const {
+			const size_t patternLen = pattern.size();
+			if (patternLen == 0)
+				return 0;
+
+			// forward pass: find the end of the first occurrence
+			size_t patternInd = 0;
+			size_t end = 0;
+			for (; str[end]; end++) {
+				if (charEq(patternInd, str[end]) && ++patternInd == patternLen)
+					break;
+			}
+			if (patternInd < patternLen)
+				return NoMatch;
+			end++;
+
+			// backward pass: move the start as close to the end as possible to get the tightest match
+			size_t start = end;
+			while (patternInd > 0) {
+				start--;
+				if (charEq(patternInd-1, str[start]))
+					patternInd--;
+			}
+
+			int score = 0;
+			int prevBonus = 0;
+			bool prevMatched = false;
+			bool inGap = false;
+			for (size_t i = start; i < end; i++) {
+				if (patternInd < patternLen && charEq(patternInd, str[i])) {
+					int bonus = charBonus(str, i);
+					if (prevMatched) // consecutive chars keep the bonus of the chunk they started in
+						bonus = ImMax(bonus, ImMax(prevBonus, (int)Bonus_Consecutive));
+					if (patternInd == 0)
+						bonus *= Bonus_FirstCharMultiplier;
+
+					score += Score_Match + bonus;
+					if (patternRaw[patternInd] == str[i])
+						score += Bonus_CaseMatch;
+
+					prevBonus = bonus;
+					prevMatched = true;
+					inGap = false;
+					patternInd++;
+				}
+				else {
+					score += inGap ? Score_GapExtension : Score_GapStart;
+					prevMatched = false;
+					inGap = true;
+				}
+			}
+
+			return score < 0 ? 0 : score;
+		}
+	};
+
+	class FileDataCache {
+	private:
+		enum { MaxDimSize = 300 };
+
+		ds::set<ImGuiID> loaded;
+
+		// with the batch callback: the entries that are visible and their data, sorted by id
+		struct Shown {
+			ImGuiID id;
+			FileData* data;
+			bool seen; // drawn this frame
+		};
+		ds::vector<Shown> shown;
+		ds::vector<FileDataRequest> requests; // entries that became visible this frame
+		ds::vector<ImGuiID> hidden; // entries that aren't visible anymore, reported by the next endFrame()
+
+		struct ShownComparer {
+			const ds::vector<Shown>& shown;
+			int operator()(ImGuiID id, size_t ind) const {
+				return id == shown[ind].id ? 0 : id < shown[ind].id ? -1 : 1;
+			}
+		};
+		size_t findShown(ImGuiID id) const {
+			return ds::binarySearchExclusive(shown.size(), id, ShownComparer{ shown });
+		}
+	public:
+		static RequestFileDataCallback requestFileDataCallB;
+		static FreeFileDataCallback freeFileDataCallB;
+		static FileDataBatchCallback batchCallB;
+
+		~FileDataCache() {
+			clear();
+		}
+
+		// with the batch callback, entries that weren't visible in the last frame get NULL and are requested by endFrame()
+		FileData* get(const DirEntry& entry) {
+			if (batchCallB) {
+				const size_t ind = findShown(entry.id);
+				if (ind != (size_t)-1) {
+					shown[ind].seen = true;
+					return shown[ind].data;
+				}
+				FileDataRequest request;
+				request.entry = &entry;
+				request.maxDimSize = MaxDimSize;
+				request.data = NULL;
+				requests.push_back(request);
+				return NULL;
+			}
+
+			if(!requestFileDataCallB)
+				return 0;
+
+			if(!loaded.contains(entry.id))
+				loaded.add(entry.id);
+
+			return requestFileDataCallB(entry, MaxDimSize);
+		}
+
+		// call once per frame after drawing the entries, the batch callback gets what changed since the last frame (if anything did)
+		void endFrame() {
+			if (!batchCallB)
+				return;
+
+			size_t numKept = 0;
+			for (size_t i = 0; i < shown.size(); i++) {
+				if (shown[i].seen) {
+					shown[numKept] = shown[i];
+					shown[numKept].seen = false;
+					numKept++;
+				}
+				else {
+					hidden.push_back(shown[i].id);
+				}
+			}
+			shown.resize(numKept);
+			if (requests.size() == 0 && hidden.size() == 0)
+				return;
+
+			batchCallB(requests.data(), requests.size(), hidden.data(), hidden.size());
+
+			for (size_t i = 0; i < requests.size(); i++) {
+				Shown s;
+				s.id = requests[i].entry->id;
+				s.data = requests[i].data;
+				s.seen = false;
+				const size_t ind = ds::binarySearchInclusive(shown.size(), s.id, ShownComparer{ shown });
+				if (ind < shown.size() && shown[ind].id == s.id) // drawn twice in one frame
+					continue;
+				shown.insert(shown.begin() + ind, s);
+			}
+			requests.resize(0);
+			hidden.resize(0);
+		}
+
+		// the data of entry id is outdated (e.g. the file changed)
+		void remove(ImGuiID id) {
+			const size_t ind = findShown(id);
+			if (ind != (size_t)-1) { // hidden now and requested again once it is drawn
+				shown.erase(shown.begin() + ind);
+				hidden.push_back(id);
+			}
+
+			if (!loaded.contains(id))
+				return;
+			loaded.eraseItem(id);
+			if (freeFileDataCallB)
+				freeFileDataCallB(id);
+		}
+
+		// the entries are going to be replaced, the entry pointers of the requests of this frame become invalid
+		void clear() {
+			for (size_t i = 0; i < shown.size(); i++)
+				hidden.push_back(shown[i].id);
+			shown.resize(0);
+			requests.resize(0);
+
+			if(!freeFileDataCallB)
+				return;
+
+			for (auto& l : loaded) {
+				freeFileDataCallB(l);
+			}
+			loaded.clear();
+		}
+
+		uint64_t maxSize() const {
+			return 0;
+		}
+		uint64_t size() const {
+			return 0;
+		}
+	};
+
+	// names of everything in the indexed trees and every directory a dialog has listed, for searching "everywhere".
+	// the key of every name (see unicode::appendKey()) is split into trigrams, for each trigram bucket there is a list of the entries containing it.
+	// a search decodes the lists of its trigrams (rarest first) and only checks the few remaining candidates.
+	// the index can be saved to a file, which gets memory mapped on load. changes after that are appended in memory.
+	// with IMGUIFD_ENABLE_THREADS the directories to index are listed by a thread of its own, continueWork() only merges
+	// the listings into the index. without threads continueWork() lists them itself, a few every frame.
+	class NameIndex {
+	public:
+		enum : size_t { NumBuckets = 1 << 18 };
+	private:
+		enum : uint32_t {
+			FolderBit = 0x80000000, // set in the dir index of entries that are folders
+			FileVersion = 2 // 2: trigrams of the folded names instead of the ASCII lower cased ones
+		};
+		enum : size_t {
+			MaxCandidates = 256, // stop intersecting lists once there are less candidates than this
+			CandidateCost = 16,  // checking a candidate costs about as much as decoding this many bytes of a list
+			MinCompact = 1 << 16, // removed entries are dropped once there are at least this many and they are half of the index
+			MaxListed = 256       // the thread waits once this many listings weren't merged yet
+		};
+
+		struct FileHeader {
+			char magic[8];
+			uint32_t version;
+			uint32_t numBuckets;
+			uint64_t numDirs;
+			uint64_t numEntries;
+			uint64_t dirCharsSize;
+			uint64_t namesSize;
+			uint64_t postingsSize;
+		};
+		// offsets of the sections in the file, each one is 8 byte aligned
+		struct FileLayout {
+			uint64_t dirOffs, dirChars, entryDirs, nameOffs, names, bucketOffs, postings, end;
+
+			FileLayout(const FileHeader& h) {
+				dirOffs    = align(sizeof(FileHeader));
+				dirChars   = align(dirOffs    + (h.numDirs + 1) * sizeof(uint64_t));
+				entryDirs  = align(dirChars   + h.dirCharsSize);
+				nameOffs   = align(entryDirs  + h.numEntries * sizeof(uint32_t));
+				names      = align(nameOffs   + (h.numEntries + 1) * sizeof(uint32_t));
+				bucketOffs = align(names      + h.namesSize);
+				postings   = align(bucketOffs + ((uint64_t)NumBuckets + 1) * sizeof(uint64_t));
+				end        = postings + h.postingsSize;
+			}
+			static uint64_t align(uint64_t off) {
+				return (off + 7) & ~(uint64_t)7;
+			}
+		};
+
+		struct Dir {
+			size_t firstEntry = 0;
+			size_t numEntries = 0;
+		};
+		struct PendingDir {
+			ds::string path;
+			bool recursive;
+		};
+		// the entries of a directory, listed by the thread
+		struct Listing {
+			ds::string dir; // same format as utils::fixDirStr()
+			ds::vector<char> names; // back to back, 0 terminated
+			ds::vector<uint8_t> isFolder; // per name
+			bool success = false;
+		};
+
+		// the loaded file (read only), entries [0, numBaseEntries)
+		const void* mapping = NULL;
+		size_t mappingSize = 0;
+		size_t numBaseEntries = 0;
+		const uint32_t* baseEntryDirs = NULL;
+		const uint32_t* baseNameOffs = NULL;
+		const char* baseNames = NULL;
+		const uint64_t* baseBucketOffs = NULL;
+		const uint8_t* basePostings = NULL;
+
+		// entries added after that
+		ds::vector<uint32_t> entryDirs;
+		ds::vector<uint32_t> nameOffs; // into names, +1 at the end for the total size
+		ds::vector<char> names;        // back to back, without terminators
+		ds::vector<ds::vector<uint8_t>> buckets; // ascending entry indices, delta and varint encoded. allocated on first use
+		ds::vector<uint32_t> bucketLast;          // last entry index added to every bucket
+
+		ds::bitset removed; // entries of directories that got listed again since
+		size_t numRemoved = 0;
+
+		ds::stringset dirPaths; // same format as utils::fixDirStr()
+		ds::vector<Dir> dirs;   // the current entries of every directory, they are always next to each other
+		size_t curDir = (size_t)-1; // directory between beginDir() and endDir()
+		Dir prevRange; // entries curDir had before beginDir()
+
+		ds::vector<uint32_t> trigramScratch;
+		ds::vector<char> keyScratch;
+
+		Native::Mutex* mutex = Native::createMutex();
+		Native::Condition* changed = Native::createCondition(); // directories got queued, listings got merged or the thread stops
+		Native::Thread* thread = NULL; // NULL without IMGUIFD_ENABLE_THREADS
+		// guarded by mutex
+		ds::vector<PendingDir> pending;
+		ds::vector<Listing> listed; // not merged yet
+		bool listing = false; // the thread is listing a directory right now
+		bool stop = false;
+		// the listings continueWork() is merging
+		ds::vector<Listing> merging;
+		size_t mergingFront = 0;
+
+		static uint32_t trigramBucket(char a, char b, char c) {
+			const uint32_t v = (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16);
+			return (v * 2654435761u) >> (32 - 18);
+		}
+		// distinct buckets of all trigrams in str
+		void getTrigramBuckets(const char* str, size_t len, ds::vector<uint32_t>* out) const {
+			out->clear();
+			for (size_t i = 0; i + 2 < len; i++) {
+				const uint32_t b = trigramBucket(str[i], str[i+1], str[i+2]);
+				bool found = false;
+				for (size_t j = 0; j < out->size(); j++) {
+					if ((*out)[j] == b) {
+						found = true;
+						break;
+					}
+				}
+				if (!found)
+					out->push_back(b);
+			}
+		}
+
+		static void putVarint(ds::vector<uint8_t>* out, uint32_t v) {
+			while (v >= 0x80) {
+				out->push_back((uint8_t)(v | 0x80));
+				v >>= 7;
+			}
+			out->push_back((uint8_t)v);
+		}
+		// appends the entry indices of a posting list to out
+		static void decodePostings(const uint8_t* data, const uint8_t* end, ds::vector<uint32_t>* out) {
+			uint32_t cur = 0;
+			while (data < end) {
+				uint32_t delta = 0;
+				int shift = 0;
+				while (data < end && (*data & 0x80)) {
+					delta |= (uint32_t)(*data++ & 0x7f) << shift;
+					shift += 7;
+				}
+				if (data < end)
+					delta |= (uint32_t)*data++ << shift;
+				cur += delta;
+				out->push_back(cur);
+			}
+		}
+		size_t bucketBytes(uint32_t b) const {
+			size_t size = baseBucketOffs ? (size_t)(baseBucketOffs[b+1] - baseBucketOffs[b]) : 0;
+			if (buckets.size() > 0)
+				size += buckets[b].size();
+			return size;
+		}
+		void decodeBucket(uint32_t b, ds::vector<uint32_t>* out) const {
+			out->clear();
+			if (baseBucketOffs)
+				decodePostings(basePostings + baseBucketOffs[b], basePostings + baseBucketOffs[b+1], out);
+			if (buckets.size() > 0 && buckets[b].size() > 0)
+				decodePostings(&buckets[b][0], &buckets[b][0] + buckets[b].size(), out);
+		}
+
+		// case insensitive, key is the folded text. keyScratch_ is just space to fold the name in
+		static bool containsKey(const char* name, size_t len, const ds::vector<char>& key, ds::vector<char>* keyScratch_) {
+			if (key.size() == 0)
+				return true;
+			keyScratch_->clear();
+			unicode::appendKey(name, name + len, keyScratch_);
+			return utils::findSubstring(keyScratch_->data(), keyScratch_->size(), key.data(), key.size()) != NULL;
+		}
+
+		void removeRange(const Dir& d) {
+			for (size_t i = d.firstEntry; i < d.firstEntry + d.numEntries; i++) {
+				if (!removed.get(i)) {
+					removed.set(i);
+					numRemoved++;
+				}
+			}
+		}
+		// removes every directory inside of dir and dir itself
+		void removeTree(const char* dir, size_t len) {
+			for (size_t i = 0; i < dirs.size(); i++) {
+				const ds::string& path = dirPaths.get(i);
+				if (path.size() >= len && memcmp(path.c_str(), dir, len) == 0) {
+					removeRange(dirs[i]);
+					dirs[i].numEntries = 0;
+				}
+			}
+		}
+
+		struct ListCtx {
+			Listing* listing;
+			ds::vector<PendingDir>* subdirs;
+			bool recursive;
+		};
+		static void onListEntry(void* userData, const char* name, bool isFolder) {
+			ListCtx* ctx = (ListCtx*)userData;
+			Listing* l = ctx->listing;
+			const size_t len = strlen(name);
+			l->names.resize(l->names.size() + len + 1);
+			memcpy(l->names.data() + l->names.size() - len - 1, name, len + 1);
+			l->isFolder.push_back(isFolder ? 1 : 0);
+			if (isFolder && ctx->recursive)
+				ctx->subdirs->push_back({ l->dir + name + "/", true });
+		}
+		// lists the next pending directory into listed, returns false if there is none.
+		// the mutex has to be locked, it is unlocked while listing
+		bool listNext() {
+			if (stop || pending.size() == 0)
+				return false;
+			const size_t last = pending.size() - 1;
+			const PendingDir pd = pending[last];
+			pending.resize(last);
+			listing = true;
+			Native::unlockMutex(mutex);
+
+			Listing l;
+			l.dir = utils::fixDirStr(pd.path.c_str());
+			ds::vector<PendingDir> subdirs;
+			ListCtx ctx = { &l, &subdirs, pd.recursive };
+			l.success = Native::listDir(l.dir.c_str(), onListEntry, &ctx);
+
+			Native::lockMutex(mutex);
+			listing = false;
+			listed.push_back(Listing());
+			listed.back().dir = l.dir;
+			listed.back().names.swap(l.names);
+			listed.back().isFolder.swap(l.isFolder);
+			listed.back().success = l.success;
+			for (size_t i = 0; i < subdirs.size(); i++)
+				pending.push_back(subdirs[i]);
+			return true;
+		}
+		static void indexThread(void* userData) {
+			NameIndex* index = (NameIndex*)userData;
+			Native::lockMutex(index->mutex);
+			while (!index->stop) {
+				if (index->listed.size() >= MaxListed || !index->listNext())
+					Native::waitCondition(index->changed, index->mutex);
+			}
+			Native::unlockMutex(index->mutex);
+		}
+		void merge(const Listing& l) {
+			beginDir(l.dir.c_str());
+			const char* name = l.names.data();
+			for (size_t i = 0; i < l.isFolder.size(); i++) {
+				const size_t len = strlen(name);
+				addEntry(name, len, l.isFolder[i] != 0);
+				name += len + 1;
+			}
+			endDir();
+			if (!l.success)
+				removeTree(l.dir.c_str(), l.dir.size());
+		}
+		void addPending(const char* dir, bool recursive) {
+			Native::lockMutex(mutex);
+			pending.push_back({ dir, recursive });
+			Native::wakeAll(changed);
+			Native::unlockMutex(mutex);
+			if (!thread)
+				thread = Native::startThread(indexThread, this);
+		}
+		// stops the thread and drops the directories that weren't indexed yet
+		void cancelPending() {
+			Native::lockMutex(mutex);
+			stop = true;
+			Native::wakeAll(changed);
+			Native::unlockMutex(mutex);
+			if (thread)
+				Native::joinThread(thread);
+			thread = NULL;
+			stop = false;
+			pending.clear();
+			listed.clear();
+			merging.clear();
+			mergingFront = 0;
+		}
+
+		bool isFull() const {
+			return numEntries() >= FolderBit || names.size() >= 0xffffffff - 0xffff;
+		}
+
+		// adds the entries of every directory to out, without the removed ones
+		void copyLiveTo(NameIndex* out) const {
+			for (size_t d = 0; d < dirs.size(); d++) {
+				if (dirs[d].numEntries == 0)
+					continue;
+				const ds::string& dirPath = dirPaths.get(d);
+				out->beginDir(dirPath.c_str());
+				for (size_t i = dirs[d].firstEntry; i < dirs[d].firstEntry + dirs[d].numEntries; i++) {
+					size_t len;
+					const char* name = getName(i, &len);
+					out->addEntry(name, len, isFolder(i));
+				}
+				out->endDir();
+			}
+		}
+		// listing directories again only marks their old entries as removed, they are dropped here once they make up half of the index.
+		// this changes the indices of the other entries
+		void compactIfNeeded() {
+			if (numRemoved < MinCompact || numRemoved * 2 < numEntries())
+				return;
+
+			NameIndex compact;
+			copyLiveTo(&compact);
+
+			clearEntries();
+			entryDirs.swap(compact.entryDirs);
+			nameOffs.swap(compact.nameOffs);
+			names.swap(compact.names);
+			buckets.swap(compact.buckets);
+			bucketLast.swap(compact.bucketLast);
+			removed = compact.removed;
+			dirPaths = compact.dirPaths;
+			dirs.swap(compact.dirs);
+		}
+
+		void clearEntries() {
+			if (mapping)
+				Native::unmapFile(mapping, mappingSize);
+			mapping = NULL;
+			mappingSize = 0;
+			numBaseEntries = 0;
+			baseEntryDirs = NULL;
+			baseNameOffs = NULL;
+			baseNames = NULL;
+			baseBucketOffs = NULL;
+			basePostings = NULL;
+			resetMemory();
+		}
+		void resetMemory() {
+			entryDirs.clear();
+			nameOffs.clear();
+			nameOffs.push_back(0);
+			names.clear();
+			buckets.clear();
+			bucketLast.clear();
+			removed.resize(0);
+			numRemoved = 0;
+			dirPaths.clear();
+			dirs.clear();
+			curDir = (size_t)-1;
+		}
+	public:
+		NameIndex() {
+			resetMemory();
+		}
+		~NameIndex() {
+			clear();
+			Native::destroyCondition(changed);
+			Native::destroyMutex(mutex);
+		}
+		NameIndex(const NameIndex&) = delete;
+		NameIndex& operator=(const NameIndex&) = delete;
+
+		size_t numEntries() const {
+			return numBaseEntries + entryDirs.size();
+		}
+		size_t numLiveEntries() const {
+			return numEntries() - numRemoved;
+		}
+
+		const char* getName(size_t i, size_t* len) const {
+			if (i < numBaseEntries) {
+				*len = baseNameOffs[i+1] - baseNameOffs[i];
+				return baseNames + baseNameOffs[i];
+			}
+			i -= numBaseEntries;
+			*len = nameOffs[i+1] - nameOffs[i];
+			return names.size() > 0 ? &names[0] + nameOffs[i] : "";
+		}
+		const ds::string& getDir(size_t i) const {
+			const uint32_t d = i < numBaseEntries ? baseEntryDirs[i] : entryDirs[i - numBaseEntries];
+			return dirPaths.get(d & ~FolderBit);
+		}
+		bool isFolder(size_t i) const {
+			const uint32_t d = i < numBaseEntries ? baseEntryDirs[i] : entryDirs[i - numBaseEntries];
+			return (d & FolderBit) != 0;
+		}
+		// the entry belongs to an old listing of its directory
+		bool isRemoved(size_t i) const {
+			return removed.get(i);
+		}
+
+		// replaces the entries of dir with the ones added until endDir()
+		void beginDir(const char* dir) {
+			IM_ASSERT(curDir == (size_t)-1);
+			const ds::string path = utils::fixDirStr(dir);
+			curDir = dirPaths.add(path.c_str(), path.size());
+			if (curDir == dirs.size())
+				dirs.push_back(Dir());
+
+			prevRange = dirs[curDir];
+			removeRange(prevRange);
+			dirs[curDir].firstEntry = numEntries();
+			dirs[curDir].numEntries = 0;
+		}
+		void addEntry(const char* name, size_t len, bool isFolder) {
+			IM_ASSERT(curDir != (size_t)-1);
+			if (isFull())
+				return;
+
+			const uint32_t ind = (uint32_t)numEntries();
+			entryDirs.push_back((uint32_t)curDir | (isFolder ? (uint32_t)FolderBit : 0));
+			names.resize(names.size() + len);
+			if (len > 0)
+				memcpy(&names[0] + names.size() - len, name, len);
+			nameOffs.push_back((uint32_t)names.size());
+			removed.grow(numEntries());
+			dirs[curDir].numEntries++;
+
+			if (buckets.size() == 0) {
+				buckets.resize(NumBuckets);
+				bucketLast.resize(NumBuckets, 0);
+			}
+			keyScratch.clear();
+			unicode::appendKey(name, name + len, &keyScratch);
+			getTrigramBuckets(keyScratch.data(), keyScratch.size(), &trigramScratch);
+			for (size_t i = 0; i < trigramScratch.size(); i++) {
+				const uint32_t b = trigramScratch[i];
+				putVarint(&buckets[b], ind - bucketLast[b]);
+				bucketLast[b] = ind;
+			}
+		}
+		// also removes the subtrees of folders that are gone since the last time dir was listed
+		void endDir() {
+			IM_ASSERT(curDir != (size_t)-1);
+			const size_t dirInd = curDir;
+			curDir = (size_t)-1;
+			if (prevRange.numEntries == 0)
+				return;
+
+			ds::stringset folders;
+			const Dir& d = dirs[dirInd];
+			for (size_t i = d.firstEntry; i < d.firstEntry + d.numEntries; i++) {
+				if (isFolder(i)) {
+					size_t len;
+					const char* name = getName(i, &len);
+					folders.add(name, len);
+				}
+			}
+			for (size_t i = prevRange.firstEntry; i < prevRange.firstEntry + prevRange.numEntries; i++) {
+				size_t len;
+				const char* name = getName(i, &len);
+				if (!isFolder(i) || folders.contains(name, len))
+					continue;
+				const ds::string path = dirPaths.get(dirInd) + ds::string(name, name + len) + "/";
+				if (dirPaths.contains(path.c_str(), path.size()))
+					removeTree(path.c_str(), path.size());
+			}
+			compactIfNeeded();
+		}
+
+		// the entries dir has in the index, starting at *first. 0 if dir isn't indexed
+		size_t getDirEntries(const char* dir, size_t* first) const {
+			const ds::string path = utils::fixDirStr(dir);
+			const size_t d = dirPaths.find(path.c_str(), path.size());
+			if (d == ds::stringset::NotFound || d >= dirs.size())
+				return 0;
+			*first = dirs[d].firstEntry;
+			return dirs[d].numEntries;
+		}
+
+		// indexes dir and everything in it in the background
+		void addRoot(const char* dir) {
+			addPending(dir, true);
+		}
+		// lists dir again (without going into its subfolders)
+		void dirChanged(const char* dir) {
+			addPending(dir, false);
+		}
+		bool isBusy() const {
+			Native::lockMutex(mutex);
+			const bool busy = pending.size() > 0 || listing || listed.size() > 0;
+			Native::unlockMutex(mutex);
+			return busy || mergingFront < merging.size();
+		}
+		// merges listed directories into the index until deadline (see Native::getTime()), but at least one.
+		// without threads they are listed here as well
+		void continueWork(double deadline) {
+			do {
+				if (mergingFront == merging.size()) {
+					Native::lockMutex(mutex);
+					if (!thread)
+						listNext();
+					merging.resize(0);
+					mergingFront = 0;
+					merging.swap(listed);
+					Native::wakeAll(changed);
+					Native::unlockMutex(mutex);
+					if (merging.size() == 0)
+						break;
+				}
+				merge(merging[mergingFront++]);
+			} while (Native::getTime() < deadline);
+		}
+
+		// indices of entries with names containing text (case insensitive)
+		void find(const char* text, size_t maxResults, ds::vector<size_t>* out) const {
+			out->clear();
+			ds::vector<char> key, nameKey;
+			unicode::appendKey(text, text + strlen(text), &key);
+
+			if (key.size() < 3) { // no trigrams, just check everything
+				for (size_t i = 0; i < numEntries() && out->size() < maxResults; i++) {
+					size_t len;
+					const char* name = getName(i, &len);
+					if (!removed.get(i) && containsKey(name, len, key, &nameKey))
+						out->push_back(i);
+				}
+				return;
+			}
+
+			ds::vector<uint32_t> trigrams;
+			getTrigramBuckets(key.data(), key.size(), &trigrams);
+			// rarest first
+			for (size_t i = 1; i < trigrams.size(); i++) {
+				const uint32_t t = trigrams[i];
+				const size_t bytes = bucketBytes(t);
+				size_t j = i;
+				while (j > 0 && bucketBytes(trigrams[j-1]) > bytes) {
+					trigrams[j] = trigrams[j-1];
+					j--;
+				}
+				trigrams[j] = t;
+			}
+
+			ds::vector<uint32_t> candidates, list, merged;
+			decodeBucket(trigrams[0], &candidates);
+			for (size_t t = 1; t < trigrams.size() && candidates.size() > MaxCandidates; t++) {
+				// checking the names of the candidates directly is cheaper than decoding a list that is a lot longer
+				if (bucketBytes(trigrams[t]) > candidates.size() * CandidateCost)
+					break;
+				decodeBucket(trigrams[t], &list);
+				merged.clear();
+				size_t j = 0;
+				for (size_t i = 0; i < candidates.size(); i++) {
+					while (j < list.size() && list[j] < candidates[i])
+						j++;
+					if (j == list.size())
+						break;
+					if (list[j] == candidates[i])
+						merged.push_back(candidates[i]);
+				}
+				candidates = merged;
+			}
+
+			for (size_t i = 0; i < candidates.size() && out->size() < maxResults; i++) {
+				const size_t ind = candidates[i];
+				if (ind >= numEntries() || removed.get(ind))
+					continue;
+				size_t len;
+				const char* name = getName(ind, &len);
+				if (containsKey(name, len, key, &nameKey))
+					out->push_back(ind);
+			}
+		}
+
+		// writes all current entries into file, which is then used as the base of the index
+		bool save(const char* path) {
+			IM_ASSERT(curDir == (size_t)-1);
+
+			NameIndex compact;
+			copyLiveTo(&compact);
+
+			const ds::string tmpPath = ds::string(path) + ".tmp";
+			if (!compact.write(tmpPath.c_str())) {
+				::remove(tmpPath.c_str());
+				return false;
+			}
+
+			// rename() doesn't replace files everywhere and the old file may still be mapped, so it is moved out of the way first.
+			// nothing changes if the new file can't be put in place
+			const ds::string oldPath = ds::string(path) + ".old";
+			::remove(oldPath.c_str());
+			const bool movedOld = ::rename(path, oldPath.c_str()) == 0;
+			if (::rename(tmpPath.c_str(), path) != 0) {
+				if (movedOld)
+					::rename(oldPath.c_str(), path);
+				::remove(tmpPath.c_str());
+				return false;
+			}
+
+			const bool loaded = loadFile(path); // releases the old mapping
+			if (movedOld)
+				::remove(oldPath.c_str());
+			return loaded;
+		}
+		bool write(const char* path) const {
+			IM_ASSERT(numBaseEntries == 0 && numRemoved == 0);
+
+			FILE* file = fopen(Native::makePathStrOSComply(path).c_str(), "wb");
+			if (!file)
+				return false;
+
+			FileHeader header;
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, "IMGUIFDI", 8);
+			header.version = FileVersion;
+			header.numBuckets = NumBuckets;
+			header.numDirs = dirs.size();
+			header.numEntries = numEntries();
+			header.namesSize = names.size();
+			for (size_t d = 0; d < dirs.size(); d++)
+				header.dirCharsSize += dirPaths.get(d).size();
+			for (size_t b = 0; b < buckets.size(); b++)
+				header.postingsSize += buckets[b].size();
+			const FileLayout layout(header);
+
+			bool ok = true;
+			uint64_t pos = 0;
+			auto put = [&](const void* data, size_t size) {
+				if (size > 0 && fwrite(data, 1, size, file) != size)
+					ok = false;
+				pos += size;
+			};
+			auto padTo = [&](uint64_t off) {
+				const char zeros[8] = {};
+				IM_ASSERT(off >= pos && off - pos < 8);
+				put(zeros, (size_t)(off - pos));
+			};
+
+			put(&header, sizeof(header));
+
+			padTo(layout.dirOffs);
+			uint64_t off = 0;
+			for (size_t d = 0; d < dirs.size(); d++) {
+				put(&off, sizeof(off));
+				off += dirPaths.get(d).size();
+			}
+			put(&off, sizeof(off));
+			padTo(layout.dirChars);
+			for (size_t d = 0; d < dirs.size(); d++)
+				put(dirPaths.get(d).c_str(), dirPaths.get(d).size());
+
+			padTo(layout.entryDirs);
+			if (entryDirs.size() > 0)
+				put(&entryDirs[0], entryDirs.size() * sizeof(uint32_t));
+			padTo(layout.nameOffs);
+			put(&nameOffs[0], nameOffs.size() * sizeof(uint32_t));
+			padTo(layout.names);
+			if (names.size() > 0)
+				put(&names[0], names.size());
+
+			padTo(layout.bucketOffs);
+			off = 0;
+			for (size_t b = 0; b < NumBuckets; b++) {
+				put(&off, sizeof(off));
+				off += buckets.size() > 0 ? buckets[b].size() : 0;
+			}
+			put(&off, sizeof(off));
+			padTo(layout.postings);
+			for (size_t b = 0; b < buckets.size(); b++) {
+				if (buckets[b].size() > 0)
+					put(&buckets[b][0], buckets[b].size());
+			}
+
+			if (fclose(file) != 0)
+				ok = false;
+			return ok;
+		}
+
+		// replaces the index with the one in file, directories that weren't indexed yet are dropped
+		bool load(const char* path) {
+			clear();
+			return loadFile(path);
+		}
+		// replaces the entries with the ones in file, pending directories stay
+		bool loadFile(const char* path) {
+			clearEntries();
+
+			size_t size = 0;
+			const void* data = Native::mapFile(path, &size);
+			if (!data)
+				return false;
+
+			const uint8_t* bytes = (const uint8_t*)data;
+			FileHeader header;
+			if (size < sizeof(header)) {
+				Native::unmapFile(data, size);
+				return false;
+			}
+			memcpy(&header, data, sizeof(header));
+			// everything has to fit into 32bit indices, which also keeps the layout from overflowing
+			if (memcmp(header.magic, "IMGUIFDI", 8) != 0 || header.version != FileVersion || header.numBuckets != NumBuckets
+				|| header.numDirs >= FolderBit || header.numEntries >= FolderBit || header.namesSize > 0xffffffff
+				|| header.dirCharsSize > size || header.postingsSize > size || FileLayout(header).end > size)
+			{
+				Native::unmapFile(data, size);
+				return false;
+			}
+			const FileLayout layout(header);
+
+			const uint64_t* dirOffs = (const uint64_t*)(bytes + layout.dirOffs);
+			const char* dirChars = (const char*)(bytes + layout.dirChars);
+			const uint32_t* eDirs = (const uint32_t*)(bytes + layout.entryDirs);
+			const uint32_t* nOffs = (const uint32_t*)(bytes + layout.nameOffs);
+			const uint64_t* bOffs = (const uint64_t*)(bytes + layout.bucketOffs);
+
+			bool valid = dirOffs[header.numDirs] == header.dirCharsSize && nOffs[header.numEntries] == header.namesSize && bOffs[NumBuckets] == header.postingsSize;
+			for (size_t d = 0; valid && d < header.numDirs; d++) {
+				if (dirOffs[d] > dirOffs[d+1] || dirOffs[d+1] > header.dirCharsSize) {
+					valid = false;
+					break;
+				}
+				dirPaths.add(dirChars + dirOffs[d], (size_t)(dirOffs[d+1] - dirOffs[d]));
+				dirs.push_back(Dir());
+			}
+			valid = valid && dirPaths.size() == header.numDirs; // no duplicates
+			for (size_t i = 0; valid && i < header.numEntries; i++) {
+				const uint32_t d = eDirs[i] & ~FolderBit;
+				if (d >= header.numDirs || nOffs[i] > nOffs[i+1]) {
+					valid = false;
+					break;
+				}
+				Dir& dir = dirs[d];
+				if (dir.numEntries == 0)
+					dir.firstEntry = i;
+				else if (dir.firstEntry + dir.numEntries != i) // not next to each other
+					valid = false;
+				dir.numEntries++;
+			}
+			for (size_t b = 0; valid && b < NumBuckets; b++) {
+				if (bOffs[b] > bOffs[b+1])
+					valid = false;
+			}
+			if (!valid) {
+				Native::unmapFile(data, size);
+				resetMemory();
+				return false;
+			}
+
+			mapping = data;
+			mappingSize = size;
+			numBaseEntries = (size_t)header.numEntries;
+			baseEntryDirs = eDirs;
+			baseNameOffs = nOffs;
+			baseNames = (const char*)(bytes + layout.names);
+			baseBucketOffs = bOffs;
+			basePostings = bytes + layout.postings;
+			removed.resize(numBaseEntries);
+			return true;
+		}
+
+		void clear() {
+			cancelPending();
+			clearEntries();
+		}
+	};
+	NameIndex nameIndex;
+
+	// shares a T on the heap between all copies of its owner (dialogs get copied around in openDialogs), the last one deletes it.
+	// the copies only live on the UI thread, so the count doesn't have to be atomic
+	template<typename T>
+	class SharedRef {
+	private:
+		struct Counted {
+			T value;
+			size_t numRefs = 1;
+		};
+		Counted* counted = NULL;
+	public:
+		SharedRef() {
+
+		}
+		SharedRef(const SharedRef& src) : counted(src.counted) {
+			if (counted)
+				counted->numRefs++;
+		}
+		SharedRef& operator=(const SharedRef& src) {
+			if (src.counted)
+				src.counted->numRefs++;
+			reset();
+			counted = src.counted;
+			return *this;
+		}
+		~SharedRef() {
+			reset();
+		}
+
+		T* create() {
+			reset();
+			counted = IM_NEW(Counted)();
+			return &counted->value;
+		}
+		void reset() {
+			if (counted && --counted->numRefs == 0)
+				IM_DELETE(counted);
+			counted = NULL;
+		}
+		T* get() const {
+			return counted ? &counted->value : NULL;
+		}
+	};
+
+	// searches every folder below root for entries passing a FileNameFilter (search text, filter group and predicates).
+	// with IMGUIFD_ENABLE_THREADS the folders are listed by threads of its own that take them from one shared queue and post
+	// what they find, continueWork() only picks up the results. without threads, continueWork() lists one folder after the other
+	// until its deadline. links to folders are followed, but every folder (identified by Native::getFileId()) is only visited once
+	class SubtreeSearch {
+	public:
+		enum : size_t { MaxResults = 10000 };
+	private:
+		struct Subdir {
+			ds::string path;
+			uint64_t fileId[2];
+			bool hasId;
+		};
+		// what was found in one folder
+		struct Found {
+			ds::vector<DirEntry> matches;
+			ds::vector<Subdir> subdirs;
+		};
+		struct ListCtx {
+			const ds::string* dir;
+			Found* found;
+			FileNameFilter* filter;
+			ds::vector<char> foldedName;
+		};
+
+		struct Walk;
+		struct WalkThread {
+			Walk* walk;
+			size_t threadInd;
+		};
+		// the state of one search, shared with its threads
+		struct Walk {
+			Native::Mutex* mutex = Native::createMutex();
+			Native::Condition* changed = Native::createCondition(); // folders got queued, a thread is done with one or the walk stops
+			ds::vector<Native::Thread*> threads; // empty without IMGUIFD_ENABLE_THREADS
+			ds::vector<WalkThread> threadArgs;
+			ds::vector<FileNameFilter> filters; // one per thread, see EntryManager::filterCopies
+
+			// guarded by mutex
+			ds::vector<ds::string> pending; // breadth first, so results close to root come first
+			size_t pendingFront = 0;
+			ds::stringset visited; // the ids of all queued folders, as raw bytes
+			ds::vector<DirEntry> found; // results continueWork() didn't pick up yet
+			size_t numFound = 0;
+			size_t numListing = 0; // folders threads are listing right now
+			size_t numDirsDone = 0;
+			bool stop = false;
+
+			~Walk() {
+				Native::lockMutex(mutex);
+				stop = true;
+				Native::wakeAll(changed);
+				Native::unlockMutex(mutex);
+				for (size_t i = 0; i < threads.size(); i++)
+					Native::joinThread(threads[i]);
+				Native::destroyCondition(changed);
+				Native::destroyMutex(mutex);
+			}
+
+			bool isDone() const {
+				return stop || (pendingFront == pending.size() && numListing == 0);
+			}
+
+			void addPending(const ds::string& path, const uint64_t* fileId) {
+				if (fileId) {
+					const size_t numVisited = visited.size();
+					visited.add((const char*)fileId, sizeof(uint64_t) * 2);
+					if (visited.size() == numVisited)
+						return;
+				}
+				pending.push_back(path);
+			}
+			ds::string takePending() {
+				ds::string dir = pending[pendingFront++];
+				if (pendingFront > 1024 && pendingFront * 2 > pending.size()) { // drop the folders that are done
+					ds::vector<ds::string> rest;
+					rest.reserve(pending.size() - pendingFront);
+					for (size_t i = pendingFront; i < pending.size(); i++)
+						rest.push_back(pending[i]);
+					pending.swap(rest);
+					pendingFront = 0;
+				}
+				return dir;
+			}
+			// what was found in a folder, with the mutex locked
+			void addFound(const Found& f) {
+				numDirsDone++;
+				for (size_t m = 0; m < f.matches.size() && !stop; m++) {
+					found.push_back(f.matches[m]);
+					numFound++;
+					stop = numFound >= MaxResults;
+				}
+				for (size_t d = 0; d < f.subdirs.size() && !stop; d++)
+					addPending(f.subdirs[d].path, f.subdirs[d].hasId ? f.subdirs[d].fileId : NULL);
+			}
+		};
+
+		ds::string root;
+		SharedRef<Walk> walk;
+		ds::vector<DirEntry> results;
+		size_t numDirsDone = 0;
+		bool active = false;
+
+		static void onListEntry(void* userData, const char* name, bool isFolder) {
+			ListCtx* ctx = (ListCtx*)userData;
+			if (isFolder) {
+				ctx->found->subdirs.push_back(Subdir());
+				Subdir& sub = ctx->found->subdirs.back();
+				sub.path = *ctx->dir + name + "/";
+				sub.hasId = Native::getFileId(sub.path.c_str(), &sub.fileId[0], &sub.fileId[1]);
+			}
+
+			FileNameFilter& filter = *ctx->filter;
+			if (!filter.passesFilter(name, isFolder, utils::getExtension(name)))
+				return;
+			ctx->foldedName.clear();
+			unicode::appendKey(name, name + strlen(name), &ctx->foldedName);
+			if (!filter.passesSearch(ctx->foldedName.data(), ctx->foldedName.data() + ctx->foldedName.size()))
+				return;
+
+			DirEntry entry;
+			entry.name = ImStrdup(name);
+			entry.dir = ImStrdup(ctx->dir->c_str());
+			entry.isFolder = isFolder;
+			entry.path = ImStrdup((*ctx->dir + name + (isFolder ? "/" : "")).c_str());
+			const ds::vector<MetaPredicate>& predicates = filter.getPredicates();
+			if (predicates.size() > 0) {
+				Native::statDirEnt(&entry);
+				for (size_t p = 0; p < predicates.size(); p++) {
+					if (!predicates[p].passes(MetaPredicate::getValue(entry, predicates[p].field)))
+						return;
+				}
+			}
+			ctx->found->matches.push_back(entry);
+		}
+		static void listDir(const ds::string& dir, FileNameFilter* filter, Found* found) {
+			found->matches.clear();
+			found->subdirs.clear();
+			ListCtx ctx;
+			ctx.dir = &dir;
+			ctx.found = found;
+			ctx.filter = filter;
+			Native::listDir(dir.c_str(), onListEntry, &ctx, true);
+		}
+		static void walkThread(void* userData) {
+			const WalkThread& arg = *(const WalkThread*)userData;
+			Walk* w = arg.walk;
+			Found found;
+			Native::lockMutex(w->mutex);
+			while (true) {
+				while (!w->stop && w->pendingFront == w->pending.size() && w->numListing > 0) // the others might still find subfolders
+					Native::waitCondition(w->changed, w->mutex);
+				if (w->isDone())
+					break;
+
+				const ds::string dir = w->takePending();
+				w->numListing++;
+				Native::unlockMutex(w->mutex);
+				listDir(dir, &w->filters[arg.threadInd], &found);
+				Native::lockMutex(w->mutex);
+				w->numListing--;
+				w->addFound(found);
+				Native::wakeAll(w->changed);
+			}
+			Native::wakeAll(w->changed); // the others are waiting for this one otherwise
+			Native::unlockMutex(w->mutex);
+		}
+	public:
+		// filter is copied, so it can change while searching
+		void begin(const char* dir, const FileNameFilter& filter) {
+			cancel();
+			root = utils::fixDirStr(dir);
+			active = true;
+
+			Walk* w = walk.create();
+			uint64_t fileId[2];
+			w->addPending(root, Native::getFileId(root.c_str(), &fileId[0], &fileId[1]) ? fileId : NULL);
+
+			const size_t numThreads = Native::getNumThreads(settings.maxThreads > 0 ? (size_t)settings.maxThreads : 0);
+			w->filters = ds::vector<FileNameFilter>(numThreads, filter);
+			w->threadArgs.resize(numThreads); // not resized anymore, the threads point into it
+			for (size_t i = 0; i < numThreads; i++) {
+				w->threadArgs[i].walk = w;
+				w->threadArgs[i].threadInd = i;
+				Native::Thread* thread = Native::startThread(walkThread, &w->threadArgs[i]);
+				if (thread)
+					w->threads.push_back(thread);
+			}
+		}
+		void cancel() {
+			walk.reset(); // the threads stop once no other copy of this search needs them anymore
+			results.clear();
+			numDirsDone = 0;
+			active = false;
+		}
+
+		// picks up the results the threads found. without threads it lists folders until deadline (see Native::getTime()) itself.
+		// returns true if results were added
+		bool continueWork(double deadline) {
+			Walk* w = walk.get();
+			if (!active || !w)
+				return false;
+
+			if (w->threads.size() == 0) {
+				Found found;
+				while (!w->isDone() && Native::getTime() < deadline) {
+					const ds::string dir = w->takePending();
+					listDir(dir, &w->filters[0], &found);
+					w->addFound(found);
+				}
+			}
+
+			const size_t numResults = results.size();
+			Native::lockMutex(w->mutex);
+			for (size_t i = 0; i < w->found.size(); i++) {
+				results.push_back(w->found[i]);
+				results.back().id = (ImGuiID)(results.size() - 1);
+			}
+			w->found.clear();
+			numDirsDone = w->numDirsDone;
+			const bool done = w->isDone();
+			Native::unlockMutex(w->mutex);
+
+			if (done) {
+				active = false;
+				walk.reset();
+			}
+			return results.size() != numResults;
+		}
+
+		bool isActive() const {
+			return active;
+		}
+		bool reachedMaxResults() const {
+			return results.size() >= MaxResults;
+		}
+		size_t getNumDirsDone() const {
+			return numDirsDone;
+		}
+		const ds::string& getRoot() const {
+			return root;
+		}
+		const ds::vector<DirEntry>& getResults() const {
+			return results;
+		}
+	};
+
+	// finds the files containing a text (the "contains:" word of the search), out of a list of candidates.
+	// with IMGUIFD_ENABLE_THREADS the files are mapped into memory and scanned by threads of its own, continueWork() only picks up
+	// the results. without threads continueWork() scans them itself, ScanRange bytes at a time until its deadline, so big files
+	// are spread over frames. files that look binary or are bigger than settings.contentSearchMaxFileSize are skipped,
+	// the search stops once settings.contentSearchMaxBytes were read
+	class ContentSearch {
+	public:
+		enum : size_t { MaxResults = 10000 };
+	private:
+		enum : size_t {
+			SniffSize = 1024,   // files with a 0 byte in the first SniffSize bytes count as binary
+			ScanRange = 1 << 20 // bytes scanned between checking the deadline or whether the search got cancelled
+		};
+		enum : uint8_t {
+			Result_NoMatch = 0,
+			Result_Match,
+			Result_Skipped, // binary or couldn't be read
+			Result_Pending  // the rest of the file still has to be scanned
+		};
+
+		// a file that is being scanned
+		struct FileScan {
+			size_t candidate = (size_t)-1;
+			const char* data = NULL;
+			size_t size = 0;
+			size_t pos = 0; // scanned up to here
+		};
+
+		// the state of one search, shared with its threads
+		struct Scan {
+			Native::Mutex* mutex = Native::createMutex();
+			ds::vector<Native::Thread*> threads; // empty without IMGUIFD_ENABLE_THREADS
+
+			// not changed anymore once the threads run
+			ds::vector<DirEntry> candidates;
+			ds::string text; // lower case
+			uint64_t maxFileSize = 0;
+			uint64_t maxBytes = 0;
+
+			// guarded by mutex
+			size_t nextCandidate = 0;
+			size_t numScanning = 0;
+			ds::vector<size_t> found; // indices into candidates, continueWork() didn't pick them up yet
+			size_t numFound = 0;
+			uint64_t bytesRead = 0;
+			size_t numFilesDone = 0;
+			size_t numSkipped = 0;
+			bool stoppedAtMaxBytes = false;
+			bool stop = false;
+
+			FileScan current; // without threads, the file continueWork() is in the middle of
+
+			~Scan() {
+				Native::lockMutex(mutex);
+				stop = true;
+				Native::unlockMutex(mutex);
+				for (size_t i = 0; i < threads.size(); i++)
+					Native::joinThread(threads[i]);
+				if (current.data)
+					Native::unmapFile(current.data, current.size);
+				Native::destroyMutex(mutex);
+			}
+
+			bool isDone() const {
+				return stop || ((stoppedAtMaxBytes || nextCandidate == candidates.size()) && numScanning == 0);
+			}
+			// picks the next file to scan, with the mutex locked. the sizes are known from the listing, so the limits are
+			// checked before reading anything
+			bool takeCandidate(size_t* ind) {
+				while (!stop && !stoppedAtMaxBytes && nextCandidate < candidates.size()) {
+					const DirEntry& entry = candidates[nextCandidate];
+					if (entry.size != (uint64_t)-1 && entry.size > maxFileSize) {
+						nextCandidate++;
+						numFilesDone++;
+						numSkipped++;
+						continue;
+					}
+					const uint64_t size = entry.size != (uint64_t)-1 ? entry.size : 0;
+					if (bytesRead + size > maxBytes) {
+						stoppedAtMaxBytes = true;
+						break;
+					}
+					bytesRead += size;
+					*ind = nextCandidate++;
+					numScanning++;
+					return true;
+				}
+				return false;
+			}
+			// with the mutex locked
+			void addResult(size_t ind, uint8_t result) {
+				numScanning--;
+				numFilesDone++;
+				if (result == Result_Match) {
+					found.push_back(ind);
+					numFound++;
+					stop = stop || numFound >= MaxResults;
+				}
+				else if (result == Result_Skipped) {
+					numSkipped++;
+				}
+			}
+
+			// scans up to maxBytes more of file, returns Result_Pending if it isn't done yet
+			uint8_t scanStep(FileScan* file, size_t maxBytes) const {
+				if (!file->data) {
+					const DirEntry& entry = candidates[file->candidate];
+					file->data = (const char*)Native::mapFile(entry.path, &file->size);
+					file->pos = 0;
+					if (!file->data) // empty files are never mapped, but they can't contain anything either
+						return entry.size == 0 ? (uint8_t)Result_NoMatch : (uint8_t)Result_Skipped;
+					if (memchr(file->data, 0, ImMin(file->size, (size_t)SniffSize)) != NULL)
+						return finish(file, Result_Skipped);
+				}
+
+				// the ranges overlap by the length of text - 1, so matches across their ends are found too
+				const size_t end = file->size - file->pos > maxBytes ? file->pos + maxBytes : file->size;
+				const size_t searchEnd = file->size - end > text.size() ? end + text.size() - 1 : file->size;
+				if (utils::findSubstringIgnoreCase(file->data + file->pos, searchEnd - file->pos, text.c_str(), text.size()) != NULL)
+					return finish(file, Result_Match);
+				file->pos = end;
+				return end == file->size ? finish(file, Result_NoMatch) : (uint8_t)Result_Pending;
+			}
+			static uint8_t finish(FileScan* file, uint8_t result) {
+				Native::unmapFile(file->data, file->size);
+				file->data = NULL;
+				return result;
+			}
+		};
+
+		SharedRef<Scan> scan;
+		ds::vector<DirEntry> results;
+		size_t numCandidates = 0;
+		uint64_t bytesRead = 0;
+		size_t numFilesDone = 0;
+		size_t numSkipped = 0;
+		bool active = false;
+		bool stoppedAtMaxBytes = false;
+
+		static void scanThread(void* userData) {
+			Scan* s = (Scan*)userData;
+			Native::lockMutex(s->mutex);
+			size_t ind;
+			while (s->takeCandidate(&ind)) {
+				FileScan file;
+				file.candidate = ind;
+				uint8_t result = Result_Pending;
+				while (result == Result_Pending && !s->stop) {
+					Native::unlockMutex(s->mutex);
+					result = s->scanStep(&file, ScanRange);
+					Native::lockMutex(s->mutex);
+				}
+				if (file.data) // cancelled in the middle of it
+					Scan::finish(&file, Result_Skipped);
+				s->addResult(ind, result);
+			}
+			Native::unlockMutex(s->mutex);
+		}
+	public:
+		// lowerText has to be lower case
+		void begin(const ds::vector<DirEntry>& files, const ds::string& lowerText) {
+			cancel();
+			active = true;
+			numCandidates = files.size();
+
+			Scan* s = scan.create();
+			s->candidates = files;
+			s->text = lowerText;
+			s->maxFileSize = settings.contentSearchMaxFileSize;
+			s->maxBytes = settings.contentSearchMaxBytes;
+
+			const size_t numThreads = ImMin(Native::getNumThreads(settings.maxThreads > 0 ? (size_t)settings.maxThreads : 0), files.size());
+			for (size_t i = 0; i < numThreads; i++) {
+				Native::Thread* thread = Native::startThread(scanThread, s);
+				if (thread)
+					s->threads.push_back(thread);
+			}
+		}
+		void cancel() {
+			scan.reset(); // the threads stop once no other copy of this search needs them anymore
+			results.clear();
+			numCandidates = 0;
+			bytesRead = 0;
+			numFilesDone = 0;
+			numSkipped = 0;
+			active = false;
+			stoppedAtMaxBytes = false;
+		}
+
+		// picks up the results the threads found. without threads it scans files until deadline (see Native::getTime()) itself.
+		// returns true if results were added
+		bool continueWork(double deadline) {
+			Scan* s = scan.get();
+			if (!active || !s)
+				return false;
+
+			if (s->threads.size() == 0) {
+				FileScan& file = s->current;
+				while (!s->isDone() && Native::getTime() < deadline) {
+					if (file.candidate == (size_t)-1 && !s->takeCandidate(&file.candidate))
+						break;
+					const uint8_t result = s->scanStep(&file, ScanRange);
+					if (result != Result_Pending) {
+						s->addResult(file.candidate, result);
+						file = FileScan();
+					}
+				}
+			}
+
+			const size_t numResults = results.size();
+			Native::lockMutex(s->mutex);
+			for (size_t i = 0; i < s->found.size(); i++) {
+				results.push_back(s->candidates[s->found[i]]);
+				results.back().id = (ImGuiID)(results.size() - 1);
+			}
+			s->found.clear();
+			bytesRead = s->bytesRead;
+			numFilesDone = s->numFilesDone;
+			numSkipped = s->numSkipped;
+			stoppedAtMaxBytes = s->stoppedAtMaxBytes;
+			const bool done = s->isDone();
+			Native::unlockMutex(s->mutex);
+
+			if (done) {
+				active = false;
+				scan.reset();
+			}
+			return results.size() != numResults;
+		}
+
+		bool isActive() const {
+			return active;
+		}
+		bool reachedLimit() const {
+			return stoppedAtMaxBytes || results.size() >= MaxResults;
+		}
+		size_t getNumFilesDone() const {
+			return numFilesDone;
+		}
+		size_t getNumSkipped() const {
+			return numSkipped;
+		}
+		size_t getNumCandidates() const {
+			return numCandidates;
+		}
+		uint64_t getBytesRead() const {
+			return bytesRead;
+		}
+		const ds::vector<DirEntry>& getResults() const {
+			return results;
+		}
+	};
+	
+	class FileDialog {
+	public:
+		ds::string str_id;
+		ImGuiID id;
+		
+		ds::string path;
+		EditablePath currentPath;
+		ds::string oldPath;
+		ImGuiID nextNewId = 0; // for files that appear in oldPath later, after the ids of the listing (see Native::loadDirEnts())
+		ds::string couldntLoadPath;
+
+		bool forceDisplayAllDirs = false;
+
+		bool isEditingPath = false;
+		ds::string editOnPathStr;
+		ds::OverrideStack<ds::string> undoStack;
+		ds::OverrideStack<ds::string> redoStack;
+		
+		class EntryManager {
+		public:
+			enum : size_t { MaxIconLabelLines = 2 };
+			// the lines of a name in the icon mode, as byte ranges of the name
+			struct IconLabel {
+				uint32_t lineStart[MaxIconLabelLines];
+				uint32_t lineEnd[MaxIconLabelLines];
+				float lineWidth[MaxIconLabelLines]; // including the ellipsis
+				uint32_t numLines;
+				float ellipsisX; // if >= 0, the last line is cut off and "..." goes this far from its start
+			};
+		private:
+			ds::vector<DirEntry> data;
+			ds::vector<size_t> dataModed;
+			ds::vector<uint64_t> nameMasks; // FuzzyMatcher::charMask() of every entry name, computed once on load
+			ds::vector<char> foldedNames;    // the keys of all names (see unicode::appendKey()), '\0' separated and back to back, for searching
+			ds::vector<size_t> foldedNameOffs; // where the key of each entry starts in foldedNames, +1 at the end for the total size
+			ds::vector<uint32_t> nameLens;  // length of each name, which the key doesn't have to have
+			ds::vector<uint32_t> extOffs;   // offset of the extension inside each name, NoExt if it doesn't have one
+			// names sort by their keys: the folded name, or with settings.naturalSort a natural key (see buildNaturalKey())
+			ds::vector<char> naturalKeys;      // '\0' separated like foldedNames, empty unless naturalKeysUsed
+			ds::vector<size_t> naturalKeyOffs;
+			bool naturalKeysUsed = false;
+			ds::vector<uint64_t> namePrefixes; // the first 8 bytes of every key (zero padded), big endian so they order like the keys
+			ds::vector<ImGuiID> ids;
+			// the metadata of every entry as columns, so predicates can be checked with tight loops over them
+			ds::vector<int64_t> sizes;       // -1 if unknown (folders)
+			ds::vector<int64_t> modTimes;
+			ds::vector<int64_t> createTimes;
+			ds::bitset folders;
+
+			// the size and dates as shown, formatted the first time an entry gets drawn (see getFormatted()).
+			// they live as long as the listing, or until the format settings or the time zone change
+			ds::vector<char> formattedText;     // '\0' terminated, back to back
+			ds::vector<uint32_t> formattedOffs; // Formatted_Count offsets into formattedText per entry, NotFormatted until used
+			bool formattedHumanSizes = false;
+			ds::string formattedDateFormat;
+			int formattedUtcOffset = 0;
+			double formattedCheckTime = -1; // when the time zone was checked last
+
+			// where the names break into lines in the icon mode, computed the first time an entry is drawn (see getIconLabel()).
+			// they are only valid for one font, font size and item width
+			ds::vector<IconLabel> iconLabels;
+			ds::vector<uint32_t> iconLabelInds; // index into iconLabels per entry, NotFormatted until used
+			const ImFont* iconLabelFont = NULL;
+			float iconLabelFontSize = 0;
+			float iconLabelWidth = 0;
+			float iconLabelEllipsisWidth = 0;
+
+			// 1 + Formatted_Count widths per entry: the name and the formatted texts, < 0 until measured (see getTextWidth()).
+			// only allocated once the widths are used, they are measured again when the font or its size changes
+			ds::vector<float> textWidths;
+			const ImFont* textWidthsFont = NULL;
+			float textWidthsFontSize = 0;
+
+			enum : uint32_t { NoExt = (uint32_t)-1, NotFormatted = (uint32_t)-1 };
+
+			struct ScoredInd {
+				int score;
+				size_t ind;
+			};
+
+			// which entries pass each filter group (folders always do), computed lazily when a group gets selected
+			ds::vector<ds::bitset> groupMembers;
+			ds::vector<size_t> groupMembersDone; // number of chunks already computed, per group
+			// which entries match the search text
+			ds::bitset searchMatches;
+			size_t searchMatchesDone = 0;
+			// which entries pass all predicates of the search
+			ds::bitset metaMatches;
+			size_t metaMatchesDone = 0;
+
+			// the last sort over all entries, if its first column was the size or a date.
+			// the entries passing a predicate on that column are in one continuous range of it (per folders/files partition),
+			// which can be found with a binary search instead of checking every entry
+			ds::vector<size_t> sortIndex;
+			MetaPredicate::Field sortIndexField = MetaPredicate::Field_Size;
+			bool sortIndexAscending = true;
+			bool sortIndexDirFirst = false;
+
+			// entries removed with removeEntry(). they stay in data, so indices don't change, but never get listed again
+			ds::bitset removed;
+			size_t numRemoved = 0;
+			// the names of the entries (one dir), built on the first findEntry()
+			ds::stringset nameLookup;
+			ds::vector<size_t> nameLookupInds; // index in data for every name of nameLookup, NotFound once it got removed
+
+			bool loadedSucessfully = false;
+			bool ranked = false; // dataModed is ordered by fuzzy search score instead of the table sort
+			bool showingPartial = false; // dataModed only holds the results of the chunks filtered so far (new listing)
+
+			enum {
+				ChunkSize = 1 << 12,         // entries per task, a multiple of 64 so tasks never write to the same bitset word
+				ParallelMinEntries = 1 << 16 // below this, spreading the work over threads isn't worth it
+			};
+
+			// filtering and sorting big directories doesn't have to be done in the frame it was started in,
+			// both stop once the time budget of the frame (settings.workBudgetMs) is used up and continue in the next one.
+			// until they are done, the previous results stay visible
+			double frameWorkTime = 0; // seconds spent on filtering and sorting this frame
+			double workStart = 0;
+
+			struct FilterJob {
+				bool active = false;
+				bool fuzzy = false;
+				size_t chunksDone = 0;
+				FuzzyMatcher matcher;
+				ds::vector<ds::vector<ScoredInd>> chunkScored;
+			};
+			FilterJob filterJob;
+
+			// the automata inside of a FileNameFilter build their DFA while matching, so every thread but the first one gets a copy
+			ds::vector<FileNameFilter> filterCopies;
+
+			// while a sort over multiple frames is going on, the rows that are visible get found first: one pass over all entries
+			// keeps the smallest ones in a heap. they are shown sorted above the still unsorted rest until the sort is done
+			struct PreviewJob {
+				bool active = false;
+				size_t numRows = 0;
+				size_t pos = 0; // next entry of dataModed to go through
+				ds::vector<size_t> heap; // max heap of the numRows smallest entries so far
+			};
+			PreviewJob previewJob;
+			enum { MaxPreviewRows = 1 << 12 }; // more rows than that are sorted faster by the whole sort
+
+			SlicedMergeSort sorter;
+			ds::vector<ImGuiTableColumnSortSpecs> sortColumnSpecs; // copied since imgui's sort specs are only valid during the frame
+			ImGuiTableSortSpecs sortSpecs;
+			bool sortDirFirst = false; // settings.showDirFirst when the sort was started
+
+			enum {
+				SortById = -1,    // column for sorts without any sort specs
+				SortByFolder = -2 // folders first, only used as a key of radixSorter
+			};
+
+			// sorts by the size and date columns are done with radixSorter, as a chain of keys (least significant first)
+			SlicedRadixSort radixSorter;
+			struct RadixKey {
+				int column;
+				bool ascending;
+			};
+			ds::vector<RadixKey> radixKeys;
+
+			// compares entry a and b by one column, in ascending order
+			int compareColumn(int column, size_t a, size_t b) const {
+				switch (column) {
+					case DEIG_NAME: {
+						const uint64_t pa = namePrefixes[a], pb = namePrefixes[b];
+						if (pa != pb)
+							return pa < pb ? -1 : 1;
+						if ((pa & 0xff) == 0) // both keys end within the prefix
+							return 0;
+						if (naturalKeysUsed)
+							return strcmp(&naturalKeys[naturalKeyOffs[a]] + 8, &naturalKeys[naturalKeyOffs[b]] + 8);
+						return strcmp(&foldedNames[foldedNameOffs[a]] + 8, &foldedNames[foldedNameOffs[b]] + 8);
+					}
+					case DEIG_SIZE:          return sizes[a] < sizes[b] ? -1 : sizes[a] > sizes[b];
+					case DEIG_LASTMOD_DATE:  return modTimes[a] < modTimes[b] ? -1 : modTimes[a] > modTimes[b];
+					case DEIG_CREATION_DATE: return createTimes[a] < createTimes[b] ? -1 : createTimes[a] > createTimes[b];
+				}
+				return 0;
+			}
+
+			// the tie breakers after the first sort spec: the other specs, then the id
+			bool lessAfterFirstSpec(size_t a, size_t b) const {
+				for (int i = 1; i < sortSpecs.SpecsCount; i++) {
+					const ImGuiTableColumnSortSpecs& spec = sortSpecs.Specs[i];
+					const int delta = compareColumn(spec.ColumnUserID, a, b);
+					if (delta != 0)
+						return (spec.SortDirection == ImGuiSortDirection_Ascending) ? delta < 0 : delta > 0;
+				}
+				if (ids[a] != ids[b])
+					return (int)ids[a] < (int)ids[b];
+				return a < b;
+			}
+
+			// the order of the last sort, for putting single entries in place
+			bool lessBySortSpecs(size_t a, size_t b) const {
+				if (sortDirFirst) {
+					const bool folderA = folders.get(a);
+					if (folderA != folders.get(b))
+						return folderA;
+				}
+				if (sortSpecs.SpecsCount > 0) {
+					const ImGuiTableColumnSortSpecs& spec = sortSpecs.Specs[0];
+					const int delta = compareColumn(spec.ColumnUserID, a, b);
+					if (delta != 0)
+						return (spec.SortDirection == ImGuiSortDirection_Ascending) ? delta < 0 : delta > 0;
+				}
+				return lessAfterFirstSpec(a, b);
+			}
+
+			struct SortSpecsLess {
+				const EntryManager* em;
+
+				bool operator()(size_t a, size_t b) const {
+					return em->lessBySortSpecs(a, b);
+				}
+			};
+
+			// orders entries by the sort specs (folders first is done by sorting them as a separate segment).
+			// the first spec decides almost every comparison, so its column and direction are template parameters
+			// and its compareColumn() gets inlined without the switch
+			template<int Column, bool Ascending>
+			struct EntryLess {
+				const EntryManager* em;
+
+				bool operator()(size_t a, size_t b) const {
+					const int delta = em->compareColumn(Column, a, b);
+					if (delta != 0)
+						return Ascending ? delta < 0 : delta > 0;
+					return em->lessAfterFirstSpec(a, b);
+				}
+			};
+
+			template<int Column>
+			bool stepSorter(double deadline, size_t numThreads) {
+				if (sortSpecs.Specs[0].SortDirection == ImGuiSortDirection_Ascending)
+					return sorter.step(EntryLess<Column, true>{ this }, deadline, numThreads);
+				return sorter.step(EntryLess<Column, false>{ this }, deadline, numThreads);
+			}
+			struct RadixKeyOf {
+				const EntryManager* em;
+
+				// int64 values get their sign bit flipped, so they order like unsigned ones
+				uint64_t operator()(size_t k, size_t ind) const {
+					const RadixKey& key = em->radixKeys[k];
+					uint64_t v;
+					switch (key.column) {
+						case DEIG_SIZE:          v = (uint64_t)em->sizes[ind] ^ ((uint64_t)1 << 63); break;
+						case DEIG_LASTMOD_DATE:  v = (uint64_t)em->modTimes[ind] ^ ((uint64_t)1 << 63); break;
+						case DEIG_CREATION_DATE: v = (uint64_t)em->createTimes[ind] ^ ((uint64_t)1 << 63); break;
+						case SortByFolder:       v = em->folders.get(ind) ? 0 : 1; break;
+						default:                 v = (uint32_t)em->ids[ind] ^ 0x80000000; break; // like (int)id
+					}
+					return key.ascending ? v : ~v;
+				}
+			};
+
+			// sets up radixSorter if every sort spec is on the size or a date, otherwise returns false
+			bool beginRadixSort() {
+				if (sortSpecs.SpecsCount == 0)
+					return false;
+				for (int i = 0; i < sortSpecs.SpecsCount; i++) {
+					const ImGuiID column = sortSpecs.Specs[i].ColumnUserID;
+					if (column != DEIG_SIZE && column != DEIG_LASTMOD_DATE && column != DEIG_CREATION_DATE)
+						return false;
+				}
+
+				radixKeys.clear();
+				// the id is the last tie breaker, it can be skipped if the entries are in order of it already (fresh listings)
+				bool idOrdered = true;
+				for (size_t i = 1; i < dataModed.size() && idOrdered; i++)
+					idOrdered = (int)ids[dataModed[i-1]] < (int)ids[dataModed[i]];
+				if (!idOrdered)
+					radixKeys.push_back(RadixKey{ SortById, true });
+				for (int i = sortSpecs.SpecsCount - 1; i >= 0; i--)
+					radixKeys.push_back(RadixKey{ (int)sortSpecs.Specs[i].ColumnUserID, sortSpecs.Specs[i].SortDirection == ImGuiSortDirection_Ascending });
+				if (sortDirFirst)
+					radixKeys.push_back(RadixKey{ SortByFolder, true });
+
+				radixSorter.begin(dataModed, radixKeys.size());
+				return true;
+			}
+
+			bool stepSorter(double deadline) {
+				const size_t numThreads = dataModed.size() < ParallelMinEntries ? 1 : getNumThreads();
+				if (sortSpecs.SpecsCount == 0)
+					return sorter.step(EntryLess<SortById, true>{ this }, deadline, numThreads);
+				switch (sortSpecs.Specs[0].ColumnUserID) {
+					case DEIG_NAME:          return stepSorter<DEIG_NAME>(deadline, numThreads);
+					case DEIG_SIZE:          return stepSorter<DEIG_SIZE>(deadline, numThreads);
+					case DEIG_LASTMOD_DATE:  return stepSorter<DEIG_LASTMOD_DATE>(deadline, numThreads);
+					case DEIG_CREATION_DATE: return stepSorter<DEIG_CREATION_DATE>(deadline, numThreads);
+				}
+				return sorter.step(EntryLess<SortById, true>{ this }, deadline, numThreads);
+			}
+
+			// returns the time until which work may be done this frame
+			double beginWork() {
+				workStart = Native::getTime();
+				if (settings.workBudgetMs <= 0)
+					return (double)FLT_MAX;
+				return workStart + settings.workBudgetMs * 0.001 - frameWorkTime;
+			}
+			void endWork() {
+				frameWorkTime += Native::getTime() - workStart;
+			}
+
+			size_t getNumChunks() const {
+				return (data.size() + ChunkSize - 1) / ChunkSize;
+			}
+			size_t getNumThreads() const {
+				if (data.size() < ParallelMinEntries)
+					return 1;
+				return ImMin(Native::getNumThreads(settings.maxThreads > 0 ? (size_t)settings.maxThreads : 0), getNumChunks());
+			}
+
+			// calls func(from, to, threadInd) for every chunk of ChunkSize entries in [chunkFrom, chunkTo), spread over getNumThreads() threads
+			template<typename F>
+			void forEachChunk(F& func, size_t chunkFrom, size_t chunkTo) {
+				struct Job {
+					F* func;
+					size_t chunkFrom;
+					size_t numEntries;
+
+					static void run(void* userData, size_t taskInd, size_t threadInd) {
+						Job* job = (Job*)userData;
+						const size_t from = (job->chunkFrom + taskInd) * ChunkSize;
+						const size_t to = ImMin(from + ChunkSize, job->numEntries);
+						(*job->func)(from, to, threadInd);
+					}
+				};
+				if (chunkFrom >= chunkTo)
+					return;
+				Job job = { &func, chunkFrom, data.size() };
+				Native::parallelFor(chunkTo - chunkFrom, Job::run, &job, getNumThreads());
+			}
+
+			FileNameFilter& getThreadFilter(size_t threadInd) {
+				return threadInd == 0 ? filter : filterCopies[threadInd - 1];
+			}
+
+			// orders by descending score, equal scores keep their order
+			static void sortByScore(ds::vector<ScoredInd>& scored, ds::vector<size_t>* out) {
+				int maxScore = 0;
+				for (size_t i = 0; i < scored.size(); i++) {
+					if (scored[i].score > maxScore)
+						maxScore = scored[i].score;
+				}
+
+				// scores are small integers, so a counting sort is way faster than a comparison sort on big listings
+				ds::vector<size_t> offsets((size_t)maxScore + 2, 0);
+				for (size_t i = 0; i < scored.size(); i++)
+					offsets[(size_t)(maxScore - scored[i].score) + 1]++;
+				for (size_t i = 1; i < offsets.size(); i++)
+					offsets[i] += offsets[i-1];
+
+				out->resize(scored.size());
+				for (size_t i = 0; i < scored.size(); i++)
+					(*out)[offsets[(size_t)(maxScore - scored[i].score)]++] = scored[i].ind;
+			}
+
+			bool passesGroup(FileNameFilter& filter_, size_t i, size_t group) {
+				const char* nameEnd = data[i].name + nameLens[i];
+				return filter_.passesGroup(data[i].name, data[i].isFolder, extOffs[i] != NoExt ? data[i].name + extOffs[i] : NULL, group, nameEnd);
+			}
+
+			const char* getFoldedName(size_t i) const {
+				return &foldedNames[foldedNameOffs[i]];
+			}
+			const char* getFoldedNameEnd(size_t i) const {
+				return &foldedNames[foldedNameOffs[i+1] - 1];
+			}
+
+			// scans all names of the entries [from, to) in one go instead of name by name
+			void findSubstringMatches(const ds::string& text, ds::bitset* out, size_t from, size_t to) {
+				if (from >= to)
+					return;
+
+				const char* names = &foldedNames[0];
+				const size_t namesLen = foldedNameOffs[to];
+
+				size_t pos = foldedNameOffs[from];
+				size_t i = from;
+				while (pos < namesLen) {
+					const char* found = utils::findSubstring(names + pos, namesLen - pos, text.c_str(), text.size());
+					if (!found)
+						break;
+
+					const size_t foundOff = found - names;
+					while (foldedNameOffs[i+1] <= foundOff) // names can't contain '\0', so matches can't span over multiple names
+						i++;
+
+					out->set(i);
+
+					pos = foldedNameOffs[i+1]; // continue with the next name
+					i++;
+				}
+			}
+
+			const int64_t* getMetaColumn(MetaPredicate::Field field) const {
+				switch (field) {
+					case MetaPredicate::Field_Modified: return &modTimes[0];
+					case MetaPredicate::Field_Created:  return &createTimes[0];
+					default:                            return &sizes[0];
+				}
+			}
+
+			// ands the results of pred for the entries [from, to) into out, from has to be a multiple of 64
+			void andPredicate(const MetaPredicate& pred, ds::bitset* out, size_t from, size_t to) const {
+				if (pred.field == MetaPredicate::Field_Type) {
+					const uint64_t folderMask = pred.passes(1) ? ~(uint64_t)0 : 0;
+					const uint64_t fileMask = pred.passes(0) ? ~(uint64_t)0 : 0;
+					for (size_t w = from / 64; w < (to + 63) / 64; w++)
+						out->word(w) &= (folders.word(w) & folderMask) | (~folders.word(w) & fileMask);
+					return;
+				}
+
+				// the columns are padded to a multiple of 64 with values that never pass,
+				// so the inner loop always has the same length and can be vectorized
+				const int64_t* values = getMetaColumn(pred.field);
+				const int64_t lo = pred.lo;
+				const int64_t hi = pred.hi;
+				for (size_t w = from / 64; w < (to + 63) / 64; w++) {
+					const int64_t* wordValues = values + w * 64;
+					uint64_t bits = 0;
+					for (size_t j = 0; j < 64; j++)
+						bits |= (uint64_t)(wordValues[j] >= lo && wordValues[j] <= hi) << j;
+					out->word(w) &= bits;
+				}
+			}
+
+			// first position in [from, to) of sortIndex where isPast(value) is true, it has to be false for all before it
+			template<typename F>
+			size_t findInSortIndex(size_t from, size_t to, const int64_t* values, F isPast) const {
+				while (from < to) {
+					const size_t mid = from + (to - from) / 2;
+					if (isPast(values[sortIndex[mid]]))
+						to = mid;
+					else
+						from = mid + 1;
+				}
+				return from;
+			}
+
+			// sets the bits of all entries passing pred, which has to be on the column of sortIndex
+			void setFromSortIndex(const MetaPredicate& pred, ds::bitset* out) const {
+				const int64_t* values = getMetaColumn(pred.field);
+				const int64_t lo = pred.lo;
+				const int64_t hi = pred.hi;
+
+				const size_t numFolders = sortIndexDirFirst ? folders.count() : 0;
+				const size_t partitions[] = { 0, numFolders, sortIndex.size() };
+				for (size_t p = 0; p < 2; p++) {
+					size_t begin, end;
+					if (sortIndexAscending) {
+						begin = findInSortIndex(partitions[p], partitions[p+1], values, [&](int64_t v) { return v >= lo; });
+						end = findInSortIndex(begin, partitions[p+1], values, [&](int64_t v) { return v > hi; });
+					}
+					else {
+						begin = findInSortIndex(partitions[p], partitions[p+1], values, [&](int64_t v) { return v <= hi; });
+						end = findInSortIndex(begin, partitions[p+1], values, [&](int64_t v) { return v < lo; });
+					}
+					for (size_t i = begin; i < end; i++)
+						out->set(sortIndex[i]);
+				}
+			}
+
+			// gets metaMatches ready for the current predicates. if sortIndex can be used, they are all evaluated right away
+			void beginMetaMatches() {
+				const ds::vector<MetaPredicate>& predicates = filter.getPredicates();
+				size_t indexed = predicates.size();
+				if (data.size() > 0 && sortIndex.size() == data.size()) {
+					for (size_t p = 0; p < predicates.size(); p++) {
+						if (predicates[p].field == sortIndexField) {
+							indexed = p;
+							break;
+						}
+					}
+				}
+
+				if (indexed == predicates.size()) {
+					metaMatches.resize(data.size(), true); // predicates get anded in chunk by chunk
+					return;
+				}
+
+				metaMatches.resize(data.size(), false);
+				setFromSortIndex(predicates[indexed], &metaMatches);
+				for (size_t p = 0; p < predicates.size(); p++) {
+					if (p != indexed)
+						andPredicate(predicates[p], &metaMatches, 0, data.size());
+				}
+				metaMatchesDone = getNumChunks();
+			}
+
+			// keeps the result of a sort over all entries as sortIndex, if it is sorted by the size or a date first
+			void updateSortIndex() {
+				if (dataModed.size() != data.size() || sortSpecs.SpecsCount == 0)
+					return;
+
+				const ImGuiTableColumnSortSpecs& spec = sortSpecs.Specs[0];
+				switch (spec.ColumnUserID) {
+					case DEIG_SIZE:          sortIndexField = MetaPredicate::Field_Size; break;
+					case DEIG_CREATION_DATE: sortIndexField = MetaPredicate::Field_Created; break;
+					case DEIG_LASTMOD_DATE:  sortIndexField = MetaPredicate::Field_Modified; break;
+					default: return;
+				}
+				sortIndex = dataModed;
+				sortIndexAscending = spec.SortDirection == ImGuiSortDirection_Ascending;
+				sortIndexDirFirst = sortDirFirst;
+			}
+
+			// makes dataModed the entries of the first numChunks chunks that pass the group, the search and the predicates
+			void collectPassing(const ds::bitset* group, const ds::bitset* search, const ds::bitset* meta, size_t numChunks) {
+				if (!group && !search && !meta && numRemoved == 0) {
+					const size_t num = ImMin(numChunks * ChunkSize, data.size());
+					dataModed.resize(num);
+					for (size_t i = 0; i < num; i++)
+						dataModed[i] = i;
+					return;
+				}
+
+				// combine both bitsets word by word, count the results of each chunk,
+				// so every chunk knows where in dataModed to write its indices to (prefix sum)
+				auto combinedWord = [&](size_t w) {
+					return (group ? group->word(w) : ~(uint64_t)0) & (search ? search->word(w) : ~(uint64_t)0) & (meta ? meta->word(w) : ~(uint64_t)0)
+						& (numRemoved > 0 ? ~removed.word(w) : ~(uint64_t)0);
+				};
+
+				ds::vector<size_t> chunkOffs(numChunks + 1, 0);
+				auto countChunk = [&](size_t from, size_t to, size_t) {
+					size_t cnt = 0;
+					for (size_t w = from / 64; w < (to + 63) / 64; w++)
+						cnt += ds::popCount64(combinedWord(w));
+					chunkOffs[from / ChunkSize + 1] = cnt;
+				};
+				forEachChunk(countChunk, 0, numChunks);
+
+				for (size_t c = 1; c < chunkOffs.size(); c++)
+					chunkOffs[c] += chunkOffs[c-1];
+				dataModed.resize(chunkOffs.back());
+
+				auto writeChunk = [&](size_t from, size_t to, size_t) {
+					size_t out = chunkOffs[from / ChunkSize];
+					for (size_t w = from / 64; w < (to + 63) / 64; w++) {
+						uint64_t bits = combinedWord(w);
+						while (bits != 0) {
+							dataModed[out++] = w * 64 + ds::countTrailingZeros64(bits);
+							bits &= bits - 1;
+						}
+					}
+				};
+				forEachChunk(writeChunk, 0, numChunks);
+			}
+
+			// continues the filter job until deadline, at least one batch of chunks per call. returns true once it is done
+			bool stepFiltering(double deadline) {
+				const size_t numChunks = getNumChunks();
+
+				size_t* groupDone = NULL;
+				ds::bitset* group = NULL;
+				const size_t groupInd = filter.filterSel;
+				const size_t numGroups = filter.getNumGroups();
+				if (numGroups > 0) {
+					if (groupMembers.size() != numGroups) {
+						groupMembers.clear();
+						groupMembers.resize(numGroups);
+						groupMembersDone = ds::vector<size_t>(numGroups, 0);
+					}
+					group = &groupMembers[groupInd];
+					groupDone = &groupMembersDone[groupInd];
+					if (*groupDone == 0)
+						group->resize(data.size());
+				}
+
+				ds::bitset* search = NULL;
+				const ds::string* substring = NULL;
+				const ds::string* required = NULL;
+				if (!filterJob.fuzzy && filter.hasSearch()) {
+					search = &searchMatches;
+					substring = filter.getSearchSubstring();
+					required = filter.getSearchRequired();
+					if (required && required->size() < 3) // short texts are in too many names to be worth it
+						required = NULL;
+					if (searchMatchesDone == 0)
+						searchMatches.resize(data.size());
+				}
+
+				ds::bitset* meta = NULL;
+				const ds::vector<MetaPredicate>& predicates = filter.getPredicates();
+				if (predicates.size() > 0) {
+					meta = &metaMatches;
+					if (metaMatchesDone == 0)
+						beginMetaMatches();
+				}
+
+				// the group and search results are cached and may be further along than the job
+				auto evalChunk = [&](size_t from, size_t to, size_t threadInd) {
+					const size_t chunk = from / ChunkSize;
+					FileNameFilter& threadFilter = getThreadFilter(threadInd);
+
+					if (group && chunk >= *groupDone) {
+						for (size_t i = from; i < to; i++) {
+							if (passesGroup(threadFilter, i, groupInd))
+								group->set(i);
+						}
+					}
+
+					if (search && chunk >= searchMatchesDone) {
+						if (substring) {
+							findSubstringMatches(*substring, search, from, to);
+						}
+						else if (required) {
+							// only the names containing the required text can match, so only those go through the automaton
+							findSubstringMatches(*required, search, from, to);
+							for (size_t w = from / 64; w < (to + 63) / 64; w++) {
+								uint64_t bits = search->word(w);
+								while (bits != 0) {
+									const size_t i = w * 64 + ds::countTrailingZeros64(bits);
+									if (!threadFilter.passesSearch(getFoldedName(i), getFoldedNameEnd(i)))
+										search->reset(i);
+									bits &= bits - 1;
+								}
+							}
+						}
+						else {
+							for (size_t i = from; i < to; i++) {
+								if (threadFilter.passesSearch(getFoldedName(i), getFoldedNameEnd(i)))
+									search->set(i);
+							}
+						}
+					}
+
+					if (meta && chunk >= metaMatchesDone) {
+						for (size_t p = 0; p < predicates.size(); p++)
+							andPredicate(predicates[p], meta, from, to);
+					}
+
+					if (filterJob.fuzzy) {
+						ds::vector<ScoredInd>& scored = filterJob.chunkScored[chunk];
+						for (size_t i = from; i < to; i++) {
+							if (!filterJob.matcher.mayMatch(nameMasks[i]))
+								continue;
+							if (group && !group->get(i))
+								continue;
+							if (meta && !meta->get(i))
+								continue;
+							if (numRemoved > 0 && removed.get(i))
+								continue;
+
+							const int score = filterJob.matcher.score(data[i].name);
+							if (score != FuzzyMatcher::NoMatch)
+								scored.push_back({ score, i });
+						}
+					}
+				};
+
+				if (!filterJob.fuzzy) {
+					filterJob.chunksDone = numChunks;
+					if (group)
+						filterJob.chunksDone = ImMin(filterJob.chunksDone, *groupDone);
+					if (search)
+						filterJob.chunksDone = ImMin(filterJob.chunksDone, searchMatchesDone);
+					if (meta)
+						filterJob.chunksDone = ImMin(filterJob.chunksDone, metaMatchesDone);
+				}
+
+				const size_t batchSize = getNumThreads();
+				while (filterJob.chunksDone < numChunks) {
+					const size_t to = ImMin(filterJob.chunksDone + batchSize, numChunks);
+					forEachChunk(evalChunk, filterJob.chunksDone, to);
+					filterJob.chunksDone = to;
+					if (group)
+						*groupDone = ImMax(*groupDone, to);
+					if (search)
+						searchMatchesDone = ImMax(searchMatchesDone, to);
+					if (meta)
+						metaMatchesDone = ImMax(metaMatchesDone, to);
+
+					if (Native::getTime() >= deadline)
+						break;
+				}
+
+				if (filterJob.chunksDone < numChunks) {
+					if (showingPartial && !filterJob.fuzzy)
+						collectPassing(group, search, meta, filterJob.chunksDone);
+					return false;
+				}
+
+				if (filterJob.fuzzy) {
+					// concatenate in chunk order, so the result is the same no matter how many threads were used
+					ds::vector<ScoredInd> scored;
+					for (size_t c = 0; c < filterJob.chunkScored.size(); c++) {
+						for (size_t i = 0; i < filterJob.chunkScored[c].size(); i++)
+							scored.push_back(filterJob.chunkScored[c][i]);
+					}
+
+					dataModed.clear();
+					sortByScore(scored, &dataModed);
+				}
+				else {
+					collectPassing(group, search, meta, numChunks);
+				}
+				return true;
+			}
+
+			void continueFiltering() {
+				if (!filterJob.active)
+					return;
+
+				const double deadline = beginWork();
+				if (stepFiltering(deadline)) {
+					filterJob.active = false;
+					filterJob.chunkScored.clear();
+					filterCopies.clear();
+					ranked = filterJob.fuzzy;
+					showingPartial = false;
+					sorted = false;
+				}
+				endWork();
+			}
+
+			// appends the natural sort key of a folded name to out: every run of digits becomes a '0',
+			// the number of digits without leading zeros and those digits, so longer numbers sort after shorter ones.
+			// '0' keeps the position of digits among the other characters, runs of more than 255 digits get split
+			static void buildNaturalKey(const char* name, ds::vector<char>* out) {
+				const char* c = name;
+				while (*c) {
+					if (!utils::isDigitAscii(*c)) {
+						out->push_back(*c++);
+						continue;
+					}
+					while (*c == '0' && utils::isDigitAscii(c[1]))
+						c++;
+					const char* digits = c;
+					while (utils::isDigitAscii(*c) && c - digits < 255)
+						c++;
+					out->push_back('0');
+					out->push_back((char)(uint8_t)(c - digits));
+					for (const char* d = digits; d < c; d++)
+						out->push_back(*d);
+				}
+				out->push_back(0);
+			}
+
+			// (re)builds the keys names get sorted by, if settings.naturalSort changed or force is set
+			void updateNameKeys(bool force) {
+				if (!force && naturalKeysUsed == settings.naturalSort)
+					return;
+				naturalKeysUsed = settings.naturalSort;
+
+				naturalKeys.clear();
+				naturalKeyOffs.clear();
+				if (naturalKeysUsed) {
+					naturalKeys.reserve(foldedNames.size());
+					naturalKeyOffs.resize(data.size());
+					for (size_t i = 0; i < data.size(); i++) {
+						naturalKeyOffs[i] = naturalKeys.size();
+						buildNaturalKey(&foldedNames[foldedNameOffs[i]], &naturalKeys);
+					}
+				}
+
+				namePrefixes.resize(data.size());
+				for (size_t i = 0; i < data.size(); i++)
+					namePrefixes[i] = getNamePrefix(i);
+			}
+			uint64_t getNamePrefix(size_t i) const {
+				const char* key = naturalKeysUsed ? &naturalKeys[naturalKeyOffs[i]] : &foldedNames[foldedNameOffs[i]];
+				uint64_t prefix = 0;
+				bool ended = false;
+				for (size_t c = 0; c < 8; c++) {
+					ended = ended || key[c] == 0;
+					prefix = (prefix << 8) | (ended ? 0 : (uint8_t)key[c]);
+				}
+				return prefix;
+			}
+
+			// forgets all formatted texts, they get formatted again with the current settings when they are used
+			void clearFormatted() {
+				formattedText.resize(0);
+				formattedOffs.resize(0);
+				formattedOffs.resize(data.size() * Formatted_Count, NotFormatted);
+				iconLabels.resize(0);
+				iconLabelInds.resize(0);
+				iconLabelInds.resize(data.size(), NotFormatted);
+				textWidths.resize(0);
+			}
+			// breaks name into lines of at most maxWidth, the last one gets cut off with "..." if the name doesn't fit
+			IconLabel layoutIconLabel(const char* name, float maxWidth) const {
+				ImGuiContext& g = *GImGui;
+				IconLabel label;
+				label.numLines = 0;
+				label.ellipsisX = -1;
+
+				const char* end = name + strlen(name);
+				const char* s = name;
+				while (s < end && label.numLines < MaxIconLabelLines) {
+					const bool lastLine = label.numLines + 1 == MaxIconLabelLines;
+					const char* wrap = g.Font->CalcWordWrapPositionA(g.FontBakedScale, s, end, maxWidth);
+					float lineWidth;
+					if (wrap == s || lastLine)
+						lineWidth = g.Font->CalcTextSizeA(g.FontSize, maxWidth, 0, s, end, &wrap).x;
+					else
+						lineWidth = g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0, s, wrap).x;
+
+					// wrapping skips upcoming blanks
+					while (s < end) {
+						const char c = *s;
+						if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+					}
+
+					const char* lineEnd = wrap;
+					if (lastLine && wrap < end) { // cut off so that the ellipsis fits as well
+						lineWidth = g.Font->CalcTextSizeA(g.FontSize, ImMax(maxWidth - iconLabelEllipsisWidth, 0.0f), 0, s, end, &lineEnd).x;
+						label.ellipsisX = lineWidth;
+						lineWidth += iconLabelEllipsisWidth;
+					}
+					label.lineStart[label.numLines] = (uint32_t)(s - name);
+					label.lineEnd[label.numLines] = (uint32_t)(ImMax(lineEnd, s) - name);
+					label.lineWidth[label.numLines] = lineWidth;
+					label.numLines++;
+					s = wrap;
+				}
+				return label;
+			}
+			// clears the formatted texts if they would look different now
+			void checkFormatSettings() {
+				const char* dateFormat = settings.dateFormat ? settings.dateFormat : "";
+				bool changed = false;
+				if (formattedHumanSizes != settings.humanReadableSizes || strcmp(formattedDateFormat.c_str(), dateFormat) != 0) {
+					formattedHumanSizes = settings.humanReadableSizes;
+					formattedDateFormat = dateFormat;
+					changed = true;
+				}
+				const double now = Native::getTime();
+				if (formattedCheckTime < 0 || now - formattedCheckTime >= 1) { // localtime() isn't free, so the time zone is checked once a second
+					formattedCheckTime = now;
+					const int utcOffset = utils::getUtcOffset();
+					changed = changed || utcOffset != formattedUtcOffset;
+					formattedUtcOffset = utcOffset;
+				}
+				if (changed)
+					clearFormatted();
+			}
+
+			// extends the columns and the complete filter results by the last entry of data
+			void appendEntry() {
+				const size_t i = data.size() - 1;
+				const DirEntry& entry = data[i];
+				const size_t len = strlen(entry.name);
+
+				nameMasks.push_back(FuzzyMatcher::charMask(entry.name));
+				const size_t nameOff = foldedNames.size();
+				unicode::appendKey(entry.name, entry.name + len, &foldedNames);
+				foldedNames.push_back(0);
+				foldedNameOffs.push_back(foldedNames.size());
+				nameLens.push_back((uint32_t)len);
+				const char* ext = utils::getExtension(entry.name, entry.name + len);
+				extOffs.push_back(ext ? (uint32_t)(ext - entry.name) : (uint32_t)NoExt);
+				ids.push_back(entry.id);
+				if (naturalKeysUsed) {
+					naturalKeyOffs.push_back(naturalKeys.size());
+					buildNaturalKey(&foldedNames[nameOff], &naturalKeys);
+				}
+				namePrefixes.push_back(getNamePrefix(i));
+
+				if (i >= sizes.size()) { // padded to a multiple of 64, see andPredicate()
+					const size_t paddedSize = sizes.size() + 64;
+					sizes.resize(paddedSize, -1);
+					modTimes.resize(paddedSize, -1);
+					createTimes.resize(paddedSize, -1);
+				}
+				sizes[i] = (int64_t)entry.size;
+				modTimes[i] = (int64_t)entry.lastModified;
+				createTimes[i] = (int64_t)entry.creationDate;
+				folders.grow(data.size());
+				if (entry.isFolder)
+					folders.set(i);
+				removed.grow(data.size());
+				sortIndex.clear();
+				for (size_t f = 0; f < Formatted_Count; f++)
+					formattedOffs.push_back(NotFormatted);
+				iconLabelInds.push_back(NotFormatted);
+
+				// results that are computed for all entries get the new one too, the others compute it once they are used
+				const size_t oldNumChunks = (i + ChunkSize - 1) / ChunkSize;
+				for (size_t g = 0; g < groupMembers.size(); g++) {
+					if (groupMembersDone[g] == 0)
+						continue;
+					groupMembers[g].grow(data.size());
+					if (groupMembersDone[g] >= oldNumChunks) {
+						if (passesGroup(filter, i, g))
+							groupMembers[g].set(i);
+						groupMembersDone[g] = getNumChunks();
+					}
+				}
+				if (searchMatchesDone > 0) {
+					searchMatches.grow(data.size());
+					if (searchMatchesDone >= oldNumChunks) {
+						if (filter.passesSearch(getFoldedName(i), getFoldedNameEnd(i)))
+							searchMatches.set(i);
+						searchMatchesDone = getNumChunks();
+					}
+				}
+				if (metaMatchesDone > 0) {
+					metaMatches.grow(data.size());
+					if (metaMatchesDone >= oldNumChunks) {
+						if (passesPredicates(entry))
+							metaMatches.set(i);
+						metaMatchesDone = getNumChunks();
+					}
+				}
+			}
+
+			bool passesPredicates(const DirEntry& entry) const {
+				const ds::vector<MetaPredicate>& predicates = filter.getPredicates();
+				for (size_t p = 0; p < predicates.size(); p++) {
+					if (!predicates[p].passes(MetaPredicate::getValue(entry, predicates[p].field)))
+						return false;
+				}
+				return true;
+			}
+			// whether isListed() works for every entry, the results of an empty listing e.g. never got computed
+			bool listedIsKnown() const {
+				const size_t numChunks = getNumChunks();
+				if (filter.getNumGroups() > 0 && (groupMembersDone.size() != filter.getNumGroups() || groupMembersDone[filter.filterSel] < numChunks))
+					return false;
+				if (filter.hasSearch() && searchMatchesDone < numChunks)
+					return false;
+				if (filter.getPredicates().size() > 0 && metaMatchesDone < numChunks)
+					return false;
+				return true;
+			}
+			// whether entry i passes the group, the search and the predicates, all of them have to be computed for it
+			bool isListed(size_t i) const {
+				if (filter.getNumGroups() > 0 && !groupMembers[filter.filterSel].get(i))
+					return false;
+				if (filter.hasSearch() && !searchMatches.get(i))
+					return false;
+				if (filter.getPredicates().size() > 0 && !metaMatches.get(i))
+					return false;
+				return true;
+			}
+
+			// continues previewJob until deadline, returns true once the rows are found and dataModed starts with them
+			bool stepPreview(double deadline) {
+				const SortSpecsLess less = { this };
+				ds::vector<size_t>& heap = previewJob.heap;
+				while (previewJob.pos < dataModed.size()) {
+					const size_t end = ImMin(previewJob.pos + (size_t)ChunkSize, dataModed.size());
+					for (size_t p = previewJob.pos; p < end; p++) {
+						const size_t ind = dataModed[p];
+						if (heap.size() < previewJob.numRows) {
+							heap.push_back(ind);
+							for (size_t c = heap.size() - 1; c > 0 && less(heap[(c - 1) / 2], heap[c]); c = (c - 1) / 2)
+								ImSwap(heap[c], heap[(c - 1) / 2]);
+						}
+						else if (less(ind, heap[0])) {
+							heap[0] = ind;
+							introSortImpl::siftDown(&heap[0], 0, heap.size(), less);
+						}
+					}
+					previewJob.pos = end;
+					if (previewJob.pos < dataModed.size() && Native::getTime() >= deadline)
+						return false;
+				}
+
+				introSortImpl::heapSort(&heap[0], &heap[0] + heap.size(), less);
+				ds::bitset inHeap(data.size());
+				for (size_t i = 0; i < heap.size(); i++)
+					inHeap.set(heap[i]);
+				ds::vector<size_t> order;
+				order.reserve(dataModed.size());
+				for (size_t i = 0; i < heap.size(); i++)
+					order.push_back(heap[i]);
+				for (size_t i = 0; i < dataModed.size(); i++) {
+					if (!inHeap.get(dataModed[i]))
+						order.push_back(dataModed[i]);
+				}
+				dataModed.swap(order); // the sorters work on their own copy
+
+				previewJob.active = false;
+				heap.clear();
+				return true;
+			}
+
+			void continueSorting() {
+				if (!sorter.isActive() && !radixSorter.isActive())
+					return;
+
+				const double deadline = beginWork();
+				if (previewJob.active && !stepPreview(deadline)) {
+					endWork();
+					return;
+				}
+				if (radixSorter.isActive()) {
+					if (radixSorter.step(RadixKeyOf{ this }, deadline)) {
+						radixSorter.getResult(&dataModed);
+						updateSortIndex();
+					}
+				}
+				else if (stepSorter(deadline)) {
+					dataModed.swap(sorter.getResult());
+					updateSortIndex();
+				}
+				endWork();
+			}
+		public:
+			bool sorted = false;
+			FileNameFilter filter;
+
+			EntryManager(const char* filter, const FilterDesc* filterDesc = NULL) : filter(filterDesc ? FileNameFilter(filterDesc) : FileNameFilter(filter)) {
+				
+			}
+
+			// return true if it was able to load the directory
+			bool update(const char* dir) {
+				auto res = Native::loadDirEnts(dir, &loadedSucessfully);
+				if(loadedSucessfully)
+					setEntrysTo(res);
+				return loadedSucessfully;
+			}
+
+			void setEntrysTo(const ds::vector<DirEntry>& src) {
+				data = src;
+
+				nameMasks.resize(data.size());
+				for (size_t i = 0; i < data.size(); i++)
+					nameMasks[i] = FuzzyMatcher::charMask(data[i].name);
+
+				nameLens.resize(data.size());
+				size_t totalLen = 0;
+				for (size_t i = 0; i < data.size(); i++) {
+					nameLens[i] = (uint32_t)strlen(data[i].name);
+					totalLen += nameLens[i] + 1;
+				}
+
+				extOffs.resize(data.size());
+				for (size_t i = 0; i < data.size(); i++) {
+					const char* ext = utils::getExtension(data[i].name, data[i].name + nameLens[i]);
+					extOffs[i] = ext ? (uint32_t)(ext - data[i].name) : (uint32_t)NoExt;
+				}
+
+				// the keys are computed once here, so sorting and searching never have to fold names again
+				foldedNames.resize(0);
+				foldedNames.reserve(totalLen); // as long as the names unless they fold to more bytes
+				foldedNameOffs.resize(data.size() + 1);
+				for (size_t i = 0; i < data.size(); i++) {
+					foldedNameOffs[i] = foldedNames.size();
+					unicode::appendKey(data[i].name, data[i].name + nameLens[i], &foldedNames);
+					foldedNames.push_back(0);
+				}
+				foldedNameOffs[data.size()] = foldedNames.size();
+
+				ids.resize(data.size());
+				for (size_t i = 0; i < data.size(); i++)
+					ids[i] = data[i].id;
+				updateNameKeys(true);
+
+				// padded to a multiple of 64, see andPredicate()
+				const size_t paddedSize = (data.size() + 63) / 64 * 64;
+				sizes.resize(paddedSize);
+				modTimes.resize(paddedSize);
+				createTimes.resize(paddedSize);
+				folders.resize(data.size());
+				for (size_t i = 0; i < paddedSize; i++) {
+					if (i >= data.size()) {
+						sizes[i] = modTimes[i] = createTimes[i] = -1;
+						continue;
+					}
+					sizes[i] = (int64_t)data[i].size;
+					modTimes[i] = (int64_t)data[i].lastModified;
+					createTimes[i] = (int64_t)data[i].creationDate;
+					if (data[i].isFolder)
+						folders.set(i);
+				}
+
+				groupMembers.clear();
+				groupMembersDone.clear();
+				searchMatchesDone = 0;
+				metaMatchesDone = 0;
+				sortIndex.clear();
+				removed.resize(data.size());
+				numRemoved = 0;
+				nameLookup.clear();
+				nameLookupInds.clear();
+				clearFormatted();
+
+				dataModed.clear();
+				ranked = false;
+				showingPartial = true;
+				sorter.cancel();
+				radixSorter.cancel();
+				previewJob.active = false;
+
+				updateFiltering();
+			}
+
+			DirEntry& getRaw(size_t i) {
+				return data[i];
+			}
+			size_t rawSize() const {
+				return data.size();
+			}
+
+			enum FormattedField {
+				Formatted_Size = 0,
+				Formatted_Modified,
+				Formatted_Created,
+				Formatted_Count
+			};
+			// the size or a date of entry i (index into the raw entries) as shown, NULL if it isn't known.
+			// only valid until the next call
+			const char* getFormatted(size_t i, FormattedField field) {
+				const DirEntry& entry = data[i];
+				const int64_t value = field == Formatted_Size ? (int64_t)entry.size : field == Formatted_Modified ? (int64_t)entry.lastModified : (int64_t)entry.creationDate;
+				if (value == -1)
+					return NULL;
+
+				if (formattedCheckTime < 0) // before the first continueWork()
+					checkFormatSettings();
+				uint32_t& off = formattedOffs[i * Formatted_Count + field];
+				if (off == NotFormatted) {
+					char buf[128];
+					if (field == Formatted_Size)
+						utils::formatSize(buf, sizeof(buf), (uint64_t)value, formattedHumanSizes);
+					else
+						utils::formatTime(buf, sizeof(buf), (time_t)value, formattedDateFormat.c_str());
+					off = (uint32_t)formattedText.size();
+					const size_t len = strlen(buf);
+					formattedText.resize(off + len + 1);
+					memcpy(&formattedText[off], buf, len + 1);
+				}
+				return &formattedText[off];
+			}
+
+			enum : size_t { Text_Name = Formatted_Count }; // for getTextWidth(), next to the FormattedFields
+			// the width of the name (Text_Name) or of getFormatted(i, field) of entry i (index into the raw entries) in the current font
+			float getTextWidth(size_t i, size_t field) {
+				ImGuiContext& g = *GImGui;
+				const size_t stride = Formatted_Count + 1;
+				if (g.Font != textWidthsFont || g.FontSize != textWidthsFontSize) {
+					textWidthsFont = g.Font;
+					textWidthsFontSize = g.FontSize;
+					textWidths.resize(0);
+				}
+				if (textWidths.size() < data.size() * stride) // entries were added
+					textWidths.resize(data.size() * stride, -1);
+
+				float& width = textWidths[i * stride + field];
+				if (width < 0) {
+					const char* text = field == Text_Name ? data[i].name : getFormatted(i, (FormattedField)field);
+					width = text ? ImGui::CalcTextSize(text).x : 0;
+				}
+				return width;
+			}
+
+			// the lines entry i (index into the raw entries) is drawn with in the icon mode, for the current font.
+			// all layouts get computed again if the font, its size or maxWidth changes
+			const IconLabel& getIconLabel(size_t i, float maxWidth) {
+				ImGuiContext& g = *GImGui;
+				if (g.Font != iconLabelFont || g.FontSize != iconLabelFontSize || maxWidth != iconLabelWidth) {
+					iconLabelFont = g.Font;
+					iconLabelFontSize = g.FontSize;
+					iconLabelWidth = maxWidth;
+					iconLabelEllipsisWidth = g.Font->CalcTextSizeA(g.FontSize, FLT_MAX, 0, "...").x;
+					iconLabels.resize(0);
+					for (size_t e = 0; e < iconLabelInds.size(); e++)
+						iconLabelInds[e] = NotFormatted;
+				}
+
+				uint32_t& ind = iconLabelInds[i];
+				if (ind == NotFormatted) {
+					ind = (uint32_t)iconLabels.size();
+					iconLabels.push_back(layoutIconLabel(data[i].name, maxWidth));
+				}
+				return iconLabels[ind];
+			}
+
+			enum : size_t { NotFound = (size_t)-1 };
+
+			// index of the entry called name, if it wasn't removed. only works if all entries are in one dir
+			size_t findEntry(const char* name) {
+				if (nameLookupInds.size() == 0 && data.size() > 0) {
+					nameLookupInds = ds::vector<size_t>(data.size(), NotFound);
+					for (size_t i = 0; i < data.size(); i++) {
+						if (!removed.get(i))
+							nameLookupInds[nameLookup.add(data[i].name, strlen(data[i].name))] = i;
+					}
+				}
+				const size_t key = nameLookup.find(name, strlen(name));
+				return key != ds::stringset::NotFound ? nameLookupInds[key] : NotFound;
+			}
+
+			// position of entry i in dataModed, NotFound if it isn't listed. has to be called before its sort keys change
+			size_t findListedPos(size_t i) const {
+				size_t pos = dataModed.size();
+				if (sorted && !ranked) { // first entry that doesn't go before i, which is i itself if it is listed
+					size_t from = 0, to = dataModed.size();
+					while (from < to) {
+						const size_t mid = from + (to - from) / 2;
+						if (lessBySortSpecs(dataModed[mid], i))
+							from = mid + 1;
+						else
+							to = mid;
+					}
+					pos = from;
+				}
+				if (pos >= dataModed.size() || dataModed[pos] != i) {
+					for (pos = 0; pos < dataModed.size(); pos++) {
+						if (dataModed[pos] == i)
+							break;
+					}
+				}
+				return pos < dataModed.size() ? pos : NotFound;
+			}
+			// where entry i goes into dataModed: the first entry after it if sorted, otherwise the end
+			size_t findInsertPos(size_t i) const {
+				if (!sorted)
+					return dataModed.size();
+				size_t from = 0, to = dataModed.size();
+				while (from < to) {
+					const size_t mid = from + (to - from) / 2;
+					if (lessBySortSpecs(i, dataModed[mid]))
+						to = mid;
+					else
+						from = mid + 1;
+				}
+				return from;
+			}
+			void insertListed(size_t pos, size_t i) {
+				dataModed.resize(dataModed.size() + 1);
+				if (pos + 1 < dataModed.size())
+					memmove(&dataModed[pos + 1], &dataModed[pos], (dataModed.size() - 1 - pos) * sizeof(size_t));
+				dataModed[pos] = i;
+			}
+			void eraseListed(size_t pos) {
+				if (pos + 1 < dataModed.size())
+					memmove(&dataModed[pos], &dataModed[pos + 1], (dataModed.size() - 1 - pos) * sizeof(size_t));
+				dataModed.resize(dataModed.size() - 1);
+			}
+
+			// adds a single entry (e.g. a file that just appeared), returns its index.
+			// if the listing is done, the entry gets put in place with a binary search instead of filtering and sorting everything again
+			size_t addEntry(const DirEntry& entry) {
+				data.push_back(entry);
+				const size_t i = data.size() - 1;
+				appendEntry();
+				if (nameLookupInds.size() > 0) {
+					const size_t key = nameLookup.add(entry.name, strlen(entry.name));
+					if (key >= nameLookupInds.size())
+						nameLookupInds.resize(key + 1);
+					nameLookupInds[key] = i;
+				}
+
+				if (isBusy() || ranked || showingPartial || !listedIsKnown()) {
+					updateFiltering();
+					return i;
+				}
+				if (isListed(i))
+					insertListed(findInsertPos(i), i);
+				return i;
+			}
+
+			// takes over the size and dates of entry (e.g. the file i was written to). i keeps its index and id,
+			// if the listing is done it only moves to its new place instead of filtering and sorting everything again
+			void updateEntry(size_t i, const DirEntry& entry) {
+				const bool done = !isBusy() && !showingPartial;
+				const size_t pos = done ? findListedPos(i) : NotFound; // still with the old sort keys
+
+				DirEntry& dst = data[i];
+				dst.size = entry.size;
+				dst.lastModified = entry.lastModified;
+				dst.creationDate = entry.creationDate;
+				sizes[i] = (int64_t)entry.size;
+				modTimes[i] = (int64_t)entry.lastModified;
+				createTimes[i] = (int64_t)entry.creationDate;
+				for (size_t f = 0; f < Formatted_Count; f++)
+					formattedOffs[i * Formatted_Count + f] = NotFormatted;
+				sortIndex.clear();
+				if (i / ChunkSize < metaMatchesDone) {
+					if (passesPredicates(dst))
+						metaMatches.set(i);
+					else
+						metaMatches.reset(i);
+				}
+
+				if (!done || !listedIsKnown()) {
+					updateFiltering();
+					return;
+				}
+				const bool listed = isListed(i);
+				if (ranked) { // the rank only depends on the name, a new score is only needed if it wasn't listed before
+					if (listed && pos == NotFound)
+						updateFiltering();
+					else if (!listed && pos != NotFound)
+						eraseListed(pos);
+					return;
+				}
+				if (pos != NotFound)
+					eraseListed(pos);
+				if (listed)
+					insertListed(sorted || pos == NotFound ? findInsertPos(i) : pos, i);
+			}
 
-			bool loadedSucessfully = false;
-		public:
-			bool sorted = false;
-			FileNameFilter filter;
+			// appends src[from, src.size()) (e.g. the new results of a search), the entries that are there already keep their indices.
+			// if the listing is done, only the new entries get sorted and are merged into it
+			void appendEntrys(const ds::vector<DirEntry>& src, size_t from) {
+				const size_t first = data.size();
+				for (size_t s = from; s < src.size(); s++) {
+					data.push_back(src[s]);
+					appendEntry();
+				}
+				nameLookup.clear(); // built again by findEntry() once it is needed
+				nameLookupInds.clear();
 
-			EntryManager(const char* filter) : filter(filter) {
-				
+				if (isBusy() || ranked || showingPartial || !listedIsKnown()) {
+					updateFiltering();
+					return;
+				}
+
+				ds::vector<size_t> added;
+				for (size_t i = first; i < data.size(); i++) {
+					if (isListed(i))
+						added.push_back(i);
+				}
+				if (added.size() == 0)
+					return;
+				if (!sorted) {
+					for (size_t a = 0; a < added.size(); a++)
+						dataModed.push_back(added[a]);
+					return;
+				}
+
+				const SortSpecsLess less = { this };
+				introSort(&added[0], &added[0] + added.size(), less);
+				ds::vector<size_t> merged;
+				merged.reserve(dataModed.size() + added.size());
+				size_t m = 0, a = 0;
+				while (m < dataModed.size() || a < added.size()) {
+					if (a == added.size() || (m < dataModed.size() && !less(added[a], dataModed[m])))
+						merged.push_back(dataModed[m++]);
+					else
+						merged.push_back(added[a++]);
+				}
+				dataModed.swap(merged);
 			}
 
-			// return true if it was able to load the directory
-			bool update(const char* dir) {
-				auto res = Native::loadDirEnts(dir, &loadedSucessfully);
-				if(loadedSucessfully)
-					setEntrysTo(res);
-				return loadedSucessfully;
+			// removes a single entry from the listing, the other indices stay valid
+			void removeEntry(size_t i) {
+				if (removed.get(i))
+					return;
+				removed.set(i);
+				numRemoved++;
+				if (nameLookupInds.size() > 0) {
+					const size_t key = nameLookup.find(data[i].name, strlen(data[i].name));
+					if (key != ds::stringset::NotFound && nameLookupInds[key] == i)
+						nameLookupInds[key] = NotFound;
+				}
+
+				if (isBusy() || showingPartial) {
+					updateFiltering();
+					return;
+				}
+
+				const size_t pos = findListedPos(i);
+				if (pos != NotFound)
+					eraseListed(pos);
 			}
 
-			void setEntrysTo(const ds::vector<DirEntry>& src) {
-				data = src;
-				updateFiltering();
+			size_t getNumRemoved() const {
+				return numRemoved;
 			}
 
-			DirEntry& getRaw(size_t i) {
-				return data[i];
+			// drops the removed entries for good, which changes the indices of the others
+			void compact() {
+				ds::vector<DirEntry> live;
+				live.reserve(data.size() - numRemoved);
+				for (size_t i = 0; i < data.size(); i++) {
+					if (!removed.get(i))
+						live.push_back(data[i]);
+				}
+				setEntrysTo(live);
 			}
 
 			DirEntry& get(size_t i) {
@@ -610,31 +5875,77 @@ namespace ImGuiFD {
 			}
 
 			void updateFiltering() {
-				dataModed.clear();
-				for (size_t i = 0; i < data.size(); i++) {
-					if (filter.passes(data[i].name, data[i].isFolder)) {
-						dataModed.push_back(i);
-					}
+				if (filter.updateSearch()) {
+					searchMatchesDone = 0;
+					metaMatchesDone = 0;
 				}
-				sorted = false;
-			}
 
-			void sort(ImGuiTableSortSpecs* sorts_specs) {
-				globalSortSpecs = sorts_specs;
-				globalSortData = &data;
+				filterJob.active = true;
+				filterJob.fuzzy = settings.fuzzySearch && filter.getSearchName().size() > 0 && !filter.isRegexSearch();
+				filterJob.chunksDone = 0;
+				filterJob.chunkScored.clear();
+				if (filterJob.fuzzy) {
+					filterJob.matcher.setPattern(filter.getSearchName().c_str());
+					filterJob.chunkScored.resize(getNumChunks());
+				}
 
-				if(dataModed.size() > 1)
-					qsort(&dataModed[0], dataModed.size(), sizeof(dataModed[0]), compareSortSpecs);
-				
-				globalSortSpecs = 0;
-				globalSortData = 0;
+				const size_t numThreads = getNumThreads();
+				filterCopies = ds::vector<FileNameFilter>(numThreads > 1 ? numThreads - 1 : 0, filter);
 
+				sorter.cancel(); // dataModed is going to change anyways
+				radixSorter.cancel();
+				previewJob.active = false;
+
+				continueFiltering();
+			}
+
+			// numVisibleRows: the rows up to the bottom of the view, they get sorted first if the sort takes multiple frames
+			void sort(ImGuiTableSortSpecs* sorts_specs, size_t numVisibleRows = 0) {
+				if (ranked) { // keep the ranking of the fuzzy search
+					sorted = true;
+					return;
+				}
+				if (filterJob.active) // gets sorted once filtering is done
+					return;
+
+				sortColumnSpecs.resize((size_t)sorts_specs->SpecsCount);
+				for (int i = 0; i < sorts_specs->SpecsCount; i++)
+					sortColumnSpecs[(size_t)i] = sorts_specs->Specs[i];
+				sortSpecs.Specs = sortColumnSpecs.size() > 0 ? &sortColumnSpecs[0] : NULL;
+				sortSpecs.SpecsCount = sorts_specs->SpecsCount;
+				sortDirFirst = settings.showDirFirst;
+				updateNameKeys(false);
+
+				sorter.cancel();
+				radixSorter.cancel();
+				previewJob.active = false;
+				if (!beginRadixSort())
+					sorter.begin(dataModed, sortDirFirst ? &folders : NULL);
 				sorted = true;
+
+				previewJob.active = settings.workBudgetMs > 0 && dataModed.size() >= ParallelMinEntries && numVisibleRows > 0 && numVisibleRows <= MaxPreviewRows;
+				previewJob.numRows = numVisibleRows;
+				previewJob.pos = 0;
+				previewJob.heap.clear();
+
+				continueSorting();
 			}
 
-			void drawSeachBar(float width = -1) {
-				if (filter.draw(width))
-					updateFiltering();
+			// call once per frame, continues filtering and sorting that didn't fit into the time budget of the previous frames
+			void continueWork() {
+				frameWorkTime = 0;
+				checkFormatSettings();
+				continueFiltering();
+				continueSorting();
+			}
+
+			bool isBusy() const {
+				return filterJob.active || sorter.isActive() || radixSorter.isActive();
+			}
+
+			// returns true if the search text or the filter changed
+			bool drawSeachBar(float width = -1) {
+				return filter.draw(width);
 			}
 
 			bool wasLoadedSuccesfully() const {
@@ -646,6 +5957,8 @@ namespace ImGuiFD {
 
 		size_t lastSelected = (size_t)-1;
 		ds::set<size_t> selected;
+		size_t tableRowsShown = 0; // end of the rows the table showed last frame
+		size_t tablePressedRow = (size_t)-1; // row the mouse went down on, when the rows are drawn by DrawDirFiles_TableRowsFast()
 
 		ImGuiFDMode mode;
 		bool isModal = false;
@@ -659,6 +5972,12 @@ namespace ImGuiFD {
 		size_t renameId = (size_t)-1;
 
 		bool needsEntrysUpdate = false;
+		bool searchEverywhere = false; // showing the results of the name index instead of the current dir
+		bool searchSubfolders = false; // showing the results of subtreeSearch instead of the current dir
+		SubtreeSearch subtreeSearch;
+		bool searchContents = false; // showing the results of contentSearch, the files of the current dir containing a text
+		ContentSearch contentSearch;
+		ds::vector<DirEntry> contentListing; // the current dir, the candidates of contentSearch are taken from here
 
 		bool actionDone = false;
 		bool selectionMade = false;
@@ -667,12 +5986,13 @@ namespace ImGuiFD {
 
 		ds::vector<ds::pair<ds::string,ds::string>> inputStrs;
 
-		FileDialog(ImGuiID id, const char* str_id, const char* filter, const char* path, ImGuiFDMode mode, ImGuiFDDialogFlags flags = 0, size_t maxSelections = 1) : 
+		// filterDesc is used instead of filter if set
+		FileDialog(ImGuiID id, const char* str_id, const char* filter, const FilterDesc* filterDesc, const char* path, ImGuiFDMode mode, ImGuiFDDialogFlags flags = 0, size_t maxSelections = 1) : 
 			str_id(str_id), id(id), path(utils::fixDirStr(Native::getAbsolutePath(path).c_str())), 
 			currentPath(this->path.c_str()), oldPath(this->path),
 			undoStack(32), redoStack(32),
-			entrys(filter),
-			mode(mode), isModal((flags&ImGuiFDDialogFlags_Modal)!=0), hasFilter(filter != NULL), maxSelections(maxSelections)
+			entrys(filter, filterDesc),
+			mode(mode), isModal((flags&ImGuiFDDialogFlags_Modal)!=0), hasFilter(filter != NULL || filterDesc != NULL), maxSelections(maxSelections)
 		{
 			updateEntrys();
 			setInputTextToSelected();
@@ -722,7 +6042,11 @@ namespace ImGuiFD {
 				for (size_t i = 0; i < selected.size(); i++) {
 					if(i>0)
 						inputText += "\", \"";
-					inputText += entrys.getRaw(selected[i]).name;
+					const DirEntry& entry = entrys.getRaw(selected[i]);
+					if (listsOtherDirs()) // not in the current dir
+						inputText += ds::string(entry.dir) + entry.name;
+					else
+						inputText += entry.name;
 				}
 				inputText += "\"";
 			}
@@ -737,12 +6061,39 @@ namespace ImGuiFD {
 		}
 		
 		void update() {
+			entrys.continueWork();
+
+			if (searchSubfolders && subtreeSearch.isActive()) {
+				const double deadline = settings.workBudgetMs > 0 ? Native::getTime() + settings.workBudgetMs * 0.001 : (double)FLT_MAX;
+				if (subtreeSearch.continueWork(deadline))
+					entrys.appendEntrys(subtreeSearch.getResults(), entrys.rawSize()); // shown in this frame already
+			}
+			if (searchContents && contentSearch.isActive()) {
+				const double deadline = settings.workBudgetMs > 0 ? Native::getTime() + settings.workBudgetMs * 0.001 : (double)FLT_MAX;
+				if (contentSearch.continueWork(deadline))
+					entrys.appendEntrys(contentSearch.getResults(), entrys.rawSize());
+			}
+
 			if (needsEntrysUpdate) {
 				needsEntrysUpdate = false;
 				updateEntrys();
 				setInputTextToSelected();
 			}
 		}
+		// the name index already has the entries of dir as they are listed now, so indexing them again would only grow it
+		bool indexHasListing(const ds::string& dir) {
+			size_t first = 0;
+			if (nameIndex.getDirEntries(dir.c_str(), &first) != entrys.rawSize())
+				return false;
+			for (size_t i = 0; i < entrys.rawSize(); i++) {
+				const DirEntry& entry = entrys.getRaw(i);
+				size_t len;
+				const char* name = nameIndex.getName(first + i, &len);
+				if (nameIndex.isFolder(first + i) != entry.isFolder || len != strlen(entry.name) || memcmp(name, entry.name, len) != 0)
+					return false;
+			}
+			return true;
+		}
 		void updateEntrys() {
 			ds::string curDirStr = currentPath.toString();
 			if (entrys.update(curDirStr.c_str())) {
@@ -753,6 +6104,25 @@ namespace ImGuiFD {
 				lastSelected = (size_t)-1;
 				selected.clear();
 				oldPath = curDirStr;
+				nextNewId = (ImGuiID)((ImHashStr(curDirStr.c_str()) << 16) + entrys.rawSize() + 2); // the listing counts "." and ".." too
+				searchEverywhere = false;
+				searchSubfolders = false;
+				subtreeSearch.cancel();
+				searchContents = false;
+				contentSearch.cancel();
+				contentListing.clear();
+
+				if (settings.indexVisitedDirs && !indexHasListing(curDirStr)) {
+					nameIndex.beginDir(curDirStr.c_str());
+					for (size_t i = 0; i < entrys.rawSize(); i++) {
+						const DirEntry& entry = entrys.getRaw(i);
+						nameIndex.addEntry(entry.name, strlen(entry.name), entry.isFolder);
+					}
+					nameIndex.endDir();
+				}
+
+				if (entrys.filter.getContentText().size() > 0)
+					updateContents();
 			}
 			else {
 				showLoadErrorMsg = true;
@@ -761,7 +6131,190 @@ namespace ImGuiFD {
 			}
 		}
 		void updateFiltering() {
-			entrys.updateFiltering();
+			if (searchEverywhere)
+				updateEverywhere();
+			else if (searchSubfolders)
+				updateSubfolders();
+			else if (searchContents || (entrys.filter.updateSearch(), entrys.filter.getContentText().size() > 0))
+				updateContents();
+			else
+				entrys.updateFiltering();
+		}
+		bool listsOtherDirs() const {
+			return searchEverywhere || searchSubfolders;
+		}
+
+		// name (an entry of the current dir) got created, deleted or modified, only that entry of the listing gets updated
+		void entryChanged(const char* name) {
+			if (listsOtherDirs() || searchContents) // not showing the current dir, it gets loaded again when going back to it
+				return;
+
+			const size_t old = entrys.findEntry(name);
+			const ds::string path = oldPath + name;
+			const bool exists = Native::fileExists(path.c_str());
+			DirEntry entry;
+			if (exists) {
+				entry.isFolder = Native::isValidDir(path.c_str());
+				entry.name = ImStrdup(name);
+				entry.dir = ImStrdup(oldPath.c_str());
+				entry.path = ImStrdup(entry.isFolder ? (path + "/").c_str() : path.c_str());
+				Native::statDirEnt(&entry);
+			}
+
+			if (old != EntryManager::NotFound) {
+				fileDataCache.remove(entrys.getRaw(old).id);
+				if (exists && entry.isFolder == entrys.getRaw(old).isFolder) { // modified, it stays the same entry
+					entrys.updateEntry(old, entry);
+					return;
+				}
+			}
+
+			const bool wasSelected = old != EntryManager::NotFound && selected.contains(old);
+			const bool wasLastSelected = old != EntryManager::NotFound && lastSelected == old;
+			if (old != EntryManager::NotFound) {
+				if (wasLastSelected)
+					lastSelected = (size_t)-1;
+				if (wasSelected)
+					selected.eraseItem(old);
+				entrys.removeEntry(old);
+			}
+
+			if (exists) {
+				entry.id = old != EntryManager::NotFound ? entrys.getRaw(old).id : nextNewId++;
+				const size_t added = entrys.addEntry(entry);
+				if (wasSelected)
+					selected.add(added);
+				if (wasLastSelected)
+					lastSelected = added;
+			}
+			if (wasSelected)
+				setInputTextToSelected();
+
+			// removed entries stay in memory until the listing gets compacted, which changes the indices of the selection
+			if (entrys.getNumRemoved() > 1024 && entrys.getNumRemoved() * 4 > entrys.rawSize()) {
+				ds::vector<ds::string> selectedNames;
+				for (size_t i = 0; i < selected.size(); i++)
+					selectedNames.push_back(entrys.getRaw(selected[i]).name);
+				entrys.compact();
+				selected.clear();
+				lastSelected = (size_t)-1;
+				for (size_t i = 0; i < selectedNames.size(); i++) {
+					const size_t ind = entrys.findEntry(selectedNames[i].c_str());
+					if (ind != EntryManager::NotFound)
+						selected.add(ind);
+				}
+			}
+		}
+		// restarts the search in the files of the current dir passing the filter, the results get streamed in by update()
+		void updateContents() {
+			entrys.filter.updateSearch();
+			const ds::string& text = entrys.filter.getContentText();
+			if (text.size() == 0) { // "contains:" got removed, back to the whole dir
+				searchContents = false;
+				contentSearch.cancel();
+				entrys.setEntrysTo(contentListing);
+				contentListing.clear();
+			}
+			else {
+				if (!searchContents) {
+					searchContents = true;
+					contentListing.clear();
+					contentListing.reserve(entrys.rawSize());
+					for (size_t i = 0; i < entrys.rawSize(); i++)
+						contentListing.push_back(entrys.getRaw(i));
+				}
+
+				// names are checked first, so e.g. "*.log" or "size:<1M" cut down what has to be read
+				ds::vector<DirEntry> candidates;
+				ds::vector<char> foldedName;
+				for (size_t i = 0; i < contentListing.size(); i++) {
+					const DirEntry& entry = contentListing[i];
+					if (!entry.isFolder && entrys.filter.passesEntry(entry, &foldedName))
+						candidates.push_back(entry);
+				}
+				contentSearch.begin(candidates, text);
+				entrys.setEntrysTo(ds::vector<DirEntry>());
+			}
+
+			// the selection holds indices into the entries that just got replaced
+			fileDataCache.clear();
+			lastSelected = (size_t)-1;
+			selected.clear();
+			setInputTextToSelected();
+		}
+		// restarts the search below the current dir, the results get streamed in by update()
+		void updateSubfolders() {
+			entrys.filter.updateSearch();
+			subtreeSearch.begin(currentPath.toString().c_str(), entrys.filter);
+			entrys.setEntrysTo(ds::vector<DirEntry>());
+
+			fileDataCache.clear();
+			lastSelected = (size_t)-1;
+			selected.clear();
+			setInputTextToSelected();
+		}
+		// replaces the entries with the names in nameIndex matching the search text
+		void updateEverywhere() {
+			enum : size_t { MaxResults = 10000 };
+
+			FileNameFilter& filter = entrys.filter;
+			filter.updateSearch();
+			const ds::string* text = filter.getSearchSubstring();
+			if (!text)
+				text = filter.getSearchRequired(); // the regex gets checked afterwards by the normal filtering
+			const bool hasPredicates = filter.getPredicates().size() > 0;
+
+			// the index only knows names, the sizes and dates for the predicates are read from the files
+			ds::vector<DirEntry> res;
+			auto addResult = [&](size_t ind) {
+				size_t len;
+				const char* name = nameIndex.getName(ind, &len);
+				const ds::string& dir = nameIndex.getDir(ind);
+
+				char* nameStr = (char*)IM_ALLOC(len + 1);
+				memcpy(nameStr, name, len);
+				nameStr[len] = 0;
+
+				res.push_back(DirEntry());
+				DirEntry& entry = res.back();
+				entry.id = (ImGuiID)ind;
+				entry.name = nameStr;
+				entry.dir = ImStrdup(dir.c_str());
+				entry.isFolder = nameIndex.isFolder(ind);
+				entry.path = ImStrdup((dir + nameStr + (entry.isFolder ? "/" : "")).c_str());
+				if (hasPredicates)
+					Native::statDirEnt(&entry);
+			};
+
+			if (text && text->size() > 0) {
+				ds::vector<size_t> found;
+				nameIndex.find(text->c_str(), MaxResults, &found);
+				for (size_t i = 0; i < found.size(); i++)
+					addResult(found[i]);
+			}
+			else if (filter.getSearchName().size() > 0 || hasPredicates) {
+				// nothing every match has to contain (e.g. just a glob or predicates), so every name gets checked
+				ds::vector<char> foldedName;
+				for (size_t i = 0; i < nameIndex.numEntries() && res.size() < MaxResults; i++) {
+					if (nameIndex.isRemoved(i))
+						continue;
+					size_t len;
+					const char* name = nameIndex.getName(i, &len);
+					foldedName.clear();
+					unicode::appendKey(name, name + len, &foldedName);
+					if (!filter.passesSearch(foldedName.data(), foldedName.data() + foldedName.size()))
+						continue;
+					addResult(i);
+					if (!filter.passesEntry(res.back(), &foldedName))
+						res.resize(res.size() - 1);
+				}
+			}
+			entrys.setEntrysTo(res);
+
+			fileDataCache.clear();
+			lastSelected = (size_t)-1;
+			selected.clear();
+			setInputTextToSelected();
 		}
 
 		bool canUndo() const {
@@ -809,65 +6362,17 @@ namespace ImGuiFD {
 	FileDialog* fd = 0;
 	ds::map<FileDialog> openDialogs;
 
-	static ImRect TextWrappedCentered(const char* text, float maxWidth, int maxLines = -1) {
-		ImGuiContext& g = *GImGui;
-		ImVec2 cursorStart = ImGui::GetCursorPos();
-
-		size_t len = strlen(text);
-
-		const char* s = text;
-		int lineInd = 0;
-
-		ImVec2 minPos(10000,10000), maxPos(-10000,-10000);
-
-		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { 0,0 });
-		while (s < text + len && lineInd < maxLines) {
-			const char* wrap = g.Font->CalcWordWrapPositionA(g.FontBakedScale, s, text+len, maxWidth);
-			
-			ImVec2 lineSize;
-			if (wrap == s || lineInd+1 == maxLines) {
-				lineSize = g.Font->CalcTextSizeA(g.FontSize, maxWidth, 0, s, text + len, &wrap);
-			}
-			else {
-				lineSize = ImGui::CalcTextSize(s, wrap);
-			}
-
-			// Wrapping skips upcoming blanks
-			while (s < text+len)
-			{
-				const char c = *s;
-				if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
-			}
-
-			{
-				const ImVec2 cursorPos = cursorStart + ImVec2{ maxWidth / 2 - lineSize.x / 2, ImGui::GetTextLineHeightWithSpacing() * lineInd };
-				if (cursorPos.x < minPos.x) minPos.x = cursorPos.x;
-				if (cursorPos.y < minPos.y) minPos.y = cursorPos.y;
-
-				if ((cursorPos+lineSize).x > maxPos.x) maxPos.x = (cursorPos+lineSize).x;
-				if ((cursorPos+lineSize).y > maxPos.y) maxPos.y = (cursorPos+lineSize).y;
-
-
-				ImGui::SetCursorPos(cursorPos);
-				if (lineInd + 1 >= maxLines && wrap < text+len) {
-					ImGui::RenderTextEllipsis(ImGui::GetWindowDrawList(), ImGui::GetCursorScreenPos(), ImGui::GetCursorScreenPos() + lineSize + ImVec2{0,g.Style.FramePadding.y}, ImGui::GetCursorScreenPos().x + maxWidth, s, text + len, 0);
-				}
-				else {
-					ImGui::TextUnformatted(s, wrap);
-				}
-			}
-			
-
-			s = wrap;
-			lineInd++;
+	// draws the lines of label centered in maxWidth, starting at the cursor
+	static void DrawIconLabel(const char* name, const FileDialog::EntryManager::IconLabel& label, float maxWidth) {
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		const ImU32 col = ImGui::GetColorU32(ImGuiCol_Text);
+		const ImVec2 start = ImGui::GetCursorScreenPos();
+		for (uint32_t l = 0; l < label.numLines; l++) {
+			const ImVec2 pos = start + ImVec2{ maxWidth / 2 - label.lineWidth[l] / 2, ImGui::GetTextLineHeight() * l };
+			drawList->AddText(pos, col, name + label.lineStart[l], name + label.lineEnd[l]);
+			if (l + 1 == label.numLines && label.ellipsisX >= 0)
+				drawList->AddText(pos + ImVec2{ label.ellipsisX, 0 }, col, "...");
 		}
-		ImGui::PopStyleVar();
-
-		// convert to screen space
-		minPos += ImGui::GetWindowPos() - ImVec2{ImGui::GetScrollX(), ImGui::GetScrollY()};
-		maxPos += ImGui::GetWindowPos() - ImVec2{ImGui::GetScrollX(), ImGui::GetScrollY()};
-
-		return ImRect(minPos, maxPos);
 	}
 	static bool ComboVertical(const char* str_id, size_t* v, const char** labels, size_t labelCnt, const ImVec2& size_arg = { 0,0 }) {
 		ImGui::PushID(str_id);
@@ -902,14 +6407,6 @@ namespace ImGuiFD {
 		return changed;
 	}
 
-	static void formatTime(char* buf, size_t bufSize, time_t unixTime) {
-		tm* tm = localtime(&unixTime);
-		strftime(buf, bufSize, "%d.%m.%y %H:%M", tm);
-	}
-	static void formatSize(char* buf, size_t bufSize, uint64_t size) {
-		snprintf(buf, bufSize, "%" PRIu64 " Bytes", size);
-	}
-
 	static void OpenNow() {
 		fd->inputStrs = utils::splitInput(fd->inputText.c_str(), fd->currentPath.toString().c_str());
 
@@ -973,7 +6470,10 @@ namespace ImGuiFD {
 	static void CheckDoubleClick(const DirEntry& entry) {
 		if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
 			if (entry.isFolder) {
-				fd->dirMoveDownInto(entry.name);
+				if (fd->listsOtherDirs())
+					fd->dirSetTo(entry.path);
+				else
+					fd->dirMoveDownInto(entry.name);
 			}
 			else {
 				if (fd->mode == ImGuiFDMode_LoadFile) {
@@ -987,6 +6487,17 @@ namespace ImGuiFD {
 	static void DrawSettings() {
 		ImGui::Checkbox("Show dir first", &settings.showDirFirst);
 		ImGui::Checkbox("Adjust icon width", &settings.adjustIconWidth);
+		ImGui::Checkbox("Fast list rows", &settings.fastTableRows);
+		if (ImGui::Checkbox("Natural sort", &settings.naturalSort))
+			fd->entrys.sorted = false;
+		if (ImGui::Checkbox("Fuzzy search", &settings.fuzzySearch))
+			fd->updateFiltering();
+#ifdef IMGUIFD_ENABLE_THREADS
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+		ImGui::DragInt("Max threads (0 = all cores)", &settings.maxThreads, 0.1f, 0, 256);
+#endif
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+		ImGui::DragFloat("Work budget per frame (ms, 0 = no limit)", &settings.workBudgetMs, 0.1f, 0, 100);
 
 		ImGui::Separator();
 
@@ -1001,6 +6512,26 @@ namespace ImGuiFD {
 
 		ImGui::ColorEdit4("Icon text color", (float*)&settings.iconTextCol);
 		ImGui::Checkbox("Ascii art icons", &settings.asciiArtIcons);
+
+		ImGui::Separator();
+
+		// the cached texts are formatted again on the next frame, see EntryManager::checkFormatSettings()
+		ImGui::Checkbox("Human readable sizes", &settings.humanReadableSizes);
+		static const char* const dateFormats[] = { "%d.%m.%y %H:%M", "%Y-%m-%d %H:%M", "%m/%d/%Y %I:%M %p", "%c" };
+		const time_t now = time(NULL);
+		char example[128];
+		utils::formatTime(example, sizeof(example), now, settings.dateFormat ? settings.dateFormat : "");
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 12);
+		if (ImGui::BeginCombo("Date format", example)) {
+			for (size_t i = 0; i < sizeof(dateFormats) / sizeof(dateFormats[0]); i++) {
+				utils::formatTime(example, sizeof(example), now, dateFormats[i]);
+				ImGui::PushID((int)i);
+				if (ImGui::Selectable(example, settings.dateFormat && strcmp(settings.dateFormat, dateFormats[i]) == 0))
+					settings.dateFormat = dateFormats[i];
+				ImGui::PopID();
+			}
+			ImGui::EndCombo();
+		}
 	}
 
 
@@ -1038,7 +6569,6 @@ namespace ImGuiFD {
 		const ImVec2 borderPad(2, 2);
 		const ImRect rec(ImGui::GetCursorScreenPos(), ImGui::GetCursorScreenPos() + ImVec2(width, ImGui::GetFrameHeight()));
 		const ImRect recOuter(rec.Min - borderPad, rec.Max + borderPad);
-		ImGuiStyle& style = ImGui::GetStyle();
 
 		ImGui::PushStyleVar(ImGuiStyleVar_ScrollbarSize, 1);
 		ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, { 0,0 });
@@ -1061,20 +6591,8 @@ namespace ImGuiFD {
 			float totalWidth = 0;
 			size_t lastToFit = (size_t)-1; // including the ... button
 			
-			if (!fd->forceDisplayAllDirs) {
-				for (ptrdiff_t i = fd->currentPath.parts.size()-1; i >= 0; i--) {
-					const float label_size = ImGui::CalcTextSize(fd->currentPath.parts[i].c_str(), NULL, true).x;
-					float nextWidth = totalWidth + (label_size + style.FramePadding.x * 2.0f) + style.ItemSpacing.x;
-
-					if (totalWidth <= width && nextWidth > width) {
-						lastToFit = i;
-						totalWidth = nextWidth;
-						break;
-					}
-
-					totalWidth = nextWidth;
-				}
-			}
+			if (!fd->forceDisplayAllDirs)
+				lastToFit = fd->currentPath.findLastToFit(width, &totalWidth);
 
 			//ImGui::GetWindowDrawList()->AddRect(ImGui::GetCursorScreenPos(), ImGui::GetCursorScreenPos() + ImVec2(totalWidth, ImGui::GetTextLineHeight()), IM_COL32(255, 0, 0, 255));
 
@@ -1082,7 +6600,6 @@ namespace ImGuiFD {
 
 			
 			size_t startOn = 0;
-			const float ellipseBtnWidth = ImGui::CalcTextSize("...").x + style.FramePadding.x * 2 + style.ItemSpacing.x;
 			if (doesntFit) {
 				startOn = lastToFit;
 
@@ -1106,7 +6623,7 @@ namespace ImGuiFD {
 				// draw ellipse last so it overlapps
 				ImGui::SameLine();
 				ImGui::SetCursorPos(cursorStartPos);
-				ImGui::GetWindowDrawList()->AddRectFilled(ImGui::GetCursorScreenPos(), ImGui::GetCursorScreenPos() + ImVec2(ellipseBtnWidth, ImGui::GetFrameHeight()), ImColor(ImGui::GetStyleColorVec4(ImGuiCol_TableHeaderBg)));
+				ImGui::GetWindowDrawList()->AddRectFilled(ImGui::GetCursorScreenPos(), ImGui::GetCursorScreenPos() + ImVec2(fd->currentPath.getEllipsisWidth(), ImGui::GetFrameHeight()), ImColor(ImGui::GetStyleColorVec4(ImGuiCol_TableHeaderBg)));
 				if (ImGui::Button("...")) { // ellipse Button
 					fd->forceDisplayAllDirs = true;
 				}
@@ -1174,7 +6691,68 @@ namespace ImGuiFD {
 
 		float displayModeBtnWidth = 50;
 		float settingsBtnWidth = ImGui::CalcTextSize("S").x + style.FramePadding.x * 2;
-		fd->entrys.drawSeachBar(ImGui::GetContentRegionAvail().x - (displayModeBtnWidth+style.ItemSpacing.x) - (settingsBtnWidth+style.ItemSpacing.x));
+		float subfoldersBtnWidth = ImGui::CalcTextSize("Sub").x + style.FramePadding.x * 2;
+		float everywhereBtnWidth = ImGui::CalcTextSize("All").x + style.FramePadding.x * 2;
+		if (fd->entrys.drawSeachBar(ImGui::GetContentRegionAvail().x - (subfoldersBtnWidth+style.ItemSpacing.x) - (everywhereBtnWidth+style.ItemSpacing.x) - (displayModeBtnWidth+style.ItemSpacing.x) - (settingsBtnWidth+style.ItemSpacing.x)))
+			fd->updateFiltering();
+		if (fd->searchContents && ImGui::IsItemHovered()) {
+			const ContentSearch& search = fd->contentSearch;
+			ImGui::SetTooltip("Searched %" PRIu64 " of %" PRIu64 " files (%" PRIu64 " skipped, %.1f MB read)%s",
+				(uint64_t)search.getNumFilesDone(), (uint64_t)search.getNumCandidates(), (uint64_t)search.getNumSkipped(), search.getBytesRead() / (1024.0 * 1024.0),
+				search.isActive() ? ", searching..." : search.reachedLimit() ? ", stopped at the limit" : "");
+		}
+
+		// the save path is relative to the current dir, so results from other dirs can't be used
+		const bool canSearchOtherDirs = fd->mode != ImGuiFDMode_SaveFile;
+
+		ImGui::SameLine();
+		{
+			const bool active = fd->searchSubfolders;
+			if (!canSearchOtherDirs) ImGui::BeginDisabled();
+			if (active) ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+			if (ImGui::Button("Sub", { subfoldersBtnWidth, 0 })) {
+				if (active) {
+					fd->updateEntrys(); // back to the current dir
+				}
+				else {
+					fd->searchEverywhere = false;
+					fd->searchSubfolders = true;
+					fd->updateFiltering();
+				}
+			}
+			if (active) ImGui::PopStyleColor();
+			if (!canSearchOtherDirs) ImGui::EndDisabled();
+			if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled)) {
+				const SubtreeSearch& search = fd->subtreeSearch;
+				if (!active)
+					ImGui::SetTooltip("Search in subfolders");
+				else
+					ImGui::SetTooltip("Search in subfolders (%" PRIu64 " folders searched%s)", (uint64_t)search.getNumDirsDone(),
+						search.isActive() ? ", searching..." : search.reachedMaxResults() ? ", stopped at max results" : "");
+			}
+		}
+
+		ImGui::SameLine();
+		{
+			const bool active = fd->searchEverywhere;
+			if (!canSearchOtherDirs) ImGui::BeginDisabled();
+			if (active) ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+			if (ImGui::Button("All", { everywhereBtnWidth, 0 })) {
+				if (active) {
+					fd->updateEntrys(); // back to the current dir
+				}
+				else {
+					fd->searchSubfolders = false;
+					fd->subtreeSearch.cancel();
+					fd->searchEverywhere = true;
+					fd->updateFiltering();
+				}
+			}
+			if (active) ImGui::PopStyleColor();
+			if (!canSearchOtherDirs) ImGui::EndDisabled();
+			if (ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+				ImGui::SetTooltip("Search everywhere (%" PRIu64 " names indexed%s)", (uint64_t)nameIndex.numLiveEntries(), nameIndex.isBusy() ? ", indexing..." : "");
+		}
 		ImGui::SameLine();
 		const char* labels[] = { "T","I" };
 		size_t mode = settings.displayMode;
@@ -1212,33 +6790,157 @@ namespace ImGuiFD {
 
 		ImGui::TableNextColumn();
 		ImGui::TextUnformatted(entry.name);
+		if (fd->listsOtherDirs()) {
+			// relative to the current dir when searching in subfolders
+			const char* dir = entry.dir;
+			if (fd->searchSubfolders && strlen(dir) >= fd->subtreeSearch.getRoot().size())
+				dir += fd->subtreeSearch.getRoot().size();
+			if (*dir) {
+				ImGui::SameLine();
+				ImGui::PushStyleColor(ImGuiCol_Text, settings.descTextCol);
+				ImGui::TextUnformatted(dir);
+				ImGui::PopStyleColor();
+			}
+		}
 
-		ImGui::TableNextColumn();
-		if (entry.size != (uint64_t)-1) {
-			char buf[128];
-			formatSize(buf, sizeof(buf), entry.size);
-			ImGui::TextUnformatted(buf);
+		// in the order of the columns: size, creation date, last modified
+		static const FileDialog::EntryManager::FormattedField fields[] = {
+			FileDialog::EntryManager::Formatted_Size, FileDialog::EntryManager::Formatted_Created, FileDialog::EntryManager::Formatted_Modified
+		};
+		for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+			ImGui::TableNextColumn();
+			const char* text = fd->entrys.getFormatted(ind, fields[f]);
+			if (text)
+				ImGui::TextUnformatted(text);
+			else
+				ImGui::Dummy({ 0,0 });
 		}
-		else
-			ImGui::Dummy({ 0,0 });
+	}
+	// draws the visible rows straight into the draw list of each column instead of submitting widgets per cell.
+	// all entries make up one table row, the mouse is handled by one item over the visible rows that behaves like the Selectables
+	static void DrawDirFiles_TableRowsFast() {
+		const ImGuiStyle& style = ImGui::GetStyle();
+		const float rowHeight = ImGui::GetTextLineHeight() + style.CellPadding.y * 2;
+		const size_t numRows = fd->entrys.size();
+
+		ImGui::TableNextRow(0, rowHeight * numRows);
+		ImGui::TableSetColumnIndex(0);
+		const float rowsY = ImGui::GetCursorScreenPos().y - style.CellPadding.y; // top of the first row
+
+		// the clip rect of the columns starts below the frozen header
+		const ImVec2 clipMin = ImGui::GetWindowDrawList()->GetClipRectMin();
+		const ImVec2 clipMax = ImGui::GetWindowDrawList()->GetClipRectMax();
+		const size_t firstRow = ImMin(clipMin.y > rowsY ? (size_t)((clipMin.y - rowsY) / rowHeight) : 0, numRows);
+		const size_t endRow = ImMin(clipMax.y > rowsY ? (size_t)((clipMax.y - rowsY) / rowHeight) + 1 : 0, numRows);
+		fd->tableRowsShown = endRow;
+		if (firstRow >= endRow)
+			return;
 
-		ImGui::TableNextColumn();
-		if (entry.lastModified != (time_t)-1) {
-			char buf[128];
-			formatTime(buf, sizeof(buf), entry.lastModified);
-			ImGui::TextUnformatted(buf);
+		// input, spanning all columns like ImGuiSelectableFlags_SpanAllColumns
+		size_t hoveredRow = (size_t)-1;
+		{
+			ImGuiWindow* window = ImGui::GetCurrentWindow();
+			const ImRect bb(
+				ImVec2(window->InnerClipRect.Min.x, ImMax(clipMin.y, rowsY + firstRow * rowHeight)),
+				ImVec2(window->InnerClipRect.Max.x, ImMin(clipMax.y, rowsY + endRow * rowHeight))
+			);
+			const ImGuiID id = ImGui::GetID("##rows");
+			bool hovered = false, held = false, pressed = false;
+			ImGui::PushClipRect(bb.Min, bb.Max, false); // the clip rect of the first column would limit hovering to it
+			if (ImGui::ItemAdd(bb, id, NULL, ImGuiItemFlags_NoNav))
+				pressed = ImGui::ButtonBehavior(bb, id, &hovered, &held);
+			ImGui::PopClipRect();
+
+			if (hovered) {
+				hoveredRow = ImMin((size_t)((ImGui::GetMousePos().y - rowsY) / rowHeight), endRow - 1);
+				if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+					fd->tablePressedRow = hoveredRow;
+			}
+			if (!held && !pressed && !ImGui::IsMouseDown(ImGuiMouseButton_Left))
+				fd->tablePressedRow = (size_t)-1;
+
+			if (hoveredRow != (size_t)-1) {
+				const size_t ind = fd->entrys.getActualIndex(hoveredRow);
+				DirEntry& entry = fd->entrys.getRaw(ind);
+				if (pressed && hoveredRow == fd->tablePressedRow) // Selectables are pressed when the mouse goes up on the row it went down on
+					ClickedOnEntrySelect(ind, fd->selected.contains(ind), entry.isFolder);
+
+				CheckDoubleClick(entry);
+			}
+			if (pressed)
+				fd->tablePressedRow = (size_t)-1;
 		}
-		else
-			ImGui::Dummy({ 0,0 });
+		if (firstRow >= fd->entrys.size()) // the listing changed (e.g. went into a folder)
+			return;
+		const size_t rowsEnd = ImMin(endRow, fd->entrys.size());
+
+		const ImU32 textCol = ImGui::GetColorU32(ImGuiCol_Text);
+		const ImU32 descCol = ImGui::GetColorU32(settings.descTextCol);
+		const ImU32 rowBgAltCol = ImGui::GetColorU32(ImGuiCol_TableRowBgAlt);
+		const ImU32 selCol = ImGui::GetColorU32(ImGuiCol_Header);
+		const ImU32 hoveredCol = ImGui::GetColorU32(ImGuiCol_HeaderHovered);
+		const ImU32 activeCol = ImGui::GetColorU32(ImGuiCol_HeaderActive);
+		const float dirTypeWidth = ImGui::CalcTextSize("[DIR]").x;
+		const float fileTypeWidth = ImGui::CalcTextSize("[FILE]").x;
+
+		// columns by index, the table places them wherever they were moved to
+		static const FileDialog::EntryManager::FormattedField fields[] = {
+			FileDialog::EntryManager::Formatted_Size, FileDialog::EntryManager::Formatted_Created, FileDialog::EntryManager::Formatted_Modified
+		};
+		for (int column = 0; column < 5; column++) {
+			ImGui::TableSetColumnIndex(column);
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+			const float x = ImGui::GetCursorScreenPos().x;
+			const float bgMinX = drawList->GetClipRectMin().x;
+			const float bgMaxX = drawList->GetClipRectMax().x;
+			float maxWidth = 0;
+
+			for (size_t row = firstRow; row < rowsEnd; row++) {
+				const size_t ind = fd->entrys.getActualIndex(row);
+				const DirEntry& entry = fd->entrys.getRaw(ind);
+				const float y = rowsY + row * rowHeight;
+
+				if (row % 2 == 1)
+					drawList->AddRectFilled(ImVec2(bgMinX, y), ImVec2(bgMaxX, y + rowHeight), rowBgAltCol);
+				if (row == hoveredRow || fd->selected.contains(ind)) {
+					const ImU32 col = row != hoveredRow ? selCol : row == fd->tablePressedRow ? activeCol : hoveredCol;
+					drawList->AddRectFilled(ImVec2(bgMinX, y), ImVec2(bgMaxX, y + rowHeight), col);
+				}
 
-		ImGui::TableNextColumn();
-		if (entry.creationDate != (time_t)-1) {
-			char buf[128];
-			formatTime(buf, sizeof(buf), entry.creationDate);
-			ImGui::TextUnformatted(buf);
+				const ImVec2 pos(x, y + style.CellPadding.y);
+				if (column == 0) {
+					drawList->AddText(pos, textCol, entry.isFolder ? "[DIR]" : "[FILE]");
+					maxWidth = ImMax(maxWidth, entry.isFolder ? dirTypeWidth : fileTypeWidth);
+				}
+				else if (column == 1) {
+					drawList->AddText(pos, textCol, entry.name);
+					float width = fd->entrys.getTextWidth(ind, FileDialog::EntryManager::Text_Name);
+					if (fd->listsOtherDirs()) {
+						// relative to the current dir when searching in subfolders
+						const char* dir = entry.dir;
+						if (fd->searchSubfolders && strlen(dir) >= fd->subtreeSearch.getRoot().size())
+							dir += fd->subtreeSearch.getRoot().size();
+						if (*dir) {
+							width += style.ItemSpacing.x;
+							drawList->AddText(ImVec2(x + width, pos.y), descCol, dir);
+							width += ImGui::CalcTextSize(dir).x;
+						}
+					}
+					maxWidth = ImMax(maxWidth, width);
+				}
+				else {
+					const FileDialog::EntryManager::FormattedField field = fields[column - 2];
+					const char* text = fd->entrys.getFormatted(ind, field);
+					if (text) {
+						drawList->AddText(pos, textCol, text);
+						maxWidth = ImMax(maxWidth, fd->entrys.getTextWidth(ind, field));
+					}
+				}
+			}
+
+			// lets the column fit its contents, like the widgets would
+			ImGui::Dummy(ImVec2(maxWidth, 0));
 		}
-		else
-			ImGui::Dummy({ 0,0 });
 	}
 	static void DrawDirFiles_Table(float height) {
 		if (height <= 0)
@@ -1268,19 +6970,28 @@ namespace ImGuiFD {
 
 			if (ImGuiTableSortSpecs* sorts_specs = ImGui::TableGetSortSpecs())
 				if (sorts_specs->SpecsDirty || !fd->entrys.sorted){
-					fd->entrys.sort(sorts_specs);
+					// before the first frame, as many rows as fit into the table
+					const size_t rowsShown = fd->tableRowsShown > 0 ? fd->tableRowsShown : (size_t)(height / ImGui::GetTextLineHeightWithSpacing()) + 1;
+					fd->entrys.sort(sorts_specs, rowsShown);
 					sorts_specs->SpecsDirty = false;
 				}
 
-			ImGuiListClipper clipper;
-			clipper.Begin((int)fd->entrys.size());
-			while (clipper.Step()) {
-				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
-					ImGui::PushID(row);
+			if (settings.fastTableRows && !ImGui::GetIO().NavVisible) { // keyboard navigation needs the widgets
+				DrawDirFiles_TableRowsFast();
+			}
+			else {
+				ImGuiListClipper clipper;
+				clipper.Begin((int)fd->entrys.size());
+				fd->tableRowsShown = 0;
+				while (clipper.Step()) {
+					fd->tableRowsShown = ImMax(fd->tableRowsShown, (size_t)clipper.DisplayEnd);
+					for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+						ImGui::PushID(row);
 
-					DrawDirFiles_TableRow(row);
+						DrawDirFiles_TableRow(row);
 
-					ImGui::PopID();
+						ImGui::PopID();
+					}
 				}
 			}
 			ImGui::EndTable();
@@ -1292,42 +7003,26 @@ namespace ImGuiFD {
 		);*/
 	}
 
-	static void DrawDirFiles_IconsItemDesc(const DirEntry& entry) {
+	// ind is the index of the entry in fd->entrys.getRaw()
+	static void DrawDirFiles_IconsItemDesc(size_t ind) {
 		ImGui::PushStyleColor(ImGuiCol_Text, settings.descTextCol);
 
 		if (ImGui::BeginTable("ToolTipDescTable", 2)) {
-			
-			if (entry.size != (uint64_t)-1) {
-				ImGui::TableNextRow();
-				ImGui::TableNextColumn();
-				ImGui::TextUnformatted("Size:");
-
-				ImGui::TableNextColumn();
-				char buf[128];
-				formatSize(buf, sizeof(buf), entry.size);
-				ImGui::TextUnformatted(buf);
-			}
-
-			if (entry.creationDate != (time_t)-1) {
-				ImGui::TableNextRow();
-				ImGui::TableNextColumn();
-				ImGui::TextUnformatted("Created:");
-
-				ImGui::TableNextColumn();
-				char buf[128];
-				formatTime(buf, sizeof(buf), entry.creationDate);
-				ImGui::TextUnformatted(buf);
-			}
-
-			if (entry.lastModified != (time_t)-1) {
+			static const struct { const char* label; FileDialog::EntryManager::FormattedField field; } rows[] = {
+				{ "Size:", FileDialog::EntryManager::Formatted_Size },
+				{ "Created:", FileDialog::EntryManager::Formatted_Created },
+				{ "Last Modified:", FileDialog::EntryManager::Formatted_Modified }
+			};
+			for (size_t r = 0; r < sizeof(rows) / sizeof(rows[0]); r++) {
+				const char* text = fd->entrys.getFormatted(ind, rows[r].field);
+				if (!text)
+					continue;
 				ImGui::TableNextRow();
 				ImGui::TableNextColumn();
-				ImGui::TextUnformatted("Last Modified:");
+				ImGui::TextUnformatted(rows[r].label);
 
 				ImGui::TableNextColumn();
-				char buf[128];
-				formatTime(buf, sizeof(buf), entry.lastModified);
-				ImGui::TextUnformatted(buf);
+				ImGui::TextUnformatted(text);
 			}
 
 			ImGui::EndTable();
@@ -1387,6 +7082,27 @@ namespace ImGuiFD {
 
 			const ImVec2 totalCursorStart = ImGui::GetCursorPos();
 
+			const char* folderIconText;
+			const char* fileIconText;
+			if (!settings.asciiArtIcons) {
+				folderIconText = "[DIR]";
+				fileIconText = "[FILE]";
+			}
+			else {
+				folderIconText =
+					"    "  "\n"
+					"|=\\_."  "\n"
+					"| D |"  "\n"
+					"*---*";
+				fileIconText =
+					" __ "  "\n"
+					"|  \\" "\n"
+					"|  |"  "\n"
+					"*--*";
+			}
+			const ImVec2 folderIconSize = ImGui::CalcTextSize(folderIconText);
+			const ImVec2 fileIconSize = ImGui::CalcTextSize(fileIconText);
+
 			ImGuiListClipper clipper;
 			clipper.Begin((int)numOfLines, itemHeight + style.ItemSpacing.y*2);
 			while (clipper.Step()) {
@@ -1415,8 +7131,7 @@ namespace ImGuiFD {
 
 						CheckDoubleClick(entry);
 
-						int maxTextLines = 2;
-						float textY = cursorEnd.y - ImGui::GetTextLineHeight() * maxTextLines;
+						float textY = cursorEnd.y - ImGui::GetTextLineHeight() * (float)FileDialog::EntryManager::MaxIconLabelLines;
 
 						FileData* fileData = fd->fileDataCache.get(entry);
 						const bool isImage = fileData && fileData->thumbnail;
@@ -1444,7 +7159,7 @@ namespace ImGuiFD {
 
 								ImGui::Separator();
 
-								DrawDirFiles_IconsItemDesc(entry);
+								DrawDirFiles_IconsItemDesc(id);
 
 								if (fileData->thumbnail->origWidth != -1 && fileData->thumbnail->origHeight != -1) { // check if actual (non thumbnail scaled) size was entered
 									ImGui::PushStyleColor(ImGuiCol_Text, settings.descTextCol);
@@ -1472,30 +7187,13 @@ namespace ImGuiFD {
 								ImGui::TextUnformatted(entry.name);
 								ImGui::Separator();
 
-								DrawDirFiles_IconsItemDesc(entry);
+								DrawDirFiles_IconsItemDesc(id);
 
 								ImGui::EndTooltip();
 							}
 
-							const char* iconText;
-							if (!settings.asciiArtIcons) {
-								iconText = entry.isFolder ? "[DIR]" : "[FILE]";
-							}
-							else {
-								iconText = entry.isFolder ?
-									"    "  "\n"
-									"|=\\_."  "\n"
-									"| D |"  "\n"
-									"*---*"
-									:
-									" __ "  "\n"
-									"|  \\" "\n"
-									"|  |"  "\n"
-									"*--*"
-									;
-							}
-							
-							ImVec2 textSize = ImGui::CalcTextSize(iconText);
+							const char* iconText = entry.isFolder ? folderIconText : fileIconText;
+							const ImVec2 textSize = entry.isFolder ? folderIconSize : fileIconSize;
 							ImGui::SetCursorPos(ImVec2{ cursorStart.x + itemWidth / 2 - textSize.x / 2, cursorStart.y + (textY-cursorStart.y)/2-textSize.y/2 });
 							ImGui::TextColored(settings.iconTextCol, "%s", iconText);
 						}
@@ -1506,7 +7204,7 @@ namespace ImGuiFD {
 							const float maxWidth = cursorEnd.x - cursorStart.x;
 
 							if (!isRenamingThis) {
-								TextWrappedCentered(entry.name, maxWidth, maxTextLines);
+								DrawIconLabel(entry.name, fd->entrys.getIconLabel(id, maxWidth), maxWidth);
 							}
 							else {
 								const float textWidth = ImGui::CalcTextSize(fd->renameStr.c_str()).x + ImGui::GetStyle().FramePadding.x*2;
@@ -1614,6 +7312,7 @@ namespace ImGuiFD {
 				DrawDirFiles_Icons(height);
 				break;
 		}
+		fd->fileDataCache.endFrame(); // entries that weren't drawn (e.g. in the list view) count as hidden
 
 		if (ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
 			ImGui::OpenPopup("ContextMenu");
@@ -1655,15 +7354,15 @@ namespace ImGuiFD {
 
 		// filter combo
 		if (fd->hasFilter) {
-			IM_ASSERT(fd->entrys.filter.filters.size() > 0);
+			IM_ASSERT(fd->entrys.filter.getNumGroups() > 0);
 			ImGui::PushItemWidth(widthWOBtns);
 
-			if (ImGui::BeginCombo("##filter", fd->entrys.filter.filters[fd->entrys.filter.filterSel].rawStr.c_str())) {
-				for (size_t i = 0; i < fd->entrys.filter.filters.size(); i++) {
+			if (ImGui::BeginCombo("##filter", fd->entrys.filter.getGroupLabel(fd->entrys.filter.filterSel))) {
+				for (size_t i = 0; i < fd->entrys.filter.getNumGroups(); i++) {
 					ImGui::PushID((ImGuiID)i);
 
 					bool isSelected = i == fd->entrys.filter.filterSel;
-					if (ImGui::Selectable(fd->entrys.filter.filters[i].rawStr.c_str(), isSelected)) {
+					if (ImGui::Selectable(fd->entrys.filter.getGroupLabel(i), isSelected)) {
 						if (fd->entrys.filter.filterSel != i) {
 							fd->entrys.filter.filterSel = i;
 							fd->updateFiltering();
@@ -1692,7 +7391,11 @@ namespace ImGuiFD {
 			if (!canOpen && fd->isFileMode() && fd->selected.size() == 1 && fd->getSelectedInd(0).isFolder) {
 				drawOpen = false;
 				if (ImGui::Button("Open Folder", {btnWidht,0})) {
-					fd->dirMoveDownInto(fd->entrys.get(*fd->selected.begin()).name);
+					const DirEntry& entry = fd->getSelectedInd(0);
+					if (fd->listsOtherDirs())
+						fd->dirSetTo(entry.path);
+					else
+						fd->dirMoveDownInto(entry.name);
 				}
 			}
 
@@ -1748,14 +7451,43 @@ namespace ImGuiFD {
 
 	
 
+	static void OpenDialogImpl(const char* str_id, ImGuiFDMode mode, const char* path, const char* filter, const FilterDesc* filterDesc, ImGuiFDDialogFlags flags, size_t maxSelections) {
+		ImGuiID id = ImHashStr(str_id);
+#if 0
+		IM_ASSERT(!openDialogs.contains(id));
+#else
+		if (openDialogs.contains(id)) {
+			if (openDialogs.getByID(id).toDelete) {
+				openDialogs.getByID(id).fileDataCache.clear();
+				openDialogs.getByID(id).fileDataCache.endFrame();
+				openDialogs.erase(id);
+			}
+			else {
+				return;
+			}
+		}
+#endif
+		openDialogs.insert(id, FileDialog(id, str_id, filter, filterDesc, path, mode, flags, maxSelections));
+	}
 	static void CloseDialogID(ImGuiID id) {
 		if (openDialogs.contains(id))
 			openDialogs.getByID(id).toDelete = true;
 	}
+	// adds what got listed for the name index a bit every frame
+	static void UpdateNameIndex() {
+		static int lastFrame = -1;
+		const int frame = ImGui::GetFrameCount();
+		if (frame == lastFrame || !nameIndex.isBusy())
+			return;
+		lastFrame = frame;
+
+		nameIndex.continueWork(settings.indexBudgetMs > 0 ? Native::getTime() + settings.indexBudgetMs * 0.001 : 1e300);
+	}
 }
 
 ImGuiFD::RequestFileDataCallback ImGuiFD::FileDataCache::requestFileDataCallB = 0;
 ImGuiFD::FreeFileDataCallback ImGuiFD::FileDataCache::freeFileDataCallB = 0;
+ImGuiFD::FileDataBatchCallback ImGuiFD::FileDataCache::batchCallB = 0;
 
 ImGuiFD::DirEntry::DirEntry() {
 
@@ -1793,6 +7525,9 @@ void ImGuiFD::SetFileDataCallback(RequestFileDataCallback loadCallB, FreeFileDat
 	FileDataCache::requestFileDataCallB = loadCallB;
 	FileDataCache::freeFileDataCallB = unloadCallB;
 }
+void ImGuiFD::SetFileDataBatchCallback(FileDataBatchCallback callB) {
+	FileDataCache::batchCallB = callB;
+}
 
 ImGuiFD::FDInstance::FDInstance(const char* str_id) : str_id(str_id), id(ImHashStr(str_id)){
 
@@ -1825,20 +7560,10 @@ size_t ImGuiFD::FDInstance::sizeBytes() const {
 
 
 void ImGuiFD::OpenDialog(const char* str_id, ImGuiFDMode mode, const char* path, const char* filter, ImGuiFDDialogFlags flags, size_t maxSelections) {
-	ImGuiID id = ImHashStr(str_id);
-#if 0
-	IM_ASSERT(!openDialogs.contains(id));
-#else
-	if (openDialogs.contains(id)) {
-		if (openDialogs.getByID(id).toDelete) {
-			openDialogs.erase(id);
-		}
-		else {
-			return;
-		}
-	}
-#endif
-	openDialogs.insert(id, FileDialog(id, str_id, filter, path, mode, flags, maxSelections));
+	OpenDialogImpl(str_id, mode, path, filter, NULL, flags, maxSelections);
+}
+void ImGuiFD::OpenDialog(const char* str_id, ImGuiFDMode mode, const char* path, const FilterDesc& filter, ImGuiFDDialogFlags flags, size_t maxSelections) {
+	OpenDialogImpl(str_id, mode, path, NULL, &filter, flags, maxSelections);
 }
 
 void ImGuiFD::CloseDialog(const char* str_id) {
@@ -1859,6 +7584,8 @@ bool ImGuiFD::BeginDialog(ImGuiID id) {
 	// Begin/End mismatch
 	IM_ASSERT(fd == 0);
 
+	UpdateNameIndex();
+
 	if (!openDialogs.contains(id))
 		return false;
 	
@@ -1914,8 +7641,12 @@ void ImGuiFD::EndDialog() {
 	// Begin/End mismatch
 	IM_ASSERT(fd != 0);
 
-	if (fd->toDelete)
+	if (fd->toDelete) {
+		// the visible entries get reported as hidden before the dialog goes away
+		fd->fileDataCache.clear();
+		fd->fileDataCache.endFrame();
 		openDialogs.erase(fd->id);
+	}
 
 	fd = 0;
 }
@@ -2009,6 +7740,37 @@ void ImGuiFD::DrawDebugWin(const char* str_id) {
 
 void ImGuiFD::Shutdown() {
 	openDialogs.clear(); // this is crucial to call all the deconstructors before the stuff they depend on gets shut down
+	nameIndex.clear();
+}
+
+void ImGuiFD::EntryChanged(const char* path) {
+	ds::string entryPath = path;
+	while (entryPath.size() > 1 && (entryPath[entryPath.size() - 1] == '/' || entryPath[entryPath.size() - 1] == '\\'))
+		entryPath = entryPath.substr(0, (ptrdiff_t)entryPath.size() - 1);
+	const char* name = utils::getFileName(entryPath.c_str());
+	if (*name == 0)
+		return;
+	// only the dir has to exist (a deleted file can't be resolved)
+	const ds::string dir = utils::fixDirStr(Native::getAbsolutePath(entryPath.substr(0, name - entryPath.c_str()).c_str()).c_str());
+
+	for (size_t i = 0; i < openDialogs.size(); i++) {
+		FileDialog& dialog = openDialogs.getByInd(i);
+		if (dialog.oldPath == dir)
+			dialog.entryChanged(name);
+	}
+}
+
+void ImGuiFD::IndexAddRoot(const char* path) {
+	nameIndex.addRoot(Native::getAbsolutePath(path).c_str());
+}
+void ImGuiFD::IndexDirChanged(const char* dir) {
+	nameIndex.dirChanged(Native::getAbsolutePath(dir).c_str());
+}
+bool ImGuiFD::IndexLoad(const char* file) {
+	return nameIndex.load(file);
+}
+bool ImGuiFD::IndexSave(const char* file) {
+	return nameIndex.save(file);
 }
 
 
@@ -7,6 +7,9 @@
 // uncomment this for stl support
 //#define IMGUIFD_ENABLE_STL 1
 
+// uncomment this to spread filtering of big directories over multiple threads (needs pthreads on non windows platforms)
+//#define IMGUIFD_ENABLE_THREADS 1
+
 
 #ifdef _MSC_VER
     #ifndef _CRT_SECURE_NO_WARNINGS
@@ -29,6 +32,26 @@ Example Filters:
     "."
     "{*},{*.txt,*.text}"
     "{*},{Text Files:*.txt,*.text}"
+    "{Archives:*.tar.gz,*.zip},{Frames:frame_????.png}"
+    "{Sources:*.[ch],*.[ch]pp},{No Backups:!*.bak}"
+
+Patterns:
+    *.txt   globs match the whole name: '*' any chars, '?' one char, [abc] [a-z] [!abc] char classes, '\' escapes
+    name    exactly name (same as "=name"), "*text*" for names containing text
+    !pat    everything pat doesn't match
+
+A name passes a group if it passes any of its patterns, so "!pat" doesn't exclude what the other patterns of the group
+match: "*.c,!*_test*" still passes "x_test.c", it only drops the "_test" names that aren't ".c" files.
+
+In the search bar plain text matches names containing it, and "re:<regex>" can be used (case insensitive, matches anywhere in the name unless anchored with ^ or $).
+Supported: . [] \d \w \s | () * + ? {n,m}, no backreferences or lookarounds. Invalid regexes are shown in red.
+Words of the form field:value filter by metadata and can be mixed with the text, e.g. "report size:>1G modified:<7d":
+    size:>1G  size:<=10k  size:1M..5M       sizes (K, M, G, T are 1024 based)
+    modified:<7d  created:>1y               ages (h, d, w, m, y), "<7d" = less than 7 days ago
+    modified:2026-10  created:>=2026-01-15  local dates (YYYY, YYYY-MM or YYYY-MM-DD)
+    type:dir  type:file
+"contains:text" (or contains:"some text") only keeps the files of the current dir containing text (case insensitive).
+Everything else in the search narrows down which files are read, e.g. "*.log contains:timeout size:<10M".
 */
 
 enum {
@@ -74,11 +97,29 @@ namespace ImGuiFD {
             DisplayMode_Icons = 1
         };
         uint8_t displayMode = DisplayMode_Icons;
+        bool fastTableRows = false; // draw the rows of the list straight into the draw list instead of one widget per cell
 
 
         ImVec4 descTextCol = { .7f, .7f, .7f, 1 };
 
         bool asciiArtIcons = true;
+
+        bool humanReadableSizes = false; // "1.5 MiB" instead of the size in bytes
+        const char* dateFormat = "%d.%m.%y %H:%M"; // strftime() format of the dates, the string has to stay alive
+
+        bool naturalSort = false; // sort numbers in names by their value, so "frame2" comes before "frame10"
+
+        bool fuzzySearch = false; // match the search text as a subsequence and rank the results by how well they match
+
+        int maxThreads = 0; // max number of threads used on big directories, 0 => one per core (only used with IMGUIFD_ENABLE_THREADS)
+
+        float workBudgetMs = 2; // max time spent on filtering/sorting per frame, big directories continue in the next frames, <= 0 => no limit
+
+        bool indexVisitedDirs = false; // add every directory a dialog lists to the name index, see IndexAddRoot()
+        float indexBudgetMs = 1; // max time spent adding directories to the name index per frame (without IMGUIFD_ENABLE_THREADS also listing them), <= 0 => no limit
+
+        uint64_t contentSearchMaxFileSize = (uint64_t)64 << 20; // "contains:" skips bigger files
+        uint64_t contentSearchMaxBytes = (uint64_t)1 << 30; // "contains:" stops after reading this much
     };
 
     static GlobalSettings settings;
@@ -108,9 +149,31 @@ namespace ImGuiFD {
 
     void SetFileDataCallback(RequestFileDataCallback loadCallB, FreeFileDataCallback unloadCallB);
 
+    // an entry that became visible in the icon view. the host sets data (or leaves it NULL), which has to stay valid until the entry gets hidden.
+    // the thumbnail can be loaded later, see FileData::Image::loadDone
+    struct FileDataRequest {
+        const DirEntry* entry; // only valid during the callback
+        int maxDimSize;
+        FileData* data;
+    };
+    // called at most once per frame and dialog, only if entries became visible or hidden since the last frame.
+    // the hidden ids come first, an entry whose data is outdated (e.g. the file changed) is hidden and shown again
+    typedef void (*FileDataBatchCallback)(FileDataRequest* shown, size_t numShown, const ImGuiID* hidden, size_t numHidden);
+
+    // used instead of the RequestFileDataCallback if set, the FreeFileDataCallback isn't called for the entries it requested
+    void SetFileDataBatchCallback(FileDataBatchCallback callB);
+
     void GetFileDialog(const char* str_id, const char* filter, const char* path, ImGuiFDDialogFlags flags = 0, size_t maxSelections = 1);
 
+    // filter groups that are already compiled into code instead of being parsed from a string, see StaticFilter
+    struct FilterDesc {
+        const char* const* groupLabels; // shown in the filter combo box
+        size_t numGroups;
+        bool (*passes)(const char* name, const char* nameEnd, size_t group);
+    };
+
     void OpenDialog(const char* str_id, ImGuiFDMode mode, const char* path, const char* filter = NULL, ImGuiFDDialogFlags flags = 0, size_t maxSelections = 1);
+    void OpenDialog(const char* str_id, ImGuiFDMode mode, const char* path, const FilterDesc& filter, ImGuiFDDialogFlags flags = 0, size_t maxSelections = 1);
     void CloseDialog(const char* str_id);
     void CloseCurrentDialog();
 
@@ -125,10 +188,428 @@ namespace ImGuiFD {
     const char* GetSelectionNameString(size_t ind);
     const char* GetSelectionPathString(size_t ind);
 
+    // call when a file watcher reports that path got created, deleted or modified.
+    // open dialogs listing its directory update just that entry, instead of loading and sorting the whole directory again
+    void EntryChanged(const char* path);
+
+    // index of names for searching everywhere instead of only in the current dir (the "All" button next to the search bar).
+    // roots are walked in the background while dialogs are drawn, directories listed by a dialog are added as well.
+    void IndexAddRoot(const char* path);
+    void IndexDirChanged(const char* dir); // lists dir again, e.g. when a file watcher reports a change
+    bool IndexLoad(const char* file); // replaces the index with file (memory mapped)
+    bool IndexSave(const char* file);
+
     void DrawDebugWin(const char* str_id);
 
     void Shutdown();
 }
 
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L && defined(__cpp_consteval)
+#define IMGUIFD_HAS_STATIC_FILTER 1
+
+/*
+
+Filters known at compile time can be parsed at compile time (needs C++20):
+    ImGuiFD::OpenDialog("Open", ImGuiFDMode_LoadFile, ".", ImGuiFD::StaticFilter<"{Images:*.png,*.jpg},{Text:*.txt}">::desc);
+
+Same syntax as the filter strings, but stricter: unbalanced braces, text outside of {groups}, empty groups,
+unclosed '[', reversed ranges and a trailing '\' fail to compile (at runtime they are taken literally or ignored).
+Every pattern becomes its own code, "*.png" e.g. just compares the last 4 chars with ".png".
+
+*/
+
+namespace ImGuiFD {
+    namespace StaticFilterImpl {
+        template<size_t N>
+        struct Literal {
+            char str[N] = {};
+            constexpr Literal(const char (&s)[N]) {
+                for (size_t i = 0; i < N; i++)
+                    str[i] = s[i];
+            }
+        };
+
+        // called during parsing at compile time, which makes the compilation fail with the reason in the error message
+        inline void invalidStaticFilter(const char* reason) { (void)reason; }
+
+        struct Token {
+            bool anyString = false; // '*'
+            bool literal = false;   // just c
+            bool wholeChar = false; // '?' and "[!...]": after the first byte the UTF-8 continuation bytes are skipped too
+            char c = 0;
+            uint64_t bits[4] = {};  // bytes this token matches (if not anyString)
+
+            constexpr bool matches(uint8_t ch) const {
+                return (bits[ch >> 6] >> (ch & 63)) & 1;
+            }
+        };
+
+        enum PatternType {
+            Pattern_Exact = 0,
+            Pattern_Prefix,
+            Pattern_Suffix,
+            Pattern_Substring,
+            Pattern_Glob
+        };
+        struct Pattern {
+            PatternType type = Pattern_Exact;
+            bool negated = false;
+            size_t textBegin = 0, textEnd = 0;   // the literal in Parsed::text (all but Pattern_Glob)
+            size_t tokenBegin = 0, tokenEnd = 0; // Pattern_Glob in Parsed::tokens
+        };
+        struct Group {
+            size_t label = 0; // in Parsed::text, '\0' terminated
+            size_t patternBegin = 0, patternEnd = 0;
+            size_t numPatterns = 0; // including ignored ones like "!*", a group without any matches everything
+            bool matchesAll = false;
+        };
+
+        template<size_t N>
+        struct Parsed {
+            enum : size_t { MaxGroups = N / 2 + 2 };
+
+            char text[2 * N + MaxGroups + 4] = {};
+            size_t textLen = 0;
+            Token tokens[N] = {};
+            size_t numTokens = 0;
+            Pattern patterns[N] = {};
+            size_t numPatterns = 0;
+            Group groups[MaxGroups] = {};
+            size_t numGroups = 0;
+
+            consteval size_t addText(const char* str, const char* strEnd, bool terminate) {
+                const size_t off = textLen;
+                for (const char* c = str; c < strEnd; c++)
+                    text[textLen++] = *c;
+                if (terminate)
+                    text[textLen++] = 0;
+                return off;
+            }
+
+            consteval void addLiteralPattern(PatternType type, bool negated, const char* str, const char* strEnd) {
+                Pattern& pat = patterns[numPatterns++];
+                pat.type = type;
+                pat.negated = negated;
+                pat.textBegin = addText(str, strEnd, false);
+                pat.textEnd = textLen;
+            }
+
+            consteval void addGlob(bool negated, const char* c, const char* end) {
+                const size_t tokenBegin = numTokens;
+                while (c < end) {
+                    Token& tok = tokens[numTokens++];
+                    tok = Token(); // might have been used by a previous pattern that turned out to be just a literal
+                    if (*c == '*') {
+                        while (c < end && *c == '*')
+                            c++;
+                        tok.anyString = true;
+                        continue;
+                    }
+                    if (*c == '?') { // one UTF-8 char like at runtime: any byte but a continuation byte (0x80 - 0xBF) starts it
+                        tok.bits[0] = ~(uint64_t)0;
+                        tok.bits[1] = ~(uint64_t)0;
+                        tok.bits[3] = ~(uint64_t)0;
+                        tok.wholeChar = true;
+                    }
+                    else if (*c == '[') {
+                        const char* s = c + 1;
+                        const bool inverted = s < end && (*s == '!' || *s == '^');
+                        if (inverted)
+                            s++;
+                        const char* classEnd = s;
+                        if (classEnd < end && *classEnd == ']') // ']' right at the start is a literal
+                            classEnd++;
+                        while (classEnd < end && *classEnd != ']')
+                            classEnd++;
+                        if (classEnd >= end)
+                            invalidStaticFilter("'[' without ']'");
+
+                        for (; s < classEnd; s++) {
+                            uint8_t from = (uint8_t)*s, to = (uint8_t)*s;
+                            if (s + 2 < classEnd && s[1] == '-') {
+                                to = (uint8_t)s[2];
+                                if (to < from)
+                                    invalidStaticFilter("reversed range in []");
+                                s += 2;
+                            }
+                            for (int ch = from; ch <= to; ch++)
+                                tok.bits[ch >> 6] |= (uint64_t)1 << (ch & 63);
+                        }
+                        if (inverted) {
+                            for (int i = 0; i < 4; i++)
+                                tok.bits[i] = ~tok.bits[i];
+                            tok.bits[2] = 0; // continuation bytes can't start a char
+                            tok.wholeChar = true;
+                        }
+                        c = classEnd;
+                    }
+                    else {
+                        if (*c == '\\') {
+                            if (c + 1 == end)
+                                invalidStaticFilter("'\\' at the end of a pattern");
+                            c++;
+                        }
+                        tok.literal = true;
+                        tok.c = *c;
+                        tok.bits[(uint8_t)*c >> 6] |= (uint64_t)1 << ((uint8_t)*c & 63);
+                    }
+                    c++;
+                }
+
+                // globs that are just a literal with '*' around it don't need the generic matcher
+                const bool starFirst = tokens[tokenBegin].anyString;
+                const bool starLast = numTokens - tokenBegin > 1 && tokens[numTokens - 1].anyString;
+                const size_t litBegin = tokenBegin + (starFirst ? 1 : 0);
+                const size_t litEnd = numTokens - (starLast ? 1 : 0);
+                bool allLiteral = true;
+                for (size_t i = litBegin; i < litEnd; i++) {
+                    if (!tokens[i].literal)
+                        allLiteral = false;
+                }
+
+                if (allLiteral && litBegin < litEnd) {
+                    Pattern& pat = patterns[numPatterns++];
+                    pat.type = starFirst ? (starLast ? Pattern_Substring : Pattern_Suffix) : (starLast ? Pattern_Prefix : Pattern_Exact);
+                    pat.negated = negated;
+                    pat.textBegin = textLen;
+                    for (size_t i = litBegin; i < litEnd; i++)
+                        text[textLen++] = tokens[i].c;
+                    pat.textEnd = textLen;
+                    numTokens = tokenBegin;
+                    return;
+                }
+
+                Pattern& pat = patterns[numPatterns++];
+                pat.type = Pattern_Glob;
+                pat.negated = negated;
+                pat.tokenBegin = tokenBegin;
+                pat.tokenEnd = numTokens;
+            }
+
+            // same rules as at runtime (see FileNameFilter)
+            consteval void addPattern(Group& group, const char* str, const char* strEnd) {
+                for (const char* c = str; c < strEnd; c++) {
+                    if (*c == ':') { // label
+                        str = c + 1;
+                        break;
+                    }
+                }
+                while (str < strEnd && *str == ' ')
+                    str++;
+                while (strEnd > str && *(strEnd - 1) == ' ')
+                    strEnd--;
+                if (str == strEnd)
+                    return;
+
+                group.numPatterns++;
+
+                if (*str == '=') {
+                    addLiteralPattern(Pattern_Exact, false, str + 1, strEnd);
+                    return;
+                }
+
+                const bool negated = *str == '!';
+                if (negated)
+                    str++;
+
+                bool catchAll = true;
+                bool isGlob = false;
+                for (const char* c = str; c < strEnd; c++) {
+                    if (*c != '*' && *c != '.')
+                        catchAll = false;
+                    if (*c == '*' || *c == '?' || *c == '[')
+                        isGlob = true;
+                }
+                if (catchAll) {
+                    if (!negated)
+                        group.matchesAll = true;
+                    return;
+                }
+
+                if (isGlob)
+                    addGlob(negated, str, strEnd);
+                else
+                    addLiteralPattern(Pattern_Exact, negated, str, strEnd);
+            }
+
+            consteval void addGroup(const char* str, const char* strEnd) {
+                if (str == strEnd)
+                    invalidStaticFilter("empty group");
+
+                Group& group = groups[numGroups++];
+                group.label = addText(str, strEnd, true);
+                group.patternBegin = numPatterns;
+
+                const char* last = str;
+                for (const char* c = str; c <= strEnd; c++) {
+                    if (c == strEnd || *c == ',') {
+                        addPattern(group, last, c);
+                        last = c + 1;
+                    }
+                }
+                group.patternEnd = numPatterns;
+            }
+        };
+
+        template<size_t N>
+        consteval Parsed<N> parse(const Literal<N>& filter) {
+            Parsed<N> p;
+            const char* str = filter.str;
+            const char* end = filter.str + N - 1;
+
+            if (str == end)
+                invalidStaticFilter("empty filter");
+
+            if (*str != '{') {
+                p.addGroup(str, end);
+            }
+            else {
+                const char* c = str;
+                while (c < end) {
+                    if (*c == ',' || *c == ' ') {
+                        c++;
+                        continue;
+                    }
+                    if (*c != '{')
+                        invalidStaticFilter("text outside of a {group}");
+
+                    const char* groupEnd = c + 1;
+                    while (groupEnd < end && *groupEnd != '}') {
+                        if (*groupEnd == '{')
+                            invalidStaticFilter("nested '{'");
+                        groupEnd++;
+                    }
+                    if (groupEnd == end)
+                        invalidStaticFilter("'{' without '}'");
+
+                    p.addGroup(c + 1, groupEnd);
+                    c = groupEnd + 1;
+                }
+            }
+
+            // like at runtime, a group with everything is added at the end
+            const char all[] = "*.*";
+            p.addGroup(all, all + 3);
+            return p;
+        }
+
+        template<size_t N>
+        struct Labels {
+            const char* labels[Parsed<N>::MaxGroups] = {};
+        };
+        template<size_t N>
+        consteval Labels<N> getLabels(const Parsed<N>& p) {
+            Labels<N> l;
+            for (size_t i = 0; i < p.numGroups; i++)
+                l.labels[i] = p.text + p.groups[i].label;
+            return l;
+        }
+
+        // matches the whole str, '*' can backtrack
+        inline bool matchGlob(const Token* tok, const Token* tokEnd, const char* str, const char* strEnd) {
+            const Token* starTok = NULL;
+            const char* starStr = NULL;
+            while (str < strEnd) {
+                if (tok < tokEnd && tok->anyString) {
+                    starTok = ++tok;
+                    starStr = str;
+                    continue;
+                }
+                if (tok < tokEnd && tok->matches((uint8_t)*str)) {
+                    str++;
+                    if (tok->wholeChar) {
+                        while (str < strEnd && ((uint8_t)*str & 0xC0) == 0x80)
+                            str++;
+                    }
+                    tok++;
+                    continue;
+                }
+                if (!starTok)
+                    return false;
+                tok = starTok; // let the last '*' eat one more char
+                str = ++starStr;
+            }
+            while (tok < tokEnd && tok->anyString)
+                tok++;
+            return tok == tokEnd;
+        }
+    }
+
+    template<StaticFilterImpl::Literal Filter>
+    class StaticFilter {
+    private:
+        static constexpr auto parsed = StaticFilterImpl::parse(Filter);
+        static constexpr auto labels = StaticFilterImpl::getLabels(parsed);
+
+        // compares with a literal of constant length, so the compiler can unroll it
+        template<size_t TextBegin, size_t Len>
+        static bool equalsText(const char* str) {
+            for (size_t i = 0; i < Len; i++) {
+                if (str[i] != parsed.text[TextBegin + i])
+                    return false;
+            }
+            return true;
+        }
+
+        template<size_t P>
+        static bool matches(const char* name, size_t len) {
+            constexpr StaticFilterImpl::Pattern pat = parsed.patterns[P];
+            constexpr size_t textLen = pat.textEnd - pat.textBegin;
+            if constexpr (pat.type == StaticFilterImpl::Pattern_Exact) {
+                return len == textLen && equalsText<pat.textBegin, textLen>(name);
+            }
+            else if constexpr (pat.type == StaticFilterImpl::Pattern_Prefix) {
+                return len >= textLen && equalsText<pat.textBegin, textLen>(name);
+            }
+            else if constexpr (pat.type == StaticFilterImpl::Pattern_Suffix) {
+                return len >= textLen && equalsText<pat.textBegin, textLen>(name + len - textLen);
+            }
+            else if constexpr (pat.type == StaticFilterImpl::Pattern_Substring) {
+                for (size_t i = 0; i + textLen <= len; i++) {
+                    if (name[i] == parsed.text[pat.textBegin] && equalsText<pat.textBegin, textLen>(name + i))
+                        return true;
+                }
+                return false;
+            }
+            else {
+                return StaticFilterImpl::matchGlob(parsed.tokens + pat.tokenBegin, parsed.tokens + pat.tokenEnd, name, name + len);
+            }
+        }
+
+        // passes if any of the patterns [P, End) matches (or doesn't if it is negated)
+        template<size_t P, size_t End>
+        static bool anyPasses(const char* name, size_t len) {
+            if constexpr (P == End)
+                return false;
+            else
+                return matches<P>(name, len) != parsed.patterns[P].negated || anyPasses<P + 1, End>(name, len);
+        }
+
+        template<size_t G>
+        static bool passesGroup(const char* name, size_t len, size_t group) {
+            if constexpr (G == parsed.numGroups) {
+                return true;
+            }
+            else {
+                constexpr StaticFilterImpl::Group g = parsed.groups[G];
+                if (group != G)
+                    return passesGroup<G + 1>(name, len, group);
+                if constexpr (g.numPatterns == 0 || g.matchesAll)
+                    return true;
+                else
+                    return anyPasses<g.patternBegin, g.patternEnd>(name, len);
+            }
+        }
+    public:
+        static bool passes(const char* name, const char* nameEnd, size_t group) {
+            return passesGroup<0>(name, (size_t)(nameEnd - name), group);
+        }
+
+        static constexpr FilterDesc desc = { labels.labels, parsed.numGroups, passes };
+    };
+}
+
+#endif
+
 
 #endif
\ No newline at end of file
@@ -15,6 +15,10 @@
 	#include <dirent.h>
 	#include <stdlib.h>
 	#include <limits.h>
+	#include <time.h> // clock_gettime
+	#include <fcntl.h> // open
+	#include <unistd.h> // close
+	#include <sys/mman.h> // mmap
 
 	#define GETCWD getcwd
 	#define GETABS realpath
@@ -24,6 +28,10 @@
 #define DT_HAS_STAT
 #endif
 
+#if defined(IMGUIFD_ENABLE_THREADS) && !defined(_WIN32)
+	#include <pthread.h>
+#endif
+
 
 ds::string ImGuiFD::Native::getAbsolutePath(const char* path_) {
 	if (strlen(path_) == 1 && path_[0] == '/')
@@ -70,7 +78,7 @@ bool ImGuiFD::Native::rename(const char* name, const char* newName) {
 	return ::rename(name, newName) == 0;
 }
 
-static void statDirEnt(ImGuiFD::DirEntry* entry) {
+void ImGuiFD::Native::statDirEnt(DirEntry* entry) {
 	ds::string path = ImGuiFD::Native::makePathStrOSComply(entry->path);
 
 #ifdef DT_HAS_STAT
@@ -233,6 +241,128 @@ ds::vector<ImGuiFD::DirEntry> ImGuiFD::Native::loadDirEnts(const char* path_, bo
 	return entrys;
 }
 
+bool ImGuiFD::Native::listDir(const char* path, void (*fn)(void* userData, const char* name, bool isFolder), void* userData, bool followLinks) {
+#ifdef _WIN32
+	WIN32_FIND_DATAA fdata;
+	HANDLE findH = FindFirstFileA((makePathStrOSComply(path) + "/*").c_str(), &fdata);
+	if (findH == INVALID_HANDLE_VALUE)
+		return false;
+
+	do {
+		if (strcmp(fdata.cFileName, ".") == 0 || strcmp(fdata.cFileName, "..") == 0)
+			continue;
+		const DWORD attribs = fdata.dwFileAttributes;
+		fn(userData, fdata.cFileName, (attribs & FILE_ATTRIBUTE_DIRECTORY) && (followLinks || !(attribs & FILE_ATTRIBUTE_REPARSE_POINT)));
+	} while (FindNextFileA(findH, &fdata) != 0);
+
+	FindClose(findH);
+	return true;
+#else
+	const ds::string dir = makePathStrOSComply(path);
+	DIR* d = opendir(dir.c_str());
+	if (!d)
+		return false;
+
+	while (dirent* de = readdir(d)) {
+		if (de->d_name[0] == '.' && (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0))
+			continue;
+
+		bool isFolder = de->d_type == DT_DIR;
+		if (de->d_type == DT_UNKNOWN || (followLinks && de->d_type == DT_LNK)) { // not every file system fills in d_type
+			struct stat st;
+			const ds::string entryPath = dir + "/" + de->d_name;
+			isFolder = (followLinks ? stat(entryPath.c_str(), &st) : lstat(entryPath.c_str(), &st)) == 0 && S_ISDIR(st.st_mode);
+		}
+		fn(userData, de->d_name, isFolder);
+	}
+
+	closedir(d);
+	return true;
+#endif
+}
+
+bool ImGuiFD::Native::getFileId(const char* path, uint64_t* device, uint64_t* inode) {
+#ifdef _WIN32
+	// FILE_FLAG_BACKUP_SEMANTICS is needed to open directories
+	HANDLE file = CreateFileA(makePathStrOSComply(path).c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	BY_HANDLE_FILE_INFORMATION info;
+	const bool success = GetFileInformationByHandle(file, &info) != 0;
+	CloseHandle(file);
+	if (!success)
+		return false;
+
+	*device = info.dwVolumeSerialNumber;
+	*inode = ((uint64_t)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+	return true;
+#else
+	struct stat st;
+	if (stat(makePathStrOSComply(path).c_str(), &st) != 0)
+		return false;
+
+	*device = (uint64_t)st.st_dev;
+	*inode = (uint64_t)st.st_ino;
+	return true;
+#endif
+}
+
+const void* ImGuiFD::Native::mapFile(const char* path, size_t* size) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(makePathStrOSComply(path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return NULL;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (!mapping)
+		return NULL;
+
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping); // the view keeps the mapping alive
+	if (!data)
+		return NULL;
+
+	*size = (size_t)fileSize.QuadPart;
+	return data;
+#else
+	const int fd = open(makePathStrOSComply(path).c_str(), O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return NULL;
+	}
+
+	void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping stays valid
+	if (data == MAP_FAILED)
+		return NULL;
+
+	*size = (size_t)st.st_size;
+	return data;
+#endif
+}
+void ImGuiFD::Native::unmapFile(const void* data, size_t size) {
+	if (!data)
+		return;
+#ifdef _WIN32
+	(void)size;
+	UnmapViewOfFile(data);
+#else
+	munmap((void*)data, size);
+#endif
+}
+
 bool ImGuiFD::Native::isValidDir(const char* dir) {
 #ifdef DT_HAS_STAT
 	struct stat info;
@@ -265,4 +395,302 @@ ds::string ImGuiFD::Native::makePathStrOSComply(const char* path) {
 	}
 #endif
 	return path;
-}
\ No newline at end of file
+}
+
+double ImGuiFD::Native::getTime() {
+#ifdef _WIN32
+	LARGE_INTEGER freq, counter;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+size_t ImGuiFD::Native::getNumThreads(size_t maxThreads) {
+#ifdef IMGUIFD_ENABLE_THREADS
+	if (maxThreads > 0)
+		return maxThreads;
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	return sysInfo.dwNumberOfProcessors > 0 ? (size_t)sysInfo.dwNumberOfProcessors : 1;
+#else
+	const long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+	return numCores > 0 ? (size_t)numCores : 1;
+#endif
+#else
+	(void)maxThreads;
+	return 1;
+#endif
+}
+
+struct ParallelForJob {
+	size_t numTasks;
+	volatile size_t nextTask;
+	void (*fn)(void* userData, size_t taskInd, size_t threadInd);
+	void* userData;
+};
+struct ParallelForWorker {
+	ParallelForJob* job;
+	size_t threadInd;
+};
+
+static size_t claimTask(ParallelForJob* job) {
+#if !defined(IMGUIFD_ENABLE_THREADS)
+	const size_t task = job->nextTask; // not ++, that is deprecated on volatiles in C++20
+	job->nextTask = task + 1;
+	return task;
+#elif defined(_MSC_VER)
+#ifdef _WIN64
+	return (size_t)InterlockedExchangeAdd64((volatile LONG64*)&job->nextTask, 1);
+#else
+	return (size_t)InterlockedExchangeAdd((volatile LONG*)&job->nextTask, 1);
+#endif
+#else
+	return __atomic_fetch_add(&job->nextTask, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static void runParallelForWorker(ParallelForWorker* worker) {
+	ParallelForJob* job = worker->job;
+	while (true) {
+		const size_t task = claimTask(job);
+		if (task >= job->numTasks)
+			break;
+		job->fn(job->userData, task, worker->threadInd);
+	}
+}
+
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+static DWORD WINAPI parallelForThreadProc(LPVOID param) {
+	runParallelForWorker((ParallelForWorker*)param);
+	return 0;
+}
+#else
+static void* parallelForThreadProc(void* param) {
+	runParallelForWorker((ParallelForWorker*)param);
+	return NULL;
+}
+#endif
+#endif
+
+void ImGuiFD::Native::parallelFor(size_t numTasks, void (*fn)(void* userData, size_t taskInd, size_t threadInd), void* userData, size_t maxThreads) {
+	ParallelForJob job;
+	job.numTasks = numTasks;
+	job.nextTask = 0;
+	job.fn = fn;
+	job.userData = userData;
+
+	size_t numThreads = getNumThreads(maxThreads);
+	if (numThreads > numTasks)
+		numThreads = numTasks;
+
+	ds::vector<ParallelForWorker> workers(numThreads > 0 ? numThreads : 1);
+	for (size_t i = 0; i < workers.size(); i++) {
+		workers[i].job = &job;
+		workers[i].threadInd = i;
+	}
+
+#ifdef IMGUIFD_ENABLE_THREADS
+	// the calling thread is worker 0
+#ifdef _WIN32
+	ds::vector<HANDLE> threads;
+	for (size_t i = 1; i < workers.size(); i++) {
+		HANDLE thread = CreateThread(NULL, 0, parallelForThreadProc, &workers[i], 0, NULL);
+		if (thread != NULL)
+			threads.push_back(thread);
+	}
+	runParallelForWorker(&workers[0]);
+	for (size_t i = 0; i < threads.size(); i++) {
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+	}
+#else
+	ds::vector<pthread_t> threads;
+	for (size_t i = 1; i < workers.size(); i++) {
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, parallelForThreadProc, &workers[i]) == 0)
+			threads.push_back(thread);
+	}
+	runParallelForWorker(&workers[0]);
+	for (size_t i = 0; i < threads.size(); i++)
+		pthread_join(threads[i], NULL);
+#endif
+#else
+	runParallelForWorker(&workers[0]);
+#endif
+}
+
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+struct ImGuiFD::Native::Thread {
+	HANDLE handle;
+	void (*fn)(void* userData);
+	void* userData;
+};
+struct ImGuiFD::Native::Mutex {
+	SRWLOCK lock;
+};
+struct ImGuiFD::Native::Condition {
+	CONDITION_VARIABLE cond;
+};
+
+static DWORD WINAPI threadProc(LPVOID param) {
+	ImGuiFD::Native::Thread* thread = (ImGuiFD::Native::Thread*)param;
+	thread->fn(thread->userData);
+	return 0;
+}
+#else
+struct ImGuiFD::Native::Thread {
+	pthread_t handle;
+	void (*fn)(void* userData);
+	void* userData;
+};
+struct ImGuiFD::Native::Mutex {
+	pthread_mutex_t lock;
+};
+struct ImGuiFD::Native::Condition {
+	pthread_cond_t cond;
+};
+
+static void* threadProc(void* param) {
+	ImGuiFD::Native::Thread* thread = (ImGuiFD::Native::Thread*)param;
+	thread->fn(thread->userData);
+	return NULL;
+}
+#endif
+#endif
+
+ImGuiFD::Native::Thread* ImGuiFD::Native::startThread(void (*fn)(void* userData), void* userData) {
+#ifdef IMGUIFD_ENABLE_THREADS
+	Thread* thread = (Thread*)IM_ALLOC(sizeof(Thread));
+	thread->fn = fn;
+	thread->userData = userData;
+#ifdef _WIN32
+	thread->handle = CreateThread(NULL, 0, threadProc, thread, 0, NULL);
+	if (thread->handle == NULL) {
+#else
+	if (pthread_create(&thread->handle, NULL, threadProc, thread) != 0) {
+#endif
+		IM_FREE(thread);
+		return NULL;
+	}
+	return thread;
+#else
+	(void)fn;
+	(void)userData;
+	return NULL;
+#endif
+}
+void ImGuiFD::Native::joinThread(Thread* thread) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+#else
+	pthread_join(thread->handle, NULL);
+#endif
+	IM_FREE(thread);
+#else
+	(void)thread;
+#endif
+}
+
+ImGuiFD::Native::Mutex* ImGuiFD::Native::createMutex() {
+#ifdef IMGUIFD_ENABLE_THREADS
+	Mutex* mutex = (Mutex*)IM_ALLOC(sizeof(Mutex));
+#ifdef _WIN32
+	InitializeSRWLock(&mutex->lock);
+#else
+	pthread_mutex_init(&mutex->lock, NULL);
+#endif
+	return mutex;
+#else
+	return NULL;
+#endif
+}
+void ImGuiFD::Native::destroyMutex(Mutex* mutex) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifndef _WIN32
+	pthread_mutex_destroy(&mutex->lock);
+#endif
+	IM_FREE(mutex);
+#else
+	(void)mutex;
+#endif
+}
+void ImGuiFD::Native::lockMutex(Mutex* mutex) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+	AcquireSRWLockExclusive(&mutex->lock);
+#else
+	pthread_mutex_lock(&mutex->lock);
+#endif
+#else
+	(void)mutex;
+#endif
+}
+void ImGuiFD::Native::unlockMutex(Mutex* mutex) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+	ReleaseSRWLockExclusive(&mutex->lock);
+#else
+	pthread_mutex_unlock(&mutex->lock);
+#endif
+#else
+	(void)mutex;
+#endif
+}
+
+ImGuiFD::Native::Condition* ImGuiFD::Native::createCondition() {
+#ifdef IMGUIFD_ENABLE_THREADS
+	Condition* cond = (Condition*)IM_ALLOC(sizeof(Condition));
+#ifdef _WIN32
+	InitializeConditionVariable(&cond->cond);
+#else
+	pthread_cond_init(&cond->cond, NULL);
+#endif
+	return cond;
+#else
+	return NULL;
+#endif
+}
+void ImGuiFD::Native::destroyCondition(Condition* cond) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifndef _WIN32
+	pthread_cond_destroy(&cond->cond);
+#endif
+	IM_FREE(cond);
+#else
+	(void)cond;
+#endif
+}
+void ImGuiFD::Native::waitCondition(Condition* cond, Mutex* mutex) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+	SleepConditionVariableSRW(&cond->cond, &mutex->lock, INFINITE, 0);
+#else
+	pthread_cond_wait(&cond->cond, &mutex->lock);
+#endif
+#else
+	(void)cond;
+	(void)mutex;
+	IM_ASSERT(0 && "there is no other thread to wake this one up");
+#endif
+}
+void ImGuiFD::Native::wakeAll(Condition* cond) {
+#ifdef IMGUIFD_ENABLE_THREADS
+#ifdef _WIN32
+	WakeAllConditionVariable(&cond->cond);
+#else
+	pthread_cond_broadcast(&cond->cond);
+#endif
+#else
+	(void)cond;
+#endif
+}
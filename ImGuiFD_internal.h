@@ -5,6 +5,10 @@
 #include "ImGuiFD.h"
 #include "imgui_internal.h"
 
+#ifdef _MSC_VER
+#include <intrin.h> // _BitScanForward64, __popcnt64
+#endif
+
 #ifdef IMGUIFD_ENABLE_STL
 #include <functional>
 #include <vector>
@@ -95,6 +99,8 @@ namespace ds {
 		inline T&           operator[](size_t i)                { IM_ASSERT(i < Size); return Data[i]; }
 		inline const T&     operator[](size_t i) const          { IM_ASSERT(i < Size); return Data[i]; }
 
+		inline T*           data()                              { return Data; }
+		inline const T*     data() const                        { return Data; }
 		inline T*           begin()                             { return Data; }
 		inline const T*     begin() const                       { return Data; }
 		inline T*           end()                               { return Data + Size; }
@@ -107,6 +113,10 @@ namespace ds {
 
 		inline size_t       _grow_capacity(size_t sz) const     { size_t new_capacity = Capacity ? (Capacity + Capacity / 2) : 8; return new_capacity > sz ? new_capacity : sz; }
 		inline void         resize(size_t new_size)             { 
+			if (new_size < Size) {
+				shrink(new_size);
+				return;
+			}
 			if (new_size > Capacity) 
 				reserve(_grow_capacity(new_size)); 
 			for (size_t i = Size; i < new_size; i++) {
@@ -114,7 +124,7 @@ namespace ds {
 			}
 			Size = new_size; 
 		}
-		inline void         resize(size_t new_size, const T& v) { if (new_size > Capacity) reserve(_grow_capacity(new_size)); if (new_size > Size) for (size_t n = Size; n < new_size; n++) IM_PLACEMENT_NEW(&Data[n]) T(v); Size = new_size; }
+		inline void         resize(size_t new_size, const T& v) { if (new_size < Size) { shrink(new_size); return; } if (new_size > Capacity) reserve(_grow_capacity(new_size)); for (size_t n = Size; n < new_size; n++) IM_PLACEMENT_NEW(&Data[n]) T(v); Size = new_size; }
 		inline void         shrink(size_t new_size)             {  // Resize a vector to a smaller size, guaranteed not to cause a reallocation
 			IM_ASSERT(new_size <= Size); 
 			for (size_t i = new_size; i < Size; i++) {
@@ -176,12 +186,16 @@ namespace ds {
 				reserve(_grow_capacity(Size + 1)); 
 			if (off < (ptrdiff_t)Size) {
 				//memmove(Data + off + 1, Data + off, ((size_t)Size - (size_t)off) * sizeof(T));
-				for(size_t i = off; i+1 < Size; i++) {
-					Data[i+1] = Data[i];
+				IM_PLACEMENT_NEW(&Data[Size]) T(Data[Size-1]); // back to front, the last one moves into unconstructed memory
+				for(size_t i = Size-1; i > (size_t)off; i--) {
+					Data[i] = Data[i-1];
 				}
+				Data[off] = v;
+			}
+			else {
+				IM_PLACEMENT_NEW(&Data[off]) T(v);
 			}
-				 
-			IM_PLACEMENT_NEW(&Data[off]) T(v); Size++; 
+			Size++; 
 			return Data + off; 
 		}
 		inline bool         contains(const T& v) const          { const T* data = Data;  const T* data_end = Data + Size; while (data < data_end) if (*data++ == v) return true; return false; }
@@ -211,7 +225,7 @@ namespace ds {
 			
 		}
 		inline string(const char* s, const char* s_end = 0) : data((s_end ? (s_end-s) : strlen(s))+1) {
-			for (size_t i = 0; i < data.size(); i++) {
+			for (size_t i = 0; i + 1 < data.size(); i++) {
 				data[i] = s[i];
 			}
 			data.back() = 0;
@@ -334,66 +348,40 @@ namespace ds {
 	// find value, if not found return (size_t)-1; compare needs to be a function like object with (const T& a, size_t ind_of_b) -> int
 	template<typename T,typename CMP>
 	inline size_t binarySearchExclusive(size_t len, const T& value, const CMP& compare) {
-		if (len == 0)
-			return (size_t)-1;
-
 		size_t from = 0;
-		size_t to = len-1;
-		while (from != to) {
+		size_t to = len;
+		while (from < to) {
 			size_t mid = from + (to-from) / 2;
 
 			int cmp = compare(value, mid);
 
-			if (cmp == 0) {
+			if (cmp == 0)
 				return mid;
-			}
-			else if (cmp < 0) {
-				if (mid == to)
-					goto fail;
+			else if (cmp < 0)
 				to = mid;
-			}
-			else {
-				if (mid == from)
-					goto fail;
-				from = mid;
-			}
+			else
+				from = mid + 1;
 		}
 
-		if (compare(value, from) == 0)
-			return from;
-
-	fail:
 		return (size_t)-1;
 	}
 
 	// find value, if not found return where to insert it; compare needs to be a function like object with (const T& a, size_t ind_of_b) -> int
 	template<typename T,typename CMP>
 	inline size_t binarySearchInclusive(size_t len, const T& value, const CMP& compare) {
-		if (len == 0)
-			return 0;
-
 		size_t from = 0;
-		size_t to = len-1;
+		size_t to = len;
 		while (from < to) {
 			size_t mid = from + (to-from) / 2;
 
 			int cmp = compare(value, mid);
 
-			if (cmp == 0) {
+			if (cmp == 0)
 				return mid;
-			}
-			else if (cmp < 0) {
-				if (mid == to) {
-					return from;
-				}
+			else if (cmp < 0)
 				to = mid;
-			}
-			else {
-				if (mid == from) {
-					return from;
-				}
-				from = mid;
-			}
+			else
+				from = mid + 1;
 		}
 
 		return from;
@@ -448,11 +436,193 @@ namespace ds {
 			return getIndContains(id) != (size_t)-1;
 		}
 
+		inline size_t size() const {
+			return data.size();
+		}
+		inline T& getByInd(size_t ind) {
+			return data[ind].second;
+		}
+
 		inline void clear() {
 			data.clear();
 		}
 	};
 
+	// open addressing hash set of strings
+	class stringset {
+	private:
+		struct Slot {
+			ImGuiID hash;
+			int32_t ind; // index into keys, -1 for free slots
+		};
+		vector<string> keys;
+		vector<Slot> table;
+
+		inline void insertSlot(ImGuiID hash, int32_t ind) {
+			size_t slot = hash & (table.size() - 1);
+			while (table[slot].ind != -1)
+				slot = (slot + 1) & (table.size() - 1);
+			table[slot].hash = hash;
+			table[slot].ind = ind;
+		}
+		inline void rehash(size_t tableSize) {
+			Slot freeSlot = { 0, -1 };
+			table = vector<Slot>(tableSize, freeSlot);
+			for (size_t i = 0; i < keys.size(); i++)
+				insertSlot(ImHashData(keys[i].c_str(), keys[i].size()), (int32_t)i);
+		}
+	public:
+		enum : size_t { NotFound = (size_t)-1 };
+
+		// returns the index of str, keys keep their index (in the order they were added)
+		inline size_t add(const char* str, size_t len) {
+			const size_t ind = find(str, len);
+			if (ind != NotFound)
+				return ind;
+			keys.push_back(string(str, str + len));
+			if (table.size() < keys.size() * 2)
+				rehash(table.size() > 0 ? table.size() * 2 : 16);
+			else
+				insertSlot(ImHashData(str, len), (int32_t)(keys.size() - 1));
+			return keys.size() - 1;
+		}
+
+		// returns the index of str or NotFound
+		inline size_t find(const char* str, size_t len) const {
+			if (keys.size() == 0)
+				return NotFound;
+			const ImGuiID hash = ImHashData(str, len);
+			size_t slot = hash & (table.size() - 1);
+			while (table[slot].ind != -1) {
+				if (table[slot].hash == hash) {
+					const string& key = keys[table[slot].ind];
+					if (key.size() == len && memcmp(key.c_str(), str, len) == 0)
+						return (size_t)table[slot].ind;
+				}
+				slot = (slot + 1) & (table.size() - 1);
+			}
+			return NotFound;
+		}
+		inline bool contains(const char* str, size_t len) const {
+			return find(str, len) != NotFound;
+		}
+
+		inline const string& get(size_t ind) const {
+			return keys[ind];
+		}
+		inline size_t size() const {
+			return keys.size();
+		}
+		inline void clear() {
+			keys.clear();
+			table.clear();
+		}
+	};
+
+	inline unsigned countTrailingZeros64(uint64_t v) { // v must not be 0
+#if defined(__GNUC__) || defined(__clang__)
+		return (unsigned)__builtin_ctzll(v);
+#elif defined(_MSC_VER) && defined(_WIN64)
+		unsigned long ind;
+		_BitScanForward64(&ind, v);
+		return (unsigned)ind;
+#else
+		unsigned n = 0;
+		while ((v & 1) == 0) {
+			v >>= 1;
+			n++;
+		}
+		return n;
+#endif
+	}
+	inline unsigned popCount64(uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+		return (unsigned)__builtin_popcountll(v);
+#else
+		v = v - ((v >> 1) & 0x5555555555555555ull);
+		v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+		v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+		return (unsigned)((v * 0x0101010101010101ull) >> 56);
+#endif
+	}
+
+	class bitset {
+	private:
+		vector<uint64_t> words;
+		size_t numBits = 0;
+	public:
+		inline bitset() {
+
+		}
+		inline bitset(size_t size, bool value = false) {
+			resize(size, value);
+		}
+
+		inline void resize(size_t size, bool value = false) {
+			numBits = size;
+			words = vector<uint64_t>((size + 63) / 64, value ? ~(uint64_t)0 : 0);
+			if (value && (size & 63) != 0)
+				words.back() &= ((uint64_t)1 << (size & 63)) - 1; // bits past the end always stay 0
+		}
+
+		// keeps all bits, the new ones are 0
+		inline void grow(size_t size) {
+			IM_ASSERT(size >= numBits);
+			numBits = size;
+			words.resize((size + 63) / 64, 0);
+		}
+
+		inline size_t size() const {
+			return numBits;
+		}
+		inline size_t numWords() const {
+			return words.size();
+		}
+		inline uint64_t& word(size_t i) {
+			return words[i];
+		}
+		inline const uint64_t& word(size_t i) const {
+			return words[i];
+		}
+
+		inline bool get(size_t i) const {
+			IM_ASSERT(i < numBits);
+			return (words[i >> 6] >> (i & 63)) & 1;
+		}
+		inline void set(size_t i) {
+			IM_ASSERT(i < numBits);
+			words[i >> 6] |= (uint64_t)1 << (i & 63);
+		}
+		inline void reset(size_t i) {
+			IM_ASSERT(i < numBits);
+			words[i >> 6] &= ~((uint64_t)1 << (i & 63));
+		}
+
+		inline void andWith(const bitset& other) {
+			IM_ASSERT(other.numBits == numBits);
+			for (size_t i = 0; i < words.size(); i++)
+				words[i] &= other.words[i];
+		}
+
+		inline size_t count() const {
+			size_t cnt = 0;
+			for (size_t i = 0; i < words.size(); i++)
+				cnt += popCount64(words[i]);
+			return cnt;
+		}
+
+		// appends the indices of all set bits to out (in ascending order)
+		inline void getSetInds(vector<size_t>* out) const {
+			for (size_t i = 0; i < words.size(); i++) {
+				uint64_t w = words[i];
+				while (w != 0) {
+					out->push_back(i * 64 + countTrailingZeros64(w));
+					w &= w - 1;
+				}
+			}
+		}
+	};
+
 	template<typename T>
 	class set {
 	private:
@@ -762,6 +932,49 @@ namespace ImGuiFD {
 		bool makeFolder(const char* path);
 
 		ds::string makePathStrOSComply(const char* path);
+
+		// fills in size and dates of entry from entry->path
+		void statDirEnt(DirEntry* entry);
+
+		// calls fn for every entry of the directory (without "." and ".."). faster than loadDirEnts() since nothing gets stat'ed.
+		// links to directories count as files unless followLinks is set, so walking a tree with it can't end up in a cycle.
+		// with followLinks check getFileId() to not visit a directory twice
+		bool listDir(const char* path, void (*fn)(void* userData, const char* name, bool isFolder), void* userData, bool followLinks = false);
+
+		// identifies the file or directory path points to (after following links)
+		bool getFileId(const char* path, uint64_t* device, uint64_t* inode);
+
+		// maps the whole file read only into memory, returns NULL on failure (or if it is empty)
+		const void* mapFile(const char* path, size_t* size);
+		void unmapFile(const void* data, size_t size);
+
+		// monotonic time in seconds, for measuring durations
+		double getTime();
+
+		// number of threads parallelFor() uses: maxThreads, or one per core if maxThreads is 0 (always 1 without IMGUIFD_ENABLE_THREADS)
+		size_t getNumThreads(size_t maxThreads = 0);
+		// calls fn(userData, taskInd, threadInd) for every taskInd in [0, numTasks), spread over getNumThreads(maxThreads) threads.
+		// threadInd is in [0, getNumThreads(maxThreads)), returns once all tasks are done
+		void parallelFor(size_t numTasks, void (*fn)(void* userData, size_t taskInd, size_t threadInd), void* userData, size_t maxThreads = 0);
+
+		// runs fn(userData) on a thread of its own. only with IMGUIFD_ENABLE_THREADS, otherwise NULL is returned and the caller has to do the work
+		struct Thread;
+		Thread* startThread(void (*fn)(void* userData), void* userData);
+		// waits for fn to return and frees thread
+		void joinThread(Thread* thread);
+
+		// without IMGUIFD_ENABLE_THREADS these do nothing
+		struct Mutex;
+		Mutex* createMutex();
+		void destroyMutex(Mutex* mutex);
+		void lockMutex(Mutex* mutex);
+		void unlockMutex(Mutex* mutex);
+		// mutex has to be locked, it gets unlocked until another thread calls wakeAll() (or the wait ends spuriously)
+		struct Condition;
+		Condition* createCondition();
+		void destroyCondition(Condition* cond);
+		void waitCondition(Condition* cond, Mutex* mutex);
+		void wakeAll(Condition* cond);
 	}
 }
 
@@ -0,0 +1,129 @@
+// benchmark of the substring search (utils::findSubstring()), build it once as is and once with -DIMGUIFD_DISABLE_SIMD
+// to compare the SSE2/AVX2 kernel with the scalar path, e.g.
+// g++ -std=c++20 -O2 -I<imgui> -I.. ImGuiFDBench.cpp ../ImGuiFDNative.cpp <imgui>/imgui*.cpp -lpthread
+// g++ -std=c++20 -O2 -DIMGUIFD_DISABLE_SIMD -I<imgui> -I.. ImGuiFDBench.cpp ../ImGuiFDNative.cpp <imgui>/imgui*.cpp -lpthread
+
+#include "../ImGuiFD.cpp"
+
+#include <stdio.h>
+
+using namespace ImGuiFD;
+
+enum {
+	NumNames = 200000,
+	TextSize = 64 << 20,
+	NumRuns = 5 // the fastest run counts
+};
+
+#if defined(IMGUIFD_ENABLE_AVX2)
+static const char* kernelName = "AVX2";
+#elif defined(IMGUIFD_ENABLE_SSE2)
+static const char* kernelName = "SSE2";
+#else
+static const char* kernelName = "scalar";
+#endif
+
+static volatile size_t sink = 0; // keeps the searches from being optimized away
+
+// the names back to back, each one 0 terminated, like the folded names of EntryManager
+static void makeNames(ds::vector<char>* names, ds::vector<size_t>* offs) {
+	static const char* const words[] = { "report", "frame", "IMG", "backup", "notes", "final", "draft", "scan" };
+	static const char* const exts[] = { "txt", "png", "jpg", "cpp", "h", "tar.gz", "log" };
+	uint32_t rnd = 12345;
+	for (size_t i = 0; i < NumNames; i++) {
+		rnd = rnd * 1664525u + 1013904223u;
+		char name[128];
+		const int len = snprintf(name, sizeof(name), "%s_%s_%u.%s", words[(rnd >> 8) % 8], words[(rnd >> 12) % 8], (unsigned)(rnd >> 16), exts[(rnd >> 4) % 7]);
+		offs->push_back(names->size());
+		for (int c = 0; c < len; c++)
+			names->push_back(utils::toLowerAscii(name[c]));
+		names->push_back(0);
+	}
+	offs->push_back(names->size());
+}
+
+// like EntryManager::findSubstringMatches(): one search over all names, continuing after the name of every match
+static size_t countMatchesInBuffer(const ds::vector<char>& names, const ds::vector<size_t>& offs, const char* text) {
+	const size_t textLen = strlen(text);
+	size_t count = 0;
+	size_t pos = 0;
+	size_t i = 0;
+	while (pos < names.size()) {
+		const char* found = utils::findSubstring(names.data() + pos, names.size() - pos, text, textLen);
+		if (!found)
+			break;
+		const size_t foundOff = found - names.data();
+		while (offs[i+1] <= foundOff)
+			i++;
+		count++;
+		pos = offs[i+1];
+		i++;
+	}
+	return count;
+}
+// the same with one search per name
+static size_t countMatchesPerName(const ds::vector<char>& names, const ds::vector<size_t>& offs, const char* text) {
+	const size_t textLen = strlen(text);
+	size_t count = 0;
+	for (size_t i = 0; i + 1 < offs.size(); i++) {
+		if (utils::findSubstring(names.data() + offs[i], offs[i+1] - offs[i] - 1, text, textLen))
+			count++;
+	}
+	return count;
+}
+
+struct Timing {
+	double best = 1e300;
+	size_t result = 0;
+};
+template<typename Fn>
+static Timing measure(Fn fn) {
+	Timing t;
+	for (int run = 0; run < NumRuns; run++) {
+		const double start = Native::getTime();
+		t.result = fn();
+		const double time = Native::getTime() - start;
+		if (time < t.best)
+			t.best = time;
+	}
+	sink = sink + t.result;
+	return t;
+}
+static void report(const char* what, const Timing& t, size_t bytes) {
+	printf("%-44s %8.3f ms  %8.0f MB/s  (%zu)\n", what, t.best * 1000, (double)bytes / t.best / (1 << 20), t.result);
+}
+
+int main() {
+	printf("kernel: %s\n", kernelName);
+
+	ds::vector<char> names;
+	ds::vector<size_t> offs;
+	makeNames(&names, &offs);
+	const char* const needles[] = { "report_final", "xyz", ".tar.gz", "e" };
+	for (size_t n = 0; n < sizeof(needles) / sizeof(needles[0]); n++) {
+		const char* needle = needles[n];
+		char what[128];
+		snprintf(what, sizeof(what), "names, one buffer, \"%s\"", needle);
+		report(what, measure([&] { return countMatchesInBuffer(names, offs, needle); }), names.size());
+		snprintf(what, sizeof(what), "names, per name, \"%s\"", needle);
+		report(what, measure([&] { return countMatchesPerName(names, offs, needle); }), names.size());
+	}
+
+	// file contents (see ContentSearch): mixed case text without the needle, so all of it gets scanned
+	ds::vector<char> text;
+	text.resize(TextSize);
+	uint32_t rnd = 777;
+	for (size_t i = 0; i < text.size(); i++) {
+		rnd = rnd * 1664525u + 1013904223u;
+		const uint32_t r = (rnd >> 16) % 40;
+		text[i] = r < 26 ? (char)('a' + r) : r < 32 ? (char)('A' + r - 26) : r < 38 ? ' ' : '\n';
+	}
+	const char* const lowerNeedles[] = { "timeout", "connection refused" };
+	for (size_t n = 0; n < sizeof(lowerNeedles) / sizeof(lowerNeedles[0]); n++) {
+		const char* needle = lowerNeedles[n];
+		char what[128];
+		snprintf(what, sizeof(what), "64MB text, ignore case, \"%s\"", needle);
+		report(what, measure([&] { return (size_t)(utils::findSubstringIgnoreCase(text.data(), text.size(), needle, strlen(needle)) != NULL); }), text.size());
+	}
+	return 0;
+}
@@ -0,0 +1,835 @@
+// regression tests, built and run by the Makefile next to this file ("make check IMGUI_DIR=<imgui>"), or by hand, e.g.
+// g++ -std=c++20 -DIMGUIFD_ENABLE_THREADS -I<imgui> -I.. ImGuiFDTests.cpp ../ImGuiFDNative.cpp <imgui>/imgui*.cpp -lpthread
+// returns the number of failed checks
+
+#include "../ImGuiFD.cpp"
+
+#include <stdio.h>
+
+static int numFailed = 0;
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #cond); numFailed++; } } while (0)
+
+using namespace ImGuiFD;
+
+static bool searchPasses(const char* search, const char* name) {
+	FileNameFilter filter;
+	filter.searchText = search;
+	filter.updateSearch();
+	ds::vector<char> folded;
+	unicode::appendKey(name, name + strlen(name), &folded);
+	folded.push_back(0);
+	return filter.passesSearch(folded.data(), folded.data() + folded.size() - 1);
+}
+static ds::string searchRequired(const char* search) {
+	FileNameFilter filter;
+	filter.searchText = search;
+	filter.updateSearch();
+	return filter.getSearchRequired() ? *filter.getSearchRequired() : ds::string();
+}
+
+// an optional literal between two runs must not join them into one required text
+static void testRegexRequiredText() {
+	CHECK(searchPasses("re:frame_x?yz", "frame_xyz"));
+	CHECK(searchPasses("re:frame_x?yz", "frame_yz"));
+	CHECK(searchPasses("re:abc?de", "abcde"));
+	CHECK(searchPasses("re:abc?de", "abde"));
+	CHECK(searchPasses("re:abc{0,1}de", "abcde"));
+	CHECK(!searchPasses("re:abc?de", "abxde"));
+	CHECK(searchRequired("re:frame_x?yz") == "frame_");
+	CHECK(searchRequired("re:abc?de") == "ab");
+
+	// the required text is used as a prefilter when filtering the listing
+	ds::vector<DirEntry> entries(2);
+	entries[0].id = 0;
+	entries[0].name = ImStrdup("frame_xyz");
+	entries[1].id = 1;
+	entries[1].name = ImStrdup("frame_yz");
+	FileDialog::EntryManager manager(NULL);
+	manager.setEntrysTo(entries);
+	manager.filter.searchText = "re:frame_x?yz";
+	manager.updateFiltering();
+	while (manager.isBusy())
+		manager.continueWork();
+	CHECK(manager.size() == 2);
+}
+
+// the regex syntax of the search (see Automaton::addRegex())
+static void testRegexSyntax() {
+	CHECK(searchPasses("re:^img_\\d{3,4}\\.png$", "IMG_0042.png"));
+	CHECK(!searchPasses("re:^img_\\d{3,4}\\.png$", "IMG_42.png"));
+	CHECK(!searchPasses("re:^img_\\d{3,4}\\.png$", "IMG_12345.png"));
+	CHECK(!searchPasses("re:^img_\\d{3,4}\\.png$", "old_IMG_0042.png"));
+	CHECK(searchPasses("re:report", "my_report_2024.txt")); // unanchored matches anywhere
+
+	CHECK(searchPasses("re:\\.(jpe?g|png)$", "a.jpeg"));
+	CHECK(searchPasses("re:\\.(jpe?g|png)$", "a.PNG"));
+	CHECK(!searchPasses("re:\\.(jpe?g|png)$", "a.png.bak"));
+	CHECK(searchPasses("re:^(?:ab)+$", "ababab"));
+	CHECK(!searchPasses("re:^(?:ab)+$", "aba"));
+
+	CHECK(searchPasses("re:^[a-c]\\w*\\s\\S$", "b_x1 z"));
+	CHECK(!searchPasses("re:^[a-c]\\w*\\s\\S$", "d_x1 z"));
+	CHECK(searchPasses("re:^[^0-9]+$", "abc"));
+	CHECK(!searchPasses("re:^[^0-9]+$", "a1c"));
+	CHECK(searchPasses("re:^a.c$", "a-c"));
+	CHECK(searchPasses("re:^a\\.c$", "a.c"));
+	CHECK(!searchPasses("re:^a\\.c$", "a-c"));
+	CHECK(searchPasses("re:^x{2}$", "xx"));
+	CHECK(!searchPasses("re:^x{2}$", "xxx"));
+	CHECK(searchPasses("re:^x{2,}$", "xxxx"));
+
+	// invalid regexes match nothing
+	CHECK(!searchPasses("re:(ab", "ab"));
+	CHECK(!searchPasses("re:a{2", "aa"));
+	CHECK(!searchPasses("re:[ab", "a"));
+	CHECK(searchPasses("re:", "anything"));
+}
+
+static DirEntry makeEntry(ImGuiID id, const char* name, size_t size) {
+	DirEntry entry;
+	entry.id = id;
+	entry.name = ImStrdup(name);
+	entry.size = size;
+	return entry;
+}
+
+static bool parsePredicate(const char* word, time_t now, MetaPredicate* out) {
+	bool valid = false;
+	return MetaPredicate::parse(word, word + strlen(word), now, out, &valid) && valid;
+}
+static time_t localTime(int year, int month, int day) {
+	tm t;
+	memset(&t, 0, sizeof(t));
+	t.tm_year = year - 1900;
+	t.tm_mon = month - 1;
+	t.tm_mday = day;
+	t.tm_isdst = -1;
+	return mktime(&t);
+}
+
+// "field:value" words of the search
+static void testPredicates() {
+	const time_t now = localTime(2026, 10, 19) + 12 * 3600;
+	MetaPredicate p;
+	CHECK(parsePredicate("size:>1k", now, &p));
+	CHECK(p.field == MetaPredicate::Field_Size && !p.passes(1024) && p.passes(1025));
+	CHECK(parsePredicate("size:<=10KiB", now, &p));
+	CHECK(p.passes(0) && p.passes(10240) && !p.passes(10241));
+	CHECK(parsePredicate("size:1M..5M", now, &p));
+	CHECK(!p.passes((1 << 20) - 1) && p.passes(1 << 20) && p.passes(5 << 20) && !p.passes((5 << 20) + 1));
+	CHECK(parsePredicate("size:1.5g", now, &p));
+	CHECK(p.passes(3LL << 29) && !p.passes((3LL << 29) + 1));
+	CHECK(!p.passes(-1)); // unknown sizes never pass
+
+	CHECK(parsePredicate("modified:<7d", now, &p));
+	CHECK(p.field == MetaPredicate::Field_Modified && p.passes(now - 6 * 86400) && !p.passes(now - 8 * 86400));
+	CHECK(parsePredicate("created:>1y", now, &p));
+	CHECK(p.field == MetaPredicate::Field_Created && p.passes(now - 400 * 86400) && !p.passes(now - 300 * 86400));
+	CHECK(parsePredicate("modified:2026-10", now, &p));
+	CHECK(p.passes(localTime(2026, 10, 1)) && p.passes(localTime(2026, 11, 1) - 1) && !p.passes(localTime(2026, 11, 1)));
+	CHECK(parsePredicate("modified:>=2026-01-15", now, &p));
+	CHECK(p.passes(localTime(2026, 1, 15)) && !p.passes(localTime(2026, 1, 15) - 1));
+	CHECK(parsePredicate("type:dir", now, &p));
+	CHECK(p.field == MetaPredicate::Field_Type && p.passes(1) && !p.passes(0));
+
+	CHECK(!parsePredicate("size:big", now, &p));
+	CHECK(!parsePredicate("modified:2026-02-30", now, &p));
+	CHECK(!parsePredicate("type:link", now, &p));
+	bool valid = true;
+	CHECK(!MetaPredicate::parse("report", "report" + 6, now, &p, &valid)); // not a predicate at all
+
+	// mixed with the text of the search
+	FileNameFilter filter;
+	filter.searchText = "report size:>1k type:file";
+	filter.updateSearch();
+	CHECK(filter.getSearchName() == "report");
+	CHECK(filter.getPredicates().size() == 2);
+	ds::vector<char> folded;
+	DirEntry big = makeEntry(0, "report.txt", 2048);
+	DirEntry small = makeEntry(1, "report.txt", 10);
+	DirEntry other = makeEntry(2, "notes.txt", 2048);
+	DirEntry folder = makeEntry(3, "reports", 4096);
+	folder.isFolder = true;
+	CHECK(filter.passesEntry(big, &folded));
+	CHECK(!filter.passesEntry(small, &folded));
+	CHECK(!filter.passesEntry(other, &folded));
+	CHECK(!filter.passesEntry(folder, &folded));
+}
+static void drainWork(FileDialog::EntryManager* manager) {
+	while (manager->isBusy())
+		manager->continueWork();
+}
+
+static int fuzzyScore(const char* pattern, const char* name) {
+	FuzzyMatcher matcher;
+	matcher.setPattern(pattern);
+	return matcher.score(name);
+}
+
+// the pattern matches as a subsequence, matches at word boundaries and in one piece rank higher
+static void testFuzzyRanking() {
+	CHECK(fuzzyScore("fdint", "ImGuiFD_internal.h") != FuzzyMatcher::NoMatch);
+	CHECK(fuzzyScore("fdint", "ImGuiFD.h") == FuzzyMatcher::NoMatch);
+	CHECK(fuzzyScore("tni", "internal") == FuzzyMatcher::NoMatch); // order matters
+	CHECK(fuzzyScore("", "anything") == 0);
+
+	CHECK(fuzzyScore("fb", "foo_bar.txt") > fuzzyScore("fb", "xfxxxbx.txt"));
+	CHECK(fuzzyScore("fb", "FooBar.txt") > fuzzyScore("fb", "foobar.txt"));
+	CHECK(fuzzyScore("main", "main.cpp") > fuzzyScore("main", "my_animation.cpp"));
+	CHECK(fuzzyScore("main", "main.cpp") > fuzzyScore("main", "domain.cpp"));
+
+	// smart case: only patterns with upper case chars are case sensitive
+	CHECK(fuzzyScore("readme", "README.md") != FuzzyMatcher::NoMatch);
+	CHECK(fuzzyScore("README", "readme.md") == FuzzyMatcher::NoMatch);
+	CHECK(fuzzyScore("Readme", "Readme.md") > fuzzyScore("readme", "Readme.md"));
+
+	FuzzyMatcher matcher;
+	matcher.setPattern("fdint");
+	CHECK(matcher.mayMatch(FuzzyMatcher::charMask("ImGuiFD_internal.h")));
+	CHECK(!matcher.mayMatch(FuzzyMatcher::charMask("ImGuiFD.h")));
+
+	// the listing is ordered by score instead of the table sort
+	const char* names[] = { "my_animation.cpp", "domain.cpp", "main.cpp", "notes.txt", "m_a_i_n.cpp" };
+	ds::vector<DirEntry> entries;
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+		entries.push_back(makeEntry((ImGuiID)i, names[i], i));
+	const bool fuzzySearch = settings.fuzzySearch;
+	settings.fuzzySearch = true;
+	FileDialog::EntryManager entrys(NULL);
+	entrys.filter.searchText = "main";
+	entrys.setEntrysTo(entries);
+	drainWork(&entrys);
+	CHECK(entrys.size() == 4);
+	CHECK(entrys.size() > 0 && strcmp(entrys.get(0).name, "main.cpp") == 0);
+	for (size_t i = 0; i < entrys.size(); i++)
+		CHECK(strcmp(entrys.get(i).name, "notes.txt") != 0);
+	settings.fuzzySearch = fuzzySearch;
+}
+
+static void sortEntries(FileDialog::EntryManager* entrys, ImGuiID column, ImGuiSortDirection direction, ImGuiID column2 = (ImGuiID)-1) {
+	ImGuiTableColumnSortSpecs spec[2];
+	spec[0].ColumnUserID = column;
+	spec[0].SortDirection = direction;
+	spec[1].ColumnUserID = column2;
+	spec[1].SortDirection = ImGuiSortDirection_Ascending;
+	ImGuiTableSortSpecs specs;
+	specs.Specs = spec;
+	specs.SpecsCount = column2 != (ImGuiID)-1 ? 2 : 1;
+	entrys->sort(&specs);
+	drainWork(entrys);
+}
+
+// numbers in names compare by their value, leading zeros don't matter
+static void testNaturalSort() {
+	const char* names[] = { "file10.txt", "file2.txt", "File1.txt", "file1b.txt", "file02.txt", "a", "file100.txt", "file9.txt" };
+	const char* expected[] = { "a", "File1.txt", "file1b.txt", "file2.txt", "file02.txt", "file9.txt", "file10.txt", "file100.txt" };
+	ds::vector<DirEntry> entries;
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+		entries.push_back(makeEntry((ImGuiID)i, names[i], i));
+
+	const bool naturalSort = settings.naturalSort;
+	settings.naturalSort = true;
+	FileDialog::EntryManager entrys(NULL);
+	entrys.setEntrysTo(entries);
+	drainWork(&entrys);
+	sortEntries(&entrys, DEIG_NAME, ImGuiSortDirection_Ascending);
+	CHECK(entrys.size() == 8);
+	for (size_t i = 0; i < entrys.size(); i++) {
+		const bool same = strcmp(entrys.get(i).name, expected[i]) == 0
+			|| (i == 3 && strcmp(entrys.get(i).name, "file02.txt") == 0) || (i == 4 && strcmp(entrys.get(i).name, "file2.txt") == 0);
+		if (!same)
+			printf("natural sort %d: %s, expected %s\n", (int)i, entrys.get(i).name, expected[i]);
+		CHECK(same);
+	}
+
+	// switching it off sorts by the folded names again
+	settings.naturalSort = false;
+	sortEntries(&entrys, DEIG_NAME, ImGuiSortDirection_Ascending);
+	CHECK(strcmp(entrys.get(1).name, "file02.txt") == 0);
+	CHECK(strcmp(entrys.get(2).name, "File1.txt") == 0);
+	settings.naturalSort = naturalSort;
+}
+
+// sorts by size and dates go through the radix sort, which has to give the same order as comparing the keys
+static void testRadixSort() {
+	ds::vector<DirEntry> entries;
+	uint32_t rnd = 42;
+	for (size_t i = 0; i < 20000; i++) {
+		rnd = rnd * 1664525u + 1013904223u;
+		char name[32];
+		snprintf(name, sizeof(name), "f%u", (unsigned)i);
+		// few distinct sizes, so the second key decides a lot, some unknown ones
+		DirEntry entry = makeEntry((ImGuiID)i, name, (rnd >> 8) % 50 == 0 ? (size_t)-1 : ((size_t)(rnd >> 16) % 100) << ((rnd >> 4) % 40));
+		entry.lastModified = (time_t)1700000000 + (time_t)((rnd >> 3) % 1000000);
+		entry.isFolder = (rnd >> 12) % 10 == 0;
+		entries.push_back(entry);
+	}
+
+	FileDialog::EntryManager entrys(NULL);
+	entrys.setEntrysTo(entries);
+	drainWork(&entrys);
+
+	sortEntries(&entrys, DEIG_SIZE, ImGuiSortDirection_Descending, DEIG_LASTMOD_DATE);
+	CHECK(entrys.size() == entries.size());
+	size_t numOutOfOrder = 0;
+	for (size_t i = 1; i < entrys.size(); i++) {
+		const DirEntry& a = entrys.get(i - 1);
+		const DirEntry& b = entrys.get(i);
+		if (settings.showDirFirst && a.isFolder != b.isFolder) {
+			if (!a.isFolder)
+				numOutOfOrder++;
+			continue;
+		}
+		const int64_t sizeA = a.size == (uint64_t)-1 ? -1 : (int64_t)a.size;
+		const int64_t sizeB = b.size == (uint64_t)-1 ? -1 : (int64_t)b.size;
+		if (sizeA < sizeB || (sizeA == sizeB && a.lastModified > b.lastModified))
+			numOutOfOrder++;
+	}
+	CHECK(numOutOfOrder == 0);
+
+	sortEntries(&entrys, DEIG_LASTMOD_DATE, ImGuiSortDirection_Ascending);
+	numOutOfOrder = 0;
+	for (size_t i = 1; i < entrys.size(); i++) {
+		const DirEntry& a = entrys.get(i - 1);
+		const DirEntry& b = entrys.get(i);
+		if (settings.showDirFirst && a.isFolder != b.isFolder)
+			numOutOfOrder += a.isFolder ? 0 : 1;
+		else if (a.lastModified > b.lastModified)
+			numOutOfOrder++;
+	}
+	CHECK(numOutOfOrder == 0);
+}
+
+static ds::string foldKey(const char* str, bool keepAscii = false) {
+	ds::vector<char> key;
+	unicode::appendKey(str, str + strlen(str), &key, keepAscii);
+	return ds::string(key.data(), key.data() + key.size());
+}
+
+// names are compared by their case folded, composed keys
+static void testUnicodeFold() {
+	CHECK(foldKey("Stra\xC3\x9F" "e") == "strasse"); // full folding: "ß" is "ss"
+	CHECK(foldKey("STRASSE") == "strasse");
+	CHECK(foldKey("\xC3\x84pfel") == "\xC3\xA4pfel");            // "Ä" => "ä"
+	CHECK(foldKey("A\xCC\x88pfel") == "\xC3\xA4pfel");           // "A" + combining diaeresis (NFD, like on macOS) => "ä"
+	CHECK(foldKey("\xCE\xA3\xCE\xBF\xCF\x82") == "\xCF\x83\xCE\xBF\xCF\x83"); // "Σος" => "σοσ"
+	CHECK(foldKey("\xD0\x9F\xD1\x80\xD0\xB8") == "\xD0\xBF\xD1\x80\xD0\xB8"); // "При" => "при"
+	CHECK(foldKey("Readme", true) == "Readme"); // keepAscii
+	CHECK(foldKey("\xC3\x84", true) == "\xC3\xA4");
+	CHECK(foldKey("a\xFF\xC3") == "a\xFF\xC3"); // invalid UTF-8 is kept as it is
+
+	CHECK(searchPasses("strasse", "Stra\xC3\x9F" "e.txt"));
+	CHECK(searchPasses("\xC3\x84PFEL", "a\xCC\x88pfel.png"));
+	CHECK(searchPasses("re:^\xC3\xA4", "\xC3\x84pfel"));
+	CHECK(!searchPasses("apfel", "\xC3\x84pfel"));
+
+	// sorted by the bytes of the keys, so the decomposed "ärger" ends up next to "Äpfel"
+	ds::vector<DirEntry> entries;
+	entries.push_back(makeEntry(0, "b", 0));
+	entries.push_back(makeEntry(1, "\xC3\x84pfel", 0));
+	entries.push_back(makeEntry(2, "Apfel", 0));
+	entries.push_back(makeEntry(3, "a\xCC\x88rger", 0));
+	FileDialog::EntryManager entrys(NULL);
+	entrys.setEntrysTo(entries);
+	drainWork(&entrys);
+	sortEntries(&entrys, DEIG_NAME, ImGuiSortDirection_Ascending);
+	CHECK(entrys.size() == 4 && entrys.get(0).id == 2 && entrys.get(1).id == 0 && entrys.get(2).id == 1 && entrys.get(3).id == 3);
+}
+
+// results streamed in with appendEntrys() are listed in the same order as if they were set all at once
+static void testAppendEntrys() {
+	ds::vector<DirEntry> results;
+	for (size_t i = 0; i < 300; i++) {
+		char name[32];
+		snprintf(name, sizeof(name), "%s_%u.txt", i % 3 == 0 ? "b" : "a", (unsigned)((i * 7919) % 1000));
+		results.push_back(makeEntry((ImGuiID)i, name, (i * 31) % 97));
+	}
+
+	ImGuiTableColumnSortSpecs spec;
+	spec.ColumnUserID = DEIG_SIZE;
+	spec.SortDirection = ImGuiSortDirection_Descending;
+	ImGuiTableSortSpecs specs;
+	specs.Specs = &spec;
+	specs.SpecsCount = 1;
+
+	FileDialog::EntryManager all(NULL);
+	all.filter.searchText = "a_";
+	all.setEntrysTo(results);
+	drainWork(&all);
+	all.sort(&specs);
+	drainWork(&all);
+
+	FileDialog::EntryManager streamed(NULL);
+	streamed.filter.searchText = "a_";
+	streamed.setEntrysTo(ds::vector<DirEntry>()); // like a search that just started
+	drainWork(&streamed);
+	ds::vector<DirEntry> partial;
+	for (size_t i = 0; i < results.size(); i++) {
+		partial.push_back(results[i]);
+		if (i == 99 || i == 100 || i == 250 || i + 1 == results.size()) {
+			streamed.appendEntrys(partial, streamed.rawSize());
+			drainWork(&streamed);
+			if (!streamed.sorted) {
+				streamed.sort(&specs);
+				drainWork(&streamed);
+			}
+			CHECK(streamed.rawSize() == i + 1);
+		}
+	}
+
+	CHECK(streamed.size() == all.size());
+	for (size_t i = 0; i < all.size() && i < streamed.size(); i++)
+		CHECK(streamed.getInd(i) == all.getInd(i));
+}
+
+static void writeFile(const ds::string& path, size_t size) {
+	FILE* f = fopen(path.c_str(), "wb");
+	for (size_t i = 0; i < size; i++)
+		fputc('x', f);
+	fclose(f);
+}
+
+// a modified file stays the same entry: same index, id and selection, it just moves to its new place in the listing
+static void testEntryChanged() {
+	Native::makeFolder("ImGuiFDTests_tmp");
+	const ds::string dir = Native::getAbsolutePath("ImGuiFDTests_tmp") + "/";
+	writeFile(dir + "a", 1);
+	writeFile(dir + "b", 5);
+	writeFile(dir + "c", 10);
+
+	FileDialog dialog(0, "test", NULL, NULL, dir.c_str(), ImGuiFDMode_LoadFile);
+	FileDialog::EntryManager& entrys = dialog.entrys;
+	drainWork(&entrys);
+	ImGuiTableColumnSortSpecs spec;
+	spec.ColumnUserID = DEIG_SIZE;
+	spec.SortDirection = ImGuiSortDirection_Descending;
+	ImGuiTableSortSpecs specs;
+	specs.Specs = &spec;
+	specs.SpecsCount = 1;
+	entrys.sort(&specs);
+	drainWork(&entrys);
+	CHECK(entrys.size() == 3 && strcmp(entrys.get(0).name, "c") == 0);
+
+	const size_t a = entrys.findEntry("a");
+	const ImGuiID aId = entrys.getRaw(a).id;
+	dialog.selected.add(a);
+	dialog.lastSelected = a;
+
+	writeFile(dir + "a", 20);
+	dialog.entryChanged("a");
+	CHECK(entrys.findEntry("a") == a);
+	CHECK(entrys.getRaw(a).id == aId);
+	CHECK(entrys.getRaw(a).size == 20);
+	CHECK(entrys.getInd(0) == a);
+	CHECK(entrys.size() == 3);
+	CHECK(dialog.selected.size() == 1 && dialog.selected.contains(a));
+	CHECK(dialog.lastSelected == a);
+
+	// a new file gets an id none of the others has
+	writeFile(dir + "d", 2);
+	dialog.entryChanged("d");
+	const size_t d = entrys.findEntry("d");
+	CHECK(d != FileDialog::EntryManager::NotFound);
+	CHECK(entrys.size() == 4);
+	for (size_t i = 0; i < entrys.rawSize() && d != FileDialog::EntryManager::NotFound; i++)
+		CHECK(i == d || entrys.getRaw(i).id != entrys.getRaw(d).id);
+
+	remove((dir + "b").c_str());
+	dialog.entryChanged("b");
+	CHECK(entrys.findEntry("b") == FileDialog::EntryManager::NotFound);
+	CHECK(entrys.size() == 3);
+
+	remove((dir + "a").c_str());
+	remove((dir + "c").c_str());
+	remove((dir + "d").c_str());
+	remove(dir.c_str());
+}
+
+// a tree of 10 * 5 folders with 10 "f_*.txt" files and one "g.log" each, returns the root
+static ds::string makeTree(const char* name) {
+	Native::makeFolder(name);
+	const ds::string root = Native::getAbsolutePath(name) + "/";
+	for (int a = 0; a < 10; a++) {
+		char sub[64];
+		snprintf(sub, sizeof(sub), "d%d/", a);
+		Native::makeFolder((root + sub).c_str());
+		for (int b = 0; b < 5; b++) {
+			char subsub[64];
+			snprintf(subsub, sizeof(subsub), "d%d/e%d/", a, b);
+			const ds::string dir = root + subsub;
+			Native::makeFolder(dir.c_str());
+			for (int f = 0; f < 10; f++) {
+				char file[64];
+				snprintf(file, sizeof(file), "f_%d.txt", f);
+				writeFile(dir + file, (size_t)f);
+			}
+			writeFile(dir + "g.log", 1);
+		}
+	}
+	return root;
+}
+static void removeTree(const ds::string& root) {
+	for (int a = 0; a < 10; a++) {
+		for (int b = 0; b < 5; b++) {
+			char subsub[64];
+			snprintf(subsub, sizeof(subsub), "d%d/e%d/", a, b);
+			const ds::string dir = root + subsub;
+			for (int f = 0; f < 10; f++) {
+				char file[64];
+				snprintf(file, sizeof(file), "f_%d.txt", f);
+				remove((dir + file).c_str());
+			}
+			remove((dir + "g.log").c_str());
+			remove(dir.c_str());
+		}
+		char sub[64];
+		snprintf(sub, sizeof(sub), "d%d/", a);
+		remove((root + sub).c_str());
+	}
+	remove(root.c_str());
+}
+
+static void finishSubtreeSearch(SubtreeSearch* search) {
+	while (search->isActive())
+		search->continueWork(Native::getTime() + 0.001);
+}
+
+// the subtree search finds the same entries no matter how it is spread over frames and threads, and survives copies and cancels
+static void testSubtreeSearch() {
+	const ds::string root = makeTree("ImGuiFDTests_tree");
+	FileNameFilter filter;
+	filter.searchText = "f_";
+	filter.updateSearch();
+
+	SubtreeSearch search;
+	search.begin(root.c_str(), filter);
+	finishSubtreeSearch(&search);
+	CHECK(search.getResults().size() == 500);
+	CHECK(search.getNumDirsDone() == 1 + 10 + 50);
+	for (size_t i = 0; i < search.getResults().size(); i++)
+		CHECK(search.getResults()[i].id == (ImGuiID)i);
+
+	// copies share the walk (dialogs get copied), the original can go away while it runs
+	SubtreeSearch* original = new SubtreeSearch();
+	original->begin(root.c_str(), filter);
+	original->continueWork(0);
+	SubtreeSearch copy = *original;
+	delete original;
+	finishSubtreeSearch(&copy);
+	CHECK(copy.getResults().size() == 500);
+
+	search.begin(root.c_str(), filter);
+	search.continueWork(0);
+	search.cancel();
+	CHECK(!search.isActive());
+	CHECK(search.getResults().size() == 0);
+
+	removeTree(root);
+}
+
+// size bytes of 'x' with text at offset at
+static void writeText(const ds::string& path, size_t size, size_t at, const char* text) {
+	FILE* f = fopen(path.c_str(), "wb");
+	for (size_t i = 0; i < size; i++)
+		fputc(i >= at && i - at < strlen(text) ? text[i - at] : 'x', f);
+	fclose(f);
+}
+
+static void finishContentSearch(ContentSearch* search) {
+	while (search->isActive())
+		search->continueWork(Native::getTime() + 0.001);
+}
+
+// matches across the ranges files are scanned in are found, binary files are skipped
+static void testContentSearch() {
+	Native::makeFolder("ImGuiFDTests_content");
+	const ds::string dir = Native::getAbsolutePath("ImGuiFDTests_content") + "/";
+	writeText(dir + "border.txt", (3 << 20) + 5, (1 << 20) - 3, "NeedLe");
+	writeText(dir + "end.txt", 100, 94, "needle");
+	writeText(dir + "none.txt", (2 << 20) + 1, 0, "needl");
+	writeFile(dir + "empty.txt", 0);
+
+	FILE* f = fopen((dir + "binary.bin").c_str(), "wb");
+	fputs("needle", f);
+	fputc(0, f);
+	fclose(f);
+
+	bool success = false;
+	const ds::vector<DirEntry> files = Native::loadDirEnts(dir.c_str(), &success);
+	CHECK(success && files.size() == 5);
+
+	ContentSearch search;
+	search.begin(files, "needle");
+	finishContentSearch(&search);
+	CHECK(search.getResults().size() == 2);
+	for (size_t i = 0; i < search.getResults().size(); i++) {
+		const char* name = search.getResults()[i].name;
+		CHECK(strcmp(name, "border.txt") == 0 || strcmp(name, "end.txt") == 0);
+		CHECK(search.getResults()[i].id == (ImGuiID)i);
+	}
+	CHECK(search.getNumFilesDone() == 5);
+	CHECK(search.getNumSkipped() == 1);
+	CHECK(!search.reachedLimit());
+
+	// copies share the scan (dialogs get copied), the original can go away while it runs
+	ContentSearch* original = new ContentSearch();
+	original->begin(files, "needle");
+	original->continueWork(0);
+	ContentSearch copy = *original;
+	delete original;
+	finishContentSearch(&copy);
+	CHECK(copy.getResults().size() == 2);
+
+	search.begin(files, "needle");
+	search.cancel();
+	CHECK(!search.isActive());
+	CHECK(search.getResults().size() == 0);
+
+	for (size_t i = 0; i < files.size(); i++)
+		remove(files[i].path);
+	remove(dir.c_str());
+}
+
+static void finishIndexing(NameIndex* index) {
+	while (index->isBusy())
+		index->continueWork(Native::getTime() + 0.001);
+}
+
+// what NameIndex::find() should return, by checking every live entry
+static size_t countContaining(const NameIndex& index, const char* text) {
+	const ds::string key = foldKey(text);
+	size_t count = 0;
+	for (size_t i = 0; i < index.numEntries(); i++) {
+		size_t len;
+		const char* name = index.getName(i, &len);
+		const ds::string nameKey = foldKey(ds::string(name, name + len).c_str());
+		if (!index.isRemoved(i) && utils::findSubstring(nameKey.c_str(), nameKey.size(), key.c_str(), key.size()) != NULL)
+			count++;
+	}
+	return count;
+}
+static void addIndexDir(NameIndex* index, const char* dir, size_t numNames, uint32_t seed) {
+	static const char* const words[] = { "report", "frame", "Stra\xC3\x9F" "e", "backup", "notes", "final", "draft", "scan" };
+	index->beginDir(dir);
+	for (size_t i = 0; i < numNames; i++) {
+		seed = seed * 1664525u + 1013904223u;
+		char name[64];
+		const int len = snprintf(name, sizeof(name), "%s_%s_%u.txt", words[(seed >> 8) % 8], words[(seed >> 12) % 8], (unsigned)((seed >> 16) % 1000));
+		index->addEntry(name, (size_t)len, (seed >> 4) % 10 == 0);
+	}
+	index->endDir();
+}
+static void checkIndexFinds(const NameIndex& index) {
+	const char* const texts[] = { "report_final", "STRASSE_", "_99", "e_s", "xyz", "ft_b", "t_" };
+	for (size_t t = 0; t < sizeof(texts) / sizeof(texts[0]); t++) {
+		ds::vector<size_t> found;
+		index.find(texts[t], (size_t)-1, &found);
+		const size_t expected = countContaining(index, texts[t]);
+		if (found.size() != expected)
+			printf("index find '%s': %d, expected %d\n", texts[t], (int)found.size(), (int)expected);
+		CHECK(found.size() == expected);
+		for (size_t i = 1; i < found.size(); i++)
+			CHECK(found[i - 1] < found[i]);
+	}
+}
+
+// the trigram postings find the same entries as checking all of them, also after saving, loading and compacting
+static void testNameIndexPostings() {
+	NameIndex index;
+	addIndexDir(&index, "/a/", 5000, 1);
+	addIndexDir(&index, "/a/b/", 3000, 2);
+	addIndexDir(&index, "/c/", 2000, 3);
+	CHECK(index.numLiveEntries() == 10000);
+	checkIndexFinds(index);
+
+	// listing a dir again replaces its entries
+	addIndexDir(&index, "/a/b/", 100, 4);
+	CHECK(index.numLiveEntries() == 7100);
+	checkIndexFinds(index);
+
+	Native::makeFolder("ImGuiFDTests_idx");
+	const ds::string file = Native::getAbsolutePath("ImGuiFDTests_idx") + "/index.bin";
+	CHECK(index.save(file.c_str()));
+	CHECK(index.numLiveEntries() == 7100);
+	checkIndexFinds(index);
+
+	NameIndex loaded;
+	CHECK(loaded.load(file.c_str()));
+	CHECK(loaded.numLiveEntries() == 7100);
+	checkIndexFinds(loaded);
+	size_t first = 0;
+	CHECK(loaded.getDirEntries("/a/b/", &first) == 100);
+
+	// entries appended to the loaded base
+	addIndexDir(&loaded, "/d/", 1000, 5);
+	addIndexDir(&loaded, "/a/", 10, 6);
+	CHECK(loaded.numLiveEntries() == 7100 - 5000 + 10 + 1000);
+	checkIndexFinds(loaded);
+
+	// the removed entries get dropped once they are half of the index
+	NameIndex compacted;
+	for (uint32_t i = 0; i < 4; i++)
+		addIndexDir(&compacted, "/big/", 40000, 10 + i);
+	CHECK(compacted.numLiveEntries() == 40000);
+	CHECK(compacted.numEntries() < 4 * 40000);
+	checkIndexFinds(compacted);
+
+	loaded.clear();
+	remove(file.c_str());
+	remove((Native::getAbsolutePath("ImGuiFDTests_idx") + "/").c_str());
+}
+
+// the roots get listed in the background and merged in by continueWork()
+static void testNameIndexRoots() {
+	const ds::string root = makeTree("ImGuiFDTests_index");
+	NameIndex index;
+	index.addRoot(root.c_str());
+	CHECK(index.isBusy());
+	finishIndexing(&index);
+	CHECK(index.numLiveEntries() == 10 + 50 + 50 * 11);
+
+	ds::vector<size_t> found;
+	index.find("g.log", 1000, &found);
+	CHECK(found.size() == 50);
+	index.find("F_3.TXT", 1000, &found);
+	CHECK(found.size() == 50);
+	for (size_t i = 0; i < found.size(); i++)
+		CHECK(!index.isFolder(found[i]) && strncmp(index.getDir(found[i]).c_str(), root.c_str(), root.size()) == 0);
+
+	const ds::string dir = root + "d0/e0/";
+	remove((dir + "g.log").c_str());
+	index.dirChanged(dir.c_str());
+	finishIndexing(&index);
+	index.find("g.log", 1000, &found);
+	CHECK(found.size() == 49);
+
+	// stops the thread in the middle of it
+	index.addRoot(root.c_str());
+	index.clear();
+	CHECK(!index.isBusy());
+	CHECK(index.numLiveEntries() == 0);
+
+	writeFile(dir + "g.log", 1);
+	removeTree(root);
+}
+
+static bool groupPasses(FileNameFilter* filter, size_t group, const char* name) {
+	return filter->passesGroup(name, false, utils::getExtension(name), group);
+}
+
+// globs of filter groups, compiled into the DFA
+static void testGlobPatterns() {
+	FileNameFilter filter("{Sources:*.[ch],*.[ch]pp},{Frames:frame_??.png,shot_*_final.jpg},{Not:!*.bak},{Esc:a\\*b,[!x-z]1},{Ext:*.tar.gz,*.TXT}");
+	CHECK(groupPasses(&filter, 0, "main.c"));
+	CHECK(groupPasses(&filter, 0, "main.hpp"));
+	CHECK(!groupPasses(&filter, 0, "main.cc"));
+	CHECK(!groupPasses(&filter, 0, "main.cpp.bak"));
+
+	CHECK(groupPasses(&filter, 1, "frame_01.png"));
+	CHECK(!groupPasses(&filter, 1, "frame_1.png"));
+	CHECK(!groupPasses(&filter, 1, "frame_001.png"));
+	CHECK(groupPasses(&filter, 1, "shot_a_b_final.jpg"));
+	CHECK(groupPasses(&filter, 1, "shot__final.jpg"));
+	CHECK(!groupPasses(&filter, 1, "shot_final.jpg"));
+
+	CHECK(groupPasses(&filter, 2, "a.txt"));
+	CHECK(!groupPasses(&filter, 2, "a.bak"));
+
+	CHECK(groupPasses(&filter, 3, "a*b"));
+	CHECK(!groupPasses(&filter, 3, "axb"));
+	CHECK(groupPasses(&filter, 3, "a1"));
+	CHECK(!groupPasses(&filter, 3, "y1"));
+
+	CHECK(groupPasses(&filter, 4, "backup.tar.gz"));
+	CHECK(!groupPasses(&filter, 4, "backup.gz"));
+	CHECK(groupPasses(&filter, 4, "notes.TXT"));
+	CHECK(!groupPasses(&filter, 4, "notes.txt")); // filters are case sensitive
+
+	// more patterns than one automaton holds
+	ds::string many = "{Many:";
+	for (int i = 0; i < 150; i++) {
+		char pat[32];
+		snprintf(pat, sizeof(pat), "%sp%d_*", i > 0 ? "," : "", i);
+		many += pat;
+	}
+	many += "}";
+	FileNameFilter manyFilter(many.c_str());
+	CHECK(groupPasses(&manyFilter, 0, "p0_x"));
+	CHECK(groupPasses(&manyFilter, 0, "p63_x"));
+	CHECK(groupPasses(&manyFilter, 0, "p64_x"));
+	CHECK(groupPasses(&manyFilter, 0, "p149_x"));
+	CHECK(!groupPasses(&manyFilter, 0, "p150_x"));
+}
+
+// plain patterns of a filter group match the whole name, in the search bar they match anywhere in it
+static void testPlainPatterns() {
+	FileNameFilter filter("{Readme:README,notes.txt},{Not:!README},{Contains:*READ*}");
+	CHECK(groupPasses(&filter, 0, "README"));
+	CHECK(groupPasses(&filter, 0, "notes.txt"));
+	CHECK(!groupPasses(&filter, 0, "README.old.bak"));
+	CHECK(!groupPasses(&filter, 0, "my_notes.txt"));
+	CHECK(!groupPasses(&filter, 1, "README"));
+	CHECK(groupPasses(&filter, 1, "README.md"));
+	CHECK(groupPasses(&filter, 2, "README.old.bak"));
+
+	CHECK(searchPasses("readme", "README.old.bak"));
+	CHECK(searchPasses("notes.txt", "my_notes.txt"));
+}
+
+#ifdef IMGUIFD_HAS_STATIC_FILTER
+// '?' and "[!...]" match one whole UTF-8 char in both the static and the runtime filter
+static void testStaticFilterUtf8() {
+	typedef StaticFilter<"{Frames:frame_?.png},{Inv:[!a]x}"> Static;
+	FileNameFilter runtime("{Frames:frame_?.png},{Inv:[!a]x}");
+	const char* names[] = { "frame_a.png", "frame_\xC3\xA4.png", "frame_\xE2\x82\xAC.png", "frame_ab.png", "frame_.png",
+		"bx", "ax", "\xC3\xA4x", "\xF0\x9F\x98\x80x", "\xC3\xA4\xC3\xA4x", "x" };
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		const char* name = names[i];
+		for (size_t group = 0; group < 2; group++) {
+			const bool s = Static::passes(name, name + strlen(name), group);
+			const bool r = runtime.passesGroup(name, false, utils::getExtension(name), group);
+			if (s != r)
+				printf("'%s' in group %d: static %d, runtime %d\n", name, (int)group, (int)s, (int)r);
+			CHECK(s == r);
+		}
+	}
+	const char frameUmlaut[] = "frame_\xC3\xA4.png";
+	const char umlautX[] = "\xC3\xA4x";
+	CHECK(Static::passes(frameUmlaut, frameUmlaut + strlen(frameUmlaut), 0));
+	CHECK(Static::passes(umlautX, umlautX + strlen(umlautX), 1));
+	CHECK(!Static::passes("ax", "ax" + 2, 1));
+
+	typedef StaticFilter<"{Readme:README,notes.txt}"> Plain;
+	CHECK(Plain::passes("README", "README" + 6, 0));
+	CHECK(!Plain::passes("README.old.bak", "README.old.bak" + 14, 0));
+	CHECK(!Plain::passes("my_notes.txt", "my_notes.txt" + 12, 0));
+}
+#endif
+
+int main() {
+	ImGui::CreateContext();
+	testRegexRequiredText();
+	testRegexSyntax();
+	testFuzzyRanking();
+	testPredicates();
+	testAppendEntrys();
+	testNaturalSort();
+	testRadixSort();
+	testUnicodeFold();
+	testEntryChanged();
+	testSubtreeSearch();
+	testContentSearch();
+	testNameIndexRoots();
+	testNameIndexPostings();
+	testPlainPatterns();
+	testGlobPatterns();
+#ifdef IMGUIFD_HAS_STATIC_FILTER
+	testStaticFilterUtf8();
+#endif
+
+	ImGui::DestroyContext();
+	if (numFailed == 0)
+		printf("all passed\n");
+	return numFailed;
+}